@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include <cstdint>
+
+// Deterministic inputs shared by the benchmarks, so runs on different
+// commits measure the same bytes.
+namespace BenchUtils {
+
+// First argument that turns the benchmark binary into the echo child
+constexpr const char *kEchoChildFlag = "--bench-echo-child";
+
+// `size` bytes of printable, newline-separated pseudo-random text
+inline QByteArray text(qint64 size, std::uint32_t seed = 1) {
+    QByteArray data(static_cast<qsizetype>(size), Qt::Uninitialized);
+    std::uint32_t state = seed;
+    for (qsizetype i = 0; i < data.size(); ++i) {
+        state = state * 1664525u + 1013904223u;
+        const std::uint32_t value = state >> 24;
+        data[i] = value < 24 ? '\n' : value < 64 ? ' ' : static_cast<char>('0' + value % 10);
+    }
+    return data;
+}
+
+// Judge-style output: `lines` lines of numbers with trailing blanks and
+// optional CRLF line endings, the shapes normalizeText has to undo
+inline QString output(int lines, bool crlf) {
+    QString result;
+    result.reserve(lines * 16);
+    for (int i = 0; i < lines; ++i) {
+        result += QString::number(qint64(i) * 7919 % 1000003);
+        result += ' ';
+        result += QString::number(i);
+        result += i % 3 == 0 ? QStringLiteral("  \t") : QString();
+        result += crlf ? QStringLiteral("\r\n") : QStringLiteral("\n");
+    }
+    result += QStringLiteral("\n\n");
+    return result;
+}
+
+} // namespace BenchUtils
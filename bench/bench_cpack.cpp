@@ -0,0 +1,142 @@
+#include "bench/BenchUtils.h"
+#include "file/CpackFileHandler.h"
+#include "file/ProjectSnapshot.h"
+#include "file/TestStore.h"
+
+#include <QDir>
+#include <QTemporaryDir>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace {
+
+// Archive with the usual sources plus one payload entry of `size` bytes
+CpackFileHandler makeArchive(qint64 size) {
+    CpackFileHandler handler;
+    handler.addFile("solution.cpp", "int main() { return 0; }\n");
+    handler.addFile("template.cpp", "//#main\n");
+    handler.addFile("testcases.json", BenchUtils::text(size));
+    return handler;
+}
+
+std::vector<TestCase> makeTests(int count, qint64 bytesPerTest) {
+    std::vector<TestCase> tests;
+    tests.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        const QByteArray data = BenchUtils::text(bytesPerTest, static_cast<std::uint32_t>(i + 1));
+        tests.push_back({QString::fromLatin1(data), QString::fromLatin1(data.left(data.size() / 2))});
+    }
+    return tests;
+}
+
+void BM_Crc32(benchmark::State &state) {
+    const QByteArray data = BenchUtils::text(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CpackFileHandler::calculateCrc32(data));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Crc32)->RangeMultiplier(16)->Range(1 << 10, 1 << 26);
+
+void BM_CpackSave(benchmark::State &state) {
+    QTemporaryDir dir;
+    const QString path = QDir(dir.path()).filePath("bench.cpack");
+    const CpackFileHandler handler = makeArchive(state.range(0));
+    for (auto _ : state) {
+        if (!handler.save(path)) {
+            state.SkipWithError("Failed to save the archive");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CpackSave)->RangeMultiplier(16)->Range(1 << 10, 1 << 26)->Unit(benchmark::kMicrosecond);
+
+void BM_CpackLoad(benchmark::State &state) {
+    QTemporaryDir dir;
+    const QString path = QDir(dir.path()).filePath("bench.cpack");
+    if (!makeArchive(state.range(0)).save(path)) {
+        state.SkipWithError("Failed to write the archive");
+        return;
+    }
+    for (auto _ : state) {
+        CpackFileHandler handler;
+        if (!handler.load(path)) {
+            state.SkipWithError("Failed to load the archive");
+            break;
+        }
+        benchmark::DoNotOptimize(handler.fileNames());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CpackLoad)->RangeMultiplier(16)->Range(1 << 10, 1 << 26)->Unit(benchmark::kMicrosecond);
+
+// Indexing an archive whose tests live in the binary store and reading only
+// tests/index.bin; stays flat as the tests grow. Not what opening a file
+// costs, see BM_CpackOpenTests.
+void BM_CpackLoadIndex(benchmark::State &state) {
+    QTemporaryDir dir;
+    const QString path = QDir(dir.path()).filePath("bench.cpack");
+    CpackFileHandler writer;
+    TestStore::write(writer, makeTests(static_cast<int>(state.range(0)), 64 * 1024), 5);
+    if (!writer.save(path)) {
+        state.SkipWithError("Failed to write the archive");
+        return;
+    }
+    for (auto _ : state) {
+        CpackFileHandler handler;
+        TestStore::Index index;
+        if (!handler.load(path, TestStore::kPrefix) || !TestStore::readIndex(handler, index)) {
+            state.SkipWithError("Failed to load the archive");
+            break;
+        }
+        benchmark::DoNotOptimize(index.count());
+    }
+}
+BENCHMARK(BM_CpackLoadIndex)->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMicrosecond);
+
+// What the GUI and the CLI pay to open the same archive: every test is read,
+// CRC-checked and decoded by TestStore::readTests
+void BM_CpackOpenTests(benchmark::State &state) {
+    QTemporaryDir dir;
+    const QString path = QDir(dir.path()).filePath("bench.cpack");
+    CpackFileHandler writer;
+    TestStore::write(writer, makeTests(static_cast<int>(state.range(0)), 64 * 1024), 5);
+    if (!writer.save(path)) {
+        state.SkipWithError("Failed to write the archive");
+        return;
+    }
+    for (auto _ : state) {
+        CpackFileHandler handler;
+        std::vector<TestCase> tests;
+        int timeoutSec = 0;
+        if (!handler.load(path, TestStore::kPrefix) ||
+            !TestStore::readTests(handler, tests, timeoutSec)) {
+            state.SkipWithError("Failed to load the archive");
+            break;
+        }
+        benchmark::DoNotOptimize(tests.size());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 64 * 1024 * 3 / 2);
+}
+BENCHMARK(BM_CpackOpenTests)->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMicrosecond);
+
+// testcases.json as written on save; args: test count, bytes per test
+void BM_TestcasesJson(benchmark::State &state) {
+    ProjectSnapshot snapshot;
+    snapshot.tests = makeTests(static_cast<int>(state.range(0)), state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(snapshot.testcasesJson());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * state.range(1) * 3 / 2);
+}
+BENCHMARK(BM_TestcasesJson)
+    ->Args({10, 1 << 10})
+    ->Args({100, 1 << 10})
+    ->Args({10, 1 << 20})
+    ->Args({100, 1 << 16})
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
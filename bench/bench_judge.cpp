@@ -0,0 +1,92 @@
+#include "bench/BenchUtils.h"
+#include "execution/CompilationUtils.h"
+#include "execution/Complexity.h"
+
+#include <QCoreApplication>
+#include <QProcess>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// arg 0: output lines, arg 1: CRLF line endings
+void BM_NormalizeText(benchmark::State &state) {
+    const QString output = BenchUtils::output(static_cast<int>(state.range(0)), state.range(1) != 0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CompilationUtils::normalizeText(output));
+    }
+    state.SetBytesProcessed(state.iterations() * output.size() * qint64(sizeof(QChar)));
+}
+BENCHMARK(BM_NormalizeText)
+    ->ArgsProduct({{1 << 10, 1 << 14, 1 << 18, 1 << 20}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+// What the engines judge with: the same comparison on the child's UTF-8
+// bytes, against an expected output that differs only in line endings
+void BM_SameOutput(benchmark::State &state) {
+    const QByteArray output =
+        BenchUtils::output(static_cast<int>(state.range(0)), state.range(1) != 0).toUtf8();
+    const QByteArray expected = BenchUtils::output(static_cast<int>(state.range(0)), false).toUtf8();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CompilationUtils::sameOutput(output, expected));
+    }
+    state.SetBytesProcessed(state.iterations() * output.size());
+}
+BENCHMARK(BM_SameOutput)
+    ->ArgsProduct({{1 << 10, 1 << 14, 1 << 18, 1 << 20}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+// The Run All / stress complexity estimate over `range(0)` samples
+void BM_FitLogLog(benchmark::State &state) {
+    std::vector<double> sizes;
+    std::vector<double> times;
+    for (int i = 1; i <= state.range(0); ++i) {
+        sizes.push_back(i * 100.0);
+        times.push_back(0.001 * i * std::log2(i + 1.0));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Complexity::fitLogLog(sizes, times));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FitLogLog)->RangeMultiplier(10)->Range(10, 100000);
+
+// Spawn + stdin + wait + read, the fixed cost paid by every test run.
+// arg: bytes piped through the child and back
+void BM_ProcessRoundTrip(benchmark::State &state) {
+    const QString program = QCoreApplication::applicationFilePath();
+    const QStringList args{QString::fromLatin1(BenchUtils::kEchoChildFlag)};
+    const QByteArray input = BenchUtils::text(state.range(0));
+    for (auto _ : state) {
+        QProcess process;
+        process.start(program, args);
+        if (!process.waitForStarted(5000)) {
+            state.SkipWithError("Failed to start the echo child");
+            break;
+        }
+        process.write(input);
+        process.closeWriteChannel();
+        if (!process.waitForFinished(30000)) {
+            state.SkipWithError("Echo child did not finish");
+            break;
+        }
+        const QByteArray output = process.readAllStandardOutput();
+        if (output.size() != input.size()) {
+            state.SkipWithError("Echo child returned a different size");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ProcessRoundTrip)
+    ->Arg(0)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20)
+    ->Arg(1 << 24)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace
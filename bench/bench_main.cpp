@@ -0,0 +1,47 @@
+#include "bench/BenchUtils.h"
+
+#include <QCoreApplication>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstring>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace {
+
+// Child for the process benchmarks: copies stdin to stdout and exits.
+// Spawning this binary instead of a shell utility keeps the numbers
+// comparable across machines and platforms.
+int echoChild() {
+#ifdef _WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    static char buffer[64 * 1024];
+    size_t read = 0;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), stdin)) > 0) {
+        std::fwrite(buffer, 1, read, stdout);
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc > 1 && std::strcmp(argv[1], BenchUtils::kEchoChildFlag) == 0) {
+        return echoChild();
+    }
+
+    QCoreApplication app(argc, argv);
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
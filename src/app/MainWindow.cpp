@@ -3,12 +3,24 @@
 #include "app/CollapsibleSplitter.h"
 #include "app/SettingsDialog.h"
 #include "companion/CompanionListener.h"
+#include "execution/CompilationSettings.h"
 #include "execution/CompilationUtils.h"
+#include "execution/CompileCache.h"
+#include "execution/Complexity.h"
+#include "execution/DiffEngine.h"
+#include "execution/SpeculativeCompiler.h"
+#include "execution/Trace.h"
+#include "file/AutosaveJournal.h"
+#include "file/AutosaveWriter.h"
 #include "file/CpackFileHandler.h"
+#include "file/TestStore.h"
 #include "ui/AutoResizingTextEdit.h"
 #include "ui/FileExplorerBuilder.h"
 #include "ui/IconUtils.h"
+#include "ui/ResourceMonitorPanel.h"
 #include "ui/StressPanelBuilder.h"
+#include "ui/TestCaseDelegate.h"
+#include "ui/TestCaseModel.h"
 #include "Version.h"
 
 #include <Qsci/qsciscintilla.h>
@@ -26,17 +38,19 @@
 #include <QTreeView>
 #include <QFile>
 #include <QIcon>
-#include <QElapsedTimer>
+#include <QItemSelectionModel>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QKeySequence>
 #include <QLabel>
 #include <QLineEdit>
+#include <QListView>
 #include <QMenu>
 #include <QMenuBar>
 #include <QMessageBox>
 #include <QPlainTextEdit>
+#include <QProgressBar>
 #include <QPushButton>
 #include <QRegularExpression>
 #include <QSettings>
@@ -48,163 +62,25 @@
 #include <QDir>
 #include <QScreen>
 #include <QWindow>
-#include <QStringConverter>
 #include <QSizePolicy>
 #include <QStackedWidget>
 #include <QStyle>
 #include <QStyleOption>
+#include <QThread>
 #include <QTimer>
 #include <QVBoxLayout>
 #include <QStringList>
 #include <QFutureWatcher>
-#include <QVector>
-#include <QProcess>
-#include <QTemporaryDir>
-#include <QTextStream>
 #include <QtConcurrent>
 #include <algorithm>
 #include <cmath>
-#include <optional>
 
 namespace {
 constexpr int kActivityBarWidth = 50;
 constexpr int kSidePanelDefaultWidth = 240;
 constexpr int kSidePanelMinWidth = 175;
-
-QString loadDefaultTemplate(const QString &language) {
-    QSettings settings("CF Dojo", "CF Dojo");
-    const QString key = QStringLiteral("defaultTemplate/%1").arg(language);
-    const QString stored = settings.value(key).toString();
-    return stored.isEmpty() ? QString{CompilationUtils::kDefaultTemplateCode} : stored;
-}
-
-struct RegressionResult {
-    bool ok = false;
-    double slope = 0.0;
-    double r2 = 0.0;
-    double maxMs = 0.0;
-};
-
-RegressionResult computeLogLogRegression(const std::vector<double> &sizes,
-                                         const std::vector<double> &timesMs) {
-    RegressionResult result;
-    std::vector<double> xs;
-    std::vector<double> ys;
-    xs.reserve(sizes.size());
-    ys.reserve(timesMs.size());
-
-    for (size_t i = 0; i < sizes.size() && i < timesMs.size(); ++i) {
-        const double n = sizes[i];
-        const double t = timesMs[i];
-        if (n > 0.0) {
-            const double tForFit = t > 0.0 ? t : 1.0;
-            xs.push_back(std::log(n));
-            ys.push_back(std::log(tForFit));
-            if (t > 0.0) {
-                result.maxMs = std::max(result.maxMs, t);
-            }
-        }
-    }
-
-    if (xs.size() < 3) {
-        return result;
-    }
-
-    double sumX = 0.0;
-    double sumY = 0.0;
-    for (size_t i = 0; i < xs.size(); ++i) {
-        sumX += xs[i];
-        sumY += ys[i];
-    }
-    const double meanX = sumX / xs.size();
-    const double meanY = sumY / ys.size();
-
-    double num = 0.0;
-    double den = 0.0;
-    for (size_t i = 0; i < xs.size(); ++i) {
-        const double dx = xs[i] - meanX;
-        num += dx * (ys[i] - meanY);
-        den += dx * dx;
-    }
-
-    if (den <= 0.0) {
-        return result;
-    }
-
-    const double slope = num / den;
-    const double intercept = meanY - slope * meanX;
-
-    double ssTot = 0.0;
-    double ssRes = 0.0;
-    for (size_t i = 0; i < xs.size(); ++i) {
-        const double fit = intercept + slope * xs[i];
-        ssTot += (ys[i] - meanY) * (ys[i] - meanY);
-        ssRes += (ys[i] - fit) * (ys[i] - fit);
-    }
-    const double r2 = ssTot > 0.0 ? (1.0 - (ssRes / ssTot)) : 0.0;
-
-    result.ok = true;
-    result.slope = slope;
-    result.r2 = r2;
-    return result;
-}
-
-QString estimateComplexityLabel(const std::vector<double> &sizes,
-                                const std::vector<double> &timesMs) {
-    const RegressionResult reg = computeLogLogRegression(sizes, timesMs);
-    if (!reg.ok) {
-        return QString();
-    }
-    return QString("Estimated: T ≈ a·n^%1 (R²=%2)")
-        .arg(reg.slope, 0, 'f', 2)
-        .arg(reg.r2, 0, 'f', 2);
-}
-
-QString suspectedComplexityLabel(const std::vector<double> &sizes,
-                                 const std::vector<double> &timesMs) {
-    const RegressionResult reg = computeLogLogRegression(sizes, timesMs);
-    if (!reg.ok) {
-        return QString("Suspected: insufficient timing data");
-    }
-    struct Bucket {
-        const char *label;
-        const char *title;
-        const char *desc;
-    };
-
-    const double k = reg.slope;
-    Bucket bucket;
-    if (k < 0.15) {
-        bucket = {"O(1)", "constant", "Doesn’t scale with input."};
-    } else if (k < 0.5) {
-        bucket = {"O(log n)", "logarithmic", "Grows very slowly. Doubling n adds ~1 step."};
-    } else if (k < 1.15) {
-        bucket = {"O(n)", "linear", "Double input → double work."};
-    } else if (k < 1.6) {
-        bucket = {"O(n log n)", "near-linear", "Slightly worse than linear, still excellent."};
-    } else if (k < 2.4) {
-        bucket = {"O(n²)", "quadratic", "Works for small n, explodes fast."};
-    } else if (k < 3.2) {
-        bucket = {"O(n³)", "cubic", "Only acceptable for very small n."};
-    } else {
-        bucket = {"O(2ⁿ)/O(n!)", "exponential / factorial", "Impossible past tiny n."};
-    }
-
-    const QString maxTime =
-        reg.maxMs > 0.0 ? QString(" • max %1 ms").arg(reg.maxMs, 0, 'f', 0)
-                        : QString(" • max <1 ms");
-    const QString summary = QString("Suspected: %1 — %2")
-        .arg(bucket.label)
-        .arg(bucket.title);
-    const QString fit = QString("Fit: n^%1 (R²=%2)%3")
-        .arg(reg.slope, 0, 'f', 2)
-        .arg(reg.r2, 0, 'f', 2)
-        .arg(maxTime);
-    return QString("%1\n%2\n%3")
-        .arg(summary)
-        .arg(bucket.desc)
-        .arg(fit);
-}
+// Parallel results are applied to the test list at most this often (~60 fps)
+constexpr int kResultBatchIntervalMs = 16;
 } // namespace
 
 MainWindow::MainWindow(QWidget *parent)
@@ -212,11 +88,28 @@ MainWindow::MainWindow(QWidget *parent)
       editorConfigurator_(new EditorConfigurator(this)),
       executionController_(new ExecutionController(this)),
       parallelExecutor_(new ParallelExecutor(this)),
-      baseAppFont_(qApp->font()) {
+      baseAppFont_(qApp->font()),
+      compileCache_(std::make_shared<CompileCache>()),
+      outputCache_(std::make_shared<OutputCache>()) {
     loadRuntimeSettings();
     currentTemplate_ = defaultTemplates_.value(
         CompilationUtils::normalizeLanguage(defaultLanguage_),
         QString{CompilationUtils::kDefaultTemplateCode});
+    executionController_->setCompileCache(compileCache_);
+    parallelExecutor_->setCompileCache(compileCache_);
+    speculativeCompiler_ = new SpeculativeCompiler(
+        compileCache_,
+        [this](QString &source, CompilationConfig &config) {
+            // Only the solution is run from the editor
+            if (!codeEditor_ || editorMode_ != EditorMode::Solution) {
+                return false;
+            }
+            source = codeEditor_->text();
+            config = runtimeConfig();
+            return true;
+        },
+        this);
+    speculativeCompiler_->setEnabled(backgroundCompileEnabled_);
     applyRuntimeSettings();
     themeManager_.apply(qApp, uiScale_);
     executionController_->setIconTintColor(themeManager_.textColor());
@@ -236,30 +129,43 @@ MainWindow::MainWindow(QWidget *parent)
         if (!geo.isEmpty()) restoreGeometry(geo);
         if (!state.isEmpty()) restoreState(state);
     }
+
+    // Offer crash recovery once the window is up
+    QTimer::singleShot(0, this, &MainWindow::offerAutosaveRecovery);
     
-    // Connect parallel executor signals
+    // Connect parallel executor signals. Results arriving in a burst are
+    // queued and applied at most once per frame.
+    parallelResultTimer_ = new QTimer(this);
+    parallelResultTimer_->setSingleShot(true);
+    parallelResultTimer_->setInterval(kResultBatchIntervalMs);
+    connect(parallelResultTimer_, &QTimer::timeout,
+            this, &MainWindow::flushParallelResults);
+
     connect(parallelExecutor_, &ParallelExecutor::testFinished,
             this, [this](const TestResult &result) {
-        applyParallelResult(result);
+        pendingParallelResults_.push_back(result);
+        if (!parallelResultTimer_->isActive()) {
+            parallelResultTimer_->start();
+        }
     });
     
     connect(parallelExecutor_, &ParallelExecutor::allTestsFinished,
-            this, [this](const std::vector<TestResult> &results) {
-        for (const auto &result : results) {
-            applyParallelResult(result);
-        }
+            this, [this](const std::vector<TestResult> &) {
+        // Every result already came through testFinished
+        parallelResultTimer_->stop();
+        flushParallelResults();
+        updateRunAllProgress(0, 0);
         if (!runAllCollecting_) {
             return;
         }
-        const QString summary = estimateComplexityLabel(runAllInputSizes_, runAllTimesMs_);
-        updateTestSummary(summary);
-        runAllCollecting_ = false;
+        finishRunAllSummary();
     });
 
     connect(parallelExecutor_, &ParallelExecutor::compilationFinished,
             this, [this](bool success, const QString &error) {
         if (!success) {
             applyCompileErrorToAllCases(error);
+            updateRunAllProgress(0, 0);
             runAllCollecting_ = false;
             updateTestSummary(QString());
         }
@@ -274,16 +180,23 @@ MainWindow::MainWindow(QWidget *parent)
                 runAllTimesMs_[static_cast<size_t>(runAllCurrentIndex_)] =
                     static_cast<double>(executionController_->lastExecutionTimeMs());
             }
+            ++runAllCompleted_;
+            updateRunAllProgress(runAllCompleted_, static_cast<int>(runAllTimesMs_.size()));
             runNextSequentialTest();
             if (!runAllSequentialActive_ && runAllCollecting_) {
-                const QString summary =
-                    estimateComplexityLabel(runAllInputSizes_, runAllTimesMs_);
-                updateTestSummary(summary);
-                runAllCollecting_ = false;
+                finishRunAllSummary();
             }
         }
     });
 
+    connect(executionController_, &ExecutionController::stateChanged,
+            this, [this](ExecutionController::State state) {
+        // Keep the record in sync so results survive without widgets
+        if (state == ExecutionController::State::Idle) {
+            storeCaseOutcome(activeRunIndex_);
+        }
+    });
+
     connect(executionController_, &ExecutionController::compilationFailed,
             this, [this](const QString &error) {
         if (runAllSequentialActive_) {
@@ -306,10 +219,21 @@ MainWindow::~MainWindow() {
     // Ensure any in-flight stress test future finishes before members are
     // destroyed.  Without this, QtConcurrent may dereference a dangling
     // pointer to this MainWindow.
+    if (stressEngine_) {
+        stressEngine_->cancel();
+    }
     if (stressWatcher_) {
-        stressWatcher_->cancel();
         stressWatcher_->waitForFinished();
     }
+    if (fillEngine_) {
+        fillEngine_->cancel();
+    }
+    if (fillWatcher_) {
+        fillWatcher_->waitForFinished();
+    }
+    if (autosaveWriter_) {
+        autosaveWriter_->waitForIdle();
+    }
 }
 
 void MainWindow::loadRuntimeSettings() {
@@ -319,22 +243,18 @@ void MainWindow::loadRuntimeSettings() {
     transcludeTemplateEnabled_ = defaultTranscludeTemplateEnabled_;
 
     const int autosaveSec = std::clamp(
-        settings.value("autosaveIntervalSec", 15).toInt(), 5, 300);
+        settings.value("autosaveIntervalSec", 3).toInt(), 1, 300);
     autosaveIntervalMs_ = autosaveSec * 1000;
+    binaryTestStoreEnabled_ = settings.value("binaryTestStore", false).toBool();
+    backgroundCompileEnabled_ = settings.value("backgroundCompile", false).toBool();
 
     defaultLanguage_ = CompilationUtils::normalizeLanguage(
         settings.value("defaultLanguage", "C++").toString());
     currentLanguage_ = defaultLanguage_;
-    compilationConfig_.cppCompilerPath = settings.value("cppCompilerPath", "g++").toString();
-    compilationConfig_.cppCompilerFlags = settings.value("cppCompilerFlags", "-O2 -std=c++17").toString();
-    compilationConfig_.pythonPath = settings.value("pythonPath", "python3").toString();
-    compilationConfig_.pythonArgs = settings.value("pythonArgs", "").toString();
-    compilationConfig_.javaCompilerPath = settings.value("javaCompilerPath", "javac").toString();
-    compilationConfig_.javaRunPath = settings.value("javaRunPath", "java").toString();
-    compilationConfig_.javaArgs = settings.value("javaArgs", "").toString();
+    compilationConfig_ = CompilationSettings::load();
 
     for (const QString &lang : CompilationUtils::supportedLanguages()) {
-        defaultTemplates_[lang] = loadDefaultTemplate(lang);
+        defaultTemplates_[lang] = CompilationSettings::defaultTemplate(lang);
     }
 
     fileExplorerRootDir_ = settings.value("rootDir", QDir::currentPath()).toString();
@@ -348,10 +268,16 @@ void MainWindow::loadRuntimeSettings() {
     }
 }
 
+CompilationConfig MainWindow::runtimeConfig() const {
+    CompilationConfig config = compilationConfig_;
+    config.language = CompilationUtils::normalizeLanguage(currentLanguage_);
+    config.transcludeTemplate = transcludeTemplateEnabled_;
+    config.templateCode = currentTemplate_;
+    return config;
+}
+
 void MainWindow::applyRuntimeSettings() {
-    compilationConfig_.language = CompilationUtils::normalizeLanguage(currentLanguage_);
-    compilationConfig_.transcludeTemplate = transcludeTemplateEnabled_;
-    compilationConfig_.templateCode = currentTemplate_;
+    compilationConfig_ = runtimeConfig();
     if (executionController_) {
         executionController_->setConfig(compilationConfig_);
     }
@@ -410,6 +336,9 @@ void MainWindow::closeEvent(QCloseEvent *event) {
         autosaveTimer_->stop();
     }
     clearAutosaveFiles();
+    if (autosaveWriter_) {
+        autosaveWriter_->waitForIdle();
+    }
 
     // Persist window geometry so it reopens in the same place
     QSettings settings("CF Dojo", "CF Dojo");
@@ -499,7 +428,8 @@ void MainWindow::setupActivityBar() {
         if (!mainSplitter_ || !sideStack_ || !panel) return;
         sideStack_->setCurrentWidget(panel);
         if (mainSplitter_->isCollapsed()) mainSplitter_->expand();
-        for (auto *btn : {sidebarToggle_, stressTestButton_, templateButton_, newFileButton_}) {
+        for (auto *btn : {sidebarToggle_, stressTestButton_, monitorButton_, templateButton_,
+                          newFileButton_}) {
             if (btn) btn->setChecked(false);
         }
         // The caller's button gets re-checked via updateActivityBarActiveStates below
@@ -532,6 +462,20 @@ void MainWindow::setupActivityBar() {
         if (stressTestButton_) stressTestButton_->setChecked(true);
     });
 
+    // Resource monitor button
+    monitorButton_ = new ActivityBarButton(":/images/monitor.svg", activityBar_);
+    monitorButton_->setObjectName("ResourceMonitorButton");
+    monitorButton_->setFixedHeight(kActivityBarWidth);
+    monitorButton_->setToolTip("Resource Monitor");
+    monitorButton_->setCheckable(true);
+    monitorButton_->setChecked(false);
+    applyActivityTint(monitorButton_);
+
+    connect(monitorButton_, &QPushButton::clicked, this, [this, switchPanel]() {
+        switchPanel(resourceMonitorPanel_);
+        if (monitorButton_) monitorButton_->setChecked(true);
+    });
+
     // Template editor button
     templateButton_ = new ActivityBarButton(":/images/template.svg", activityBar_);
     templateButton_->setObjectName("TemplateButton");
@@ -548,6 +492,7 @@ void MainWindow::setupActivityBar() {
 
     layout->addWidget(sidebarToggle_, 0, Qt::AlignTop);
     layout->addWidget(stressTestButton_, 0, Qt::AlignTop);
+    layout->addWidget(monitorButton_, 0, Qt::AlignTop);
     layout->addWidget(templateButton_, 0, Qt::AlignTop);
     layout->addStretch();
 
@@ -606,16 +551,23 @@ void MainWindow::openSettingsDialog() {
                     lang, QString{CompilationUtils::kDefaultTemplateCode}));
         }
         settingsWindow_->setMultithreadingEnabled(multithreadingEnabled_);
+        settingsWindow_->setBinaryTestStoreEnabled(binaryTestStoreEnabled_);
+        settingsWindow_->setBackgroundCompileEnabled(backgroundCompileEnabled_);
         settingsWindow_->setTranscludeTemplateEnabled(defaultTranscludeTemplateEnabled_);
         settingsWindow_->setAutosaveIntervalSeconds(autosaveIntervalMs_ / 1000);
         settingsWindow_->setDefaultLanguage(defaultLanguage_);
         settingsWindow_->setCompilerPath(compilationConfig_.cppCompilerPath);
         settingsWindow_->setCompilerFlags(compilationConfig_.cppCompilerFlags);
+        settingsWindow_->setDiagnosticFlags(compilationConfig_.cppDiagnosticFlags);
+        settingsWindow_->setLinker(compilationConfig_.cppLinker);
+        settingsWindow_->setPrecompiledHeaderEnabled(compilationConfig_.cppPrecompiledHeader);
         settingsWindow_->setPythonPath(compilationConfig_.pythonPath);
         settingsWindow_->setPythonArgs(compilationConfig_.pythonArgs);
+        settingsWindow_->setPythonForkServerEnabled(compilationConfig_.pythonForkServer);
         settingsWindow_->setJavaCompilerPath(compilationConfig_.javaCompilerPath);
         settingsWindow_->setJavaRunPath(compilationConfig_.javaRunPath);
         settingsWindow_->setJavaArgs(compilationConfig_.javaArgs);
+        settingsWindow_->setJavaPersistentJvmEnabled(compilationConfig_.javaPersistentJvm);
         settingsWindow_->setRootDir(fileExplorerRootDir_);
     };
 
@@ -653,6 +605,11 @@ void MainWindow::openSettingsDialog() {
                 CompilationUtils::normalizeLanguage(currentLanguage_),
                 QString{CompilationUtils::kDefaultTemplateCode});
             multithreadingEnabled_ = settingsWindow_->isMultithreadingEnabled();
+            binaryTestStoreEnabled_ = settingsWindow_->isBinaryTestStoreEnabled();
+            settings.setValue("binaryTestStore", binaryTestStoreEnabled_);
+            backgroundCompileEnabled_ = settingsWindow_->isBackgroundCompileEnabled();
+            settings.setValue("backgroundCompile", backgroundCompileEnabled_);
+            speculativeCompiler_->setEnabled(backgroundCompileEnabled_);
             defaultTranscludeTemplateEnabled_ =
                 settingsWindow_->isTranscludeTemplateEnabled();
             settings.setValue("transcludeTemplate", defaultTranscludeTemplateEnabled_);
@@ -663,11 +620,16 @@ void MainWindow::openSettingsDialog() {
             }
             compilationConfig_.cppCompilerPath = settingsWindow_->compilerPath();
             compilationConfig_.cppCompilerFlags = settingsWindow_->compilerFlags();
+            compilationConfig_.cppDiagnosticFlags = settingsWindow_->diagnosticFlags().trimmed();
+            compilationConfig_.cppLinker = settingsWindow_->linker();
+            compilationConfig_.cppPrecompiledHeader = settingsWindow_->isPrecompiledHeaderEnabled();
             compilationConfig_.pythonPath = settingsWindow_->pythonPath();
             compilationConfig_.pythonArgs = settingsWindow_->pythonArgs();
+            compilationConfig_.pythonForkServer = settingsWindow_->isPythonForkServerEnabled();
             compilationConfig_.javaCompilerPath = settingsWindow_->javaCompilerPath();
             compilationConfig_.javaRunPath = settingsWindow_->javaRunPath();
             compilationConfig_.javaArgs = settingsWindow_->javaArgs();
+            compilationConfig_.javaPersistentJvm = settingsWindow_->isJavaPersistentJvmEnabled();
             fileExplorerRootDir_ = settingsWindow_->rootDir().trimmed();
             if (fileExplorerRootDir_.isEmpty() ||
                 !QFileInfo::exists(fileExplorerRootDir_) ||
@@ -686,11 +648,16 @@ void MainWindow::openSettingsDialog() {
             settings.setValue("defaultLanguage", defaultLanguage_);
             settings.setValue("cppCompilerPath", compilationConfig_.cppCompilerPath);
             settings.setValue("cppCompilerFlags", compilationConfig_.cppCompilerFlags);
+            settings.setValue("cppDiagnosticFlags", compilationConfig_.cppDiagnosticFlags);
+            settings.setValue("cppLinker", compilationConfig_.cppLinker);
+            settings.setValue("cppPrecompiledHeader", compilationConfig_.cppPrecompiledHeader);
             settings.setValue("pythonPath", compilationConfig_.pythonPath);
             settings.setValue("pythonArgs", compilationConfig_.pythonArgs);
+            settings.setValue("pythonForkServer", compilationConfig_.pythonForkServer);
             settings.setValue("javaCompilerPath", compilationConfig_.javaCompilerPath);
             settings.setValue("javaRunPath", compilationConfig_.javaRunPath);
             settings.setValue("javaArgs", compilationConfig_.javaArgs);
+            settings.setValue("javaPersistentJvm", compilationConfig_.javaPersistentJvm);
             if (settingsButton_) {
                 settingsButton_->setChecked(false);
                 settingsButton_->setActiveState(false);
@@ -723,6 +690,7 @@ void MainWindow::setupMainEditor() {
     if (codeEditor_) {
         connect(codeEditor_, &QsciScintilla::textChanged, this, [this]() {
             markDirty();
+            speculativeCompiler_->sourceChanged();
         });
         codeEditor_->setContextMenuPolicy(Qt::CustomContextMenu);
         connect(codeEditor_, &QsciScintilla::customContextMenuRequested, this,
@@ -768,6 +736,22 @@ void MainWindow::setupMainEditor() {
     testPanelWidgets_ = testPanelBuilder_.build(this, this, themeManager_.textColor());
     updateProblemMetaUi();
 
+    caseModel_ = new TestCaseModel(this);
+    if (testPanelWidgets_.casesView) {
+        caseDelegate_ = new TestCaseDelegate(
+            [this](QWidget *parent) { return createCaseEditor(parent); },
+            testPanelWidgets_.casesView);
+        caseDelegate_->setColors(themeManager_.colors());
+        testPanelWidgets_.casesView->setItemDelegate(caseDelegate_);
+        testPanelWidgets_.casesView->setModel(caseModel_);
+        // Queued: the current index also moves while rows are being removed
+        connect(testPanelWidgets_.casesView->selectionModel(),
+                &QItemSelectionModel::currentChanged,
+                this, [this]() {
+            setFocusedCase(testPanelWidgets_.casesView->currentIndex().row());
+        }, Qt::QueuedConnection);
+    }
+
     sideStack_ = new QStackedWidget();
     sideStack_->setObjectName("SidePanelStack");
     sideStack_->addWidget(testPanelWidgets_.panel);
@@ -857,15 +841,20 @@ void MainWindow::setupMainEditor() {
         if (filePath.endsWith(".cpack", Qt::CaseInsensitive)) {
             // Validate the file first, before asking to discard
             CpackFileHandler handler;
-            if (!handler.load(filePath)) {
+            if (!handler.load(filePath, TestStore::kPrefix)) {
                 QMessageBox::critical(this, "Error",
                     "Failed to open file: " + handler.errorString());
                 return;
             }
+            std::vector<TestCase> tests;
+            int timeoutSec = 5;
+            if (!readCpackTests(handler, tests, timeoutSec)) {
+                return;
+            }
             if (!confirmDiscardUnsaved("opening another file")) {
                 return;
             }
-            loadCpackFromHandler(handler, filePath, true);
+            loadCpackFromHandler(handler, tests, timeoutSec, filePath, true);
         }
     });
 
@@ -881,6 +870,8 @@ void MainWindow::setupMainEditor() {
     }
 
     sideStack_->addWidget(stressTestPanel_);
+    resourceMonitorPanel_ = new ResourceMonitorPanel(sideStack_);
+    sideStack_->addWidget(resourceMonitorPanel_);
     sideStack_->setCurrentWidget(testPanelWidgets_.panel);
 
     populateCpackTree();
@@ -902,6 +893,10 @@ void MainWindow::setupMainEditor() {
         connect(testPanelWidgets_.runAllButton, &QPushButton::clicked, this,
                 &MainWindow::runAllTests);
     }
+    if (testPanelWidgets_.fillExpectedButton) {
+        connect(testPanelWidgets_.fillExpectedButton, &QPushButton::clicked, this,
+                &MainWindow::fillExpectedFromBrute);
+    }
     if (testPanelWidgets_.addButton) {
         connect(testPanelWidgets_.addButton, &QPushButton::clicked, this, 
                 &MainWindow::addTestCase);
@@ -910,7 +905,6 @@ void MainWindow::setupMainEditor() {
         connect(testPanelWidgets_.clearCasesButton, &QPushButton::clicked, this,
                 &MainWindow::clearAllTestCases);
     }
-
     // Create initial test case
     {
         DirtyScope guard(this);
@@ -990,6 +984,11 @@ void MainWindow::setupMenuBar() {
     helpMenu_ = menuBar_->addMenu("Help");
     QAction *helpAction = helpMenu_->addAction("Help");
     QAction *aboutAction = helpMenu_->addAction("About");
+    helpMenu_->addSeparator();
+    QAction *recordTraceAction = helpMenu_->addAction("Record Performance Trace");
+    recordTraceAction->setCheckable(true);
+    recordTraceAction->setChecked(Trace::isEnabled());
+    QAction *exportTraceAction = helpMenu_->addAction("Export Performance Trace...");
 
     newAction->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_N));
     openAction->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_O));
@@ -1032,6 +1031,13 @@ void MainWindow::setupMenuBar() {
     connect(preferencesAction, &QAction::triggered, this, &MainWindow::openSettingsDialog);
     connect(helpAction, &QAction::triggered, this, &MainWindow::openHelpDialog);
     connect(aboutAction, &QAction::triggered, this, &MainWindow::openAboutDialog);
+    connect(recordTraceAction, &QAction::toggled, this, [](bool checked) {
+        if (checked) {
+            Trace::clear();
+        }
+        Trace::setEnabled(checked);
+    });
+    connect(exportTraceAction, &QAction::triggered, this, &MainWindow::exportTrace);
 
     auto *menuCorner = new QWidget(menuBar_);
     menuCorner->setObjectName("MenuBarCorner");
@@ -1084,6 +1090,9 @@ void MainWindow::setupMenuBar() {
         if (stressTestButton_) {
             stressTestButton_->setChecked(false);
         }
+        if (monitorButton_) {
+            monitorButton_->setChecked(false);
+        }
         if (templateButton_) {
             templateButton_->setChecked(false);
         }
@@ -1134,6 +1143,28 @@ void MainWindow::setupMenuBar() {
     setMenuBar(menuBar_);
 }
 
+void MainWindow::exportTrace() {
+    if (Trace::eventCount() == 0) {
+        QMessageBox::information(this, "Export Performance Trace",
+                                 "Nothing has been recorded yet.\n"
+                                 "Enable Help > Record Performance Trace, run some tests, "
+                                 "then export again.");
+        return;
+    }
+    const QString path = QFileDialog::getSaveFileName(
+        this, "Export Performance Trace", "cfdojo-trace.json", "Trace Files (*.json)");
+    if (path.isEmpty()) {
+        return;
+    }
+    QString error;
+    if (!Trace::save(path, &error)) {
+        QMessageBox::warning(this, "Export Failed",
+                             QString("Could not write %1:\n%2").arg(path, error));
+        return;
+    }
+    showBottomToast("Trace saved; open it in ui.perfetto.dev or chrome://tracing.");
+}
+
 void MainWindow::openHelpDialog() {
     QDialog dialog(this);
     dialog.setWindowTitle("Help");
@@ -1545,6 +1576,10 @@ QString MainWindow::autosaveCpackPath() const {
     return QDir(autosaveDir()).filePath("autosave.cpack");
 }
 
+QString MainWindow::autosaveJournalPath() const {
+    return QDir(autosaveDir()).filePath("autosave.journal");
+}
+
 QString MainWindow::autosaveMetaPath() const {
     return QDir(autosaveDir()).filePath("autosave.json");
 }
@@ -1555,58 +1590,69 @@ void MainWindow::setupAutosave() {
         autosaveTimer_->setSingleShot(true);
         connect(autosaveTimer_, &QTimer::timeout, this, &MainWindow::performAutosave);
     }
+    if (!autosaveWriter_) {
+        autosaveWriter_ = new AutosaveWriter(autosaveCpackPath(),
+                                             autosaveJournalPath(),
+                                             autosaveMetaPath(),
+                                             this);
+    }
 }
 
-void MainWindow::scheduleAutosave() {
-    if (!autosaveTimer_) {
+void MainWindow::offerAutosaveRecovery() {
+    const QString cpackPath = autosaveCpackPath();
+    if (!QFile::exists(cpackPath)) {
         return;
     }
-    autosaveTimer_->start(std::max(1000, autosaveIntervalMs_));
-}
 
-void MainWindow::performAutosave() {
-    if (!isDirty_) {
+    CpackFileHandler handler;
+    std::vector<TestCase> tests;
+    int timeoutSec = 5;
+    if (!AutosaveJournal::recover(cpackPath, autosaveJournalPath(), handler) ||
+        !handler.hasFile("solution.cpp") ||
+        !TestStore::readTests(handler, tests, timeoutSec)) {
+        clearAutosaveFiles();
         return;
     }
 
-    syncEditorToMode();
-    CpackFileHandler handler;
-    handler.addFile("solution.cpp", currentSolutionCode_.toUtf8());
-    handler.addFile("brute.cpp", currentBruteCode_.toUtf8());
-    handler.addFile("generator.cpp", currentGeneratorCode_.toUtf8());
-    handler.addFile("template.cpp", currentTemplate_.toUtf8());
+    QJsonObject meta;
+    QFile metaFile(autosaveMetaPath());
+    if (metaFile.open(QIODevice::ReadOnly)) {
+        meta = QJsonDocument::fromJson(metaFile.readAll()).object();
+    }
+    const QDateTime stamp = QDateTime::fromString(meta.value("timestamp").toString(), Qt::ISODate);
+    const QString when = stamp.isValid()
+        ? QString(" (%1)").arg(stamp.toLocalTime().toString("yyyy-MM-dd hh:mm:ss"))
+        : QString();
 
-    if (problemEdited_) {
-        handler.addFile("problem.json", currentProblemRaw_.toUtf8());
-    } else if (!currentProblem_.isEmpty()) {
-        QJsonDocument problemDoc(currentProblem_);
-        handler.addFile("problem.json", problemDoc.toJson(QJsonDocument::Indented));
+    const auto answer = QMessageBox::question(
+        this,
+        "Recover Unsaved Work",
+        QString("CF Dojo found unsaved work from a previous session%1.\n\n"
+                "Recover it?").arg(when),
+        QMessageBox::Yes | QMessageBox::No,
+        QMessageBox::Yes);
+    if (answer != QMessageBox::Yes) {
+        clearAutosaveFiles();
+        return;
     }
 
-    if (testcasesEdited_) {
-        handler.addFile("testcases.json", currentTestcasesRaw_.toUtf8());
-    } else {
-        QJsonArray testsArray;
-        for (const auto &widgets : caseWidgets_) {
-            QJsonObject testObj;
-            if (widgets.inputEditor) {
-                testObj["input"] = widgets.inputEditor->toPlainText();
-            }
-            if (widgets.expectedEditor) {
-                testObj["output"] = widgets.expectedEditor->toPlainText();
-            }
-            testsArray.append(testObj);
-        }
-        if (!testsArray.isEmpty()) {
-            QJsonObject testsDoc;
-            testsDoc["tests"] = testsArray;
-            testsDoc["timeout"] = currentTimeout_;
-            QJsonDocument doc(testsDoc);
-            handler.addFile("testcases.json", doc.toJson(QJsonDocument::Indented));
-        }
+    const QString filePath = meta.value("filePath").toString();
+    const bool hasSavedFile = meta.value("hasSavedFile").toBool();
+    loadCpackFromHandler(handler, tests, timeoutSec, filePath, hasSavedFile);
+    setDirty(true);
+    // Persist the recovered state right away under a fresh journal
+    performAutosave();
+}
+
+void MainWindow::scheduleAutosave() {
+    if (!autosaveTimer_) {
+        return;
     }
+    autosaveTimer_->start(std::max(1000, autosaveIntervalMs_));
+}
 
-    if (!handler.save(autosaveCpackPath())) {
+void MainWindow::performAutosave() {
+    if (!isDirty_ || !autosaveWriter_) {
         return;
     }
 
@@ -1616,21 +1662,66 @@ void MainWindow::performAutosave() {
     meta["editorMode"] = static_cast<int>(editorMode_);
     meta["dirty"] = true;
     meta["hasSavedFile"] = hasSavedFile_;
-    QJsonDocument metaDoc(meta);
-    QFile metaFile(autosaveMetaPath());
-    if (metaFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-        metaFile.write(metaDoc.toJson(QJsonDocument::Indented));
-        metaFile.close();
-    }
+
+    // Only the snapshot is taken here; serialization and disk I/O happen on
+    // the writer's worker thread.
+    autosaveWriter_->request(captureSnapshot(), meta);
 }
 
 void MainWindow::clearAutosaveFiles() {
+    if (autosaveWriter_) {
+        autosaveWriter_->clear();
+        return;
+    }
     QFile::remove(autosaveCpackPath());
     QFile::remove(autosaveMetaPath());
 }
 
+ProjectSnapshot MainWindow::captureSnapshot() {
+    syncEditorToMode();
+
+    ProjectSnapshot snapshot;
+    snapshot.solution = currentSolutionCode_;
+    snapshot.brute = currentBruteCode_;
+    snapshot.generator = currentGeneratorCode_;
+    snapshot.templateCode = currentTemplate_;
+    snapshot.problem = currentProblem_;
+    snapshot.problemRaw = currentProblemRaw_;
+    snapshot.problemEdited = problemEdited_;
+    snapshot.testcasesRaw = currentTestcasesRaw_;
+    snapshot.testcasesEdited = testcasesEdited_;
+    if (!testcasesEdited_) {
+        snapshot.tests = collectTestCases();
+    }
+    snapshot.timeoutSec = currentTimeout_;
+    snapshot.binaryTests = binaryTestStoreEnabled_;
+    return snapshot;
+}
+
+std::vector<TestCase> MainWindow::collectTestCases() const {
+    std::vector<TestCase> tests;
+    const size_t caseCount = caseModel_ ? static_cast<size_t>(caseModel_->count()) : 0;
+    tests.reserve(caseCount);
+    for (size_t i = 0; i < caseCount; ++i) {
+        tests.push_back(caseData(i));
+    }
+    return tests;
+}
+
+bool MainWindow::readCpackTests(const CpackFileHandler &handler,
+                                std::vector<TestCase> &tests,
+                                int &timeoutSec) {
+    QString error;
+    if (!TestStore::readTests(handler, tests, timeoutSec, &error)) {
+        QMessageBox::critical(this, "Error", "Failed to open file: " + error);
+        return false;
+    }
+    return true;
+}
 
 void MainWindow::loadCpackFromHandler(const CpackFileHandler &handler,
+                                      const std::vector<TestCase> &tests,
+                                      int timeoutSec,
                                       const QString &path,
                                       bool markSavedFile) {
     DirtyScope guard(this);
@@ -1705,49 +1796,12 @@ void MainWindow::loadCpackFromHandler(const CpackFileHandler &handler,
     updateProblemMetaUi();
 
     testcasesEdited_ = false;
-    currentTimeout_ = 5;
-    bool loadedTests = false;
-    for (auto &widgets : caseWidgets_) {
-        if (widgets.panel) {
-            widgets.panel->deleteLater();
-        }
-    }
-    caseWidgets_.clear();
-    testCases_.clear();
-
-    if (handler.hasFile("testcases.json")) {
-        const QByteArray testsBytes = handler.getFile("testcases.json");
-        currentTestcasesRaw_ = QString::fromUtf8(testsBytes);
-        QJsonParseError parseError;
-        QJsonDocument testsDoc = QJsonDocument::fromJson(testsBytes, &parseError);
-        if (parseError.error == QJsonParseError::NoError && testsDoc.isObject()) {
-            QJsonObject testsObj = testsDoc.object();
-            QJsonArray testsArray = testsObj["tests"].toArray();
-
-            if (testsObj.contains("timeout")) {
-                currentTimeout_ = testsObj["timeout"].toInt(5);
-            }
-
-            for (const QJsonValue &testVal : testsArray) {
-                QJsonObject test = testVal.toObject();
-                addTestCase();
-                if (!caseWidgets_.empty()) {
-                    auto &lastCase = caseWidgets_.back();
-                    if (lastCase.inputEditor) {
-                        lastCase.inputEditor->setPlainText(test["input"].toString());
-                    }
-                    if (lastCase.expectedEditor) {
-                        lastCase.expectedEditor->setPlainText(test["output"].toString());
-                    }
-                }
-            }
-            loadedTests = !testsArray.isEmpty();
-        }
-    } else {
-        currentTestcasesRaw_.clear();
-    }
-
-    if (!loadedTests) {
+    currentTimeout_ = timeoutSec;
+    currentTestcasesRaw_ = handler.hasFile("testcases.json")
+        ? QString::fromUtf8(handler.getFile("testcases.json"))
+        : QString();
+    setTestCases(tests);
+    if (tests.empty()) {
         addTestCase();
     }
 
@@ -1768,23 +1822,10 @@ QString MainWindow::buildProblemJson() const {
 }
 
 QString MainWindow::buildTestcasesJson() const {
-    QJsonArray testsArray;
-    for (const auto &widgets : caseWidgets_) {
-        QJsonObject testObj;
-        if (widgets.inputEditor) {
-            testObj["input"] = widgets.inputEditor->toPlainText();
-        }
-        if (widgets.expectedEditor) {
-            testObj["output"] = widgets.expectedEditor->toPlainText();
-        }
-        testsArray.append(testObj);
-    }
-
-    QJsonObject testsDoc;
-    testsDoc["tests"] = testsArray;
-    testsDoc["timeout"] = currentTimeout_;
-    QJsonDocument doc(testsDoc);
-    return QString::fromUtf8(doc.toJson(QJsonDocument::Indented));
+    ProjectSnapshot snapshot;
+    snapshot.tests = collectTestCases();
+    snapshot.timeoutSec = currentTimeout_;
+    return QString::fromUtf8(snapshot.testcasesJson());
 }
 
 
@@ -1885,6 +1926,7 @@ void MainWindow::updateActivityBarActiveStates(bool collapsed) {
         {sidebarToggle_,    nullptr},           // test panel (default)
         {newFileButton_,    fileExplorer_},
         {stressTestButton_, stressTestPanel_},
+        {monitorButton_,    resourceMonitorPanel_},
         {templateButton_,   cpackPanel_},
     };
 
@@ -1900,6 +1942,7 @@ void MainWindow::updateActivityBarActiveStates(bool collapsed) {
                    : (currentPanel != nullptr &&
                       currentPanel != fileExplorer_ &&
                       currentPanel != stressTestPanel_ &&
+                      currentPanel != resourceMonitorPanel_ &&
                       currentPanel != cpackPanel_));
         button->setActiveState(active);
     }
@@ -1925,25 +1968,33 @@ void MainWindow::updateTemplateAvailability() {
 }
 
 void MainWindow::addTestCase() {
-    if (!testPanelWidgets_.casesLayout || !testPanelWidgets_.casesContainer) {
+    if (!caseModel_) {
         return;
     }
+    const int row = caseModel_->appendCase();
+    if (testPanelWidgets_.casesView) {
+        const QModelIndex index = caseModel_->index(row);
+        testPanelWidgets_.casesView->setCurrentIndex(index);
+        testPanelWidgets_.casesView->scrollTo(index);
+    }
+    markDirty();
+}
 
-    const int index = static_cast<int>(caseWidgets_.size()) + 1;
-    TestPanelBuilder::CaseWidgets widgets =
-        testPanelBuilder_.createCase(testPanelWidgets_.casesContainer, this, index);
-
-    // Insert before the spacer if present
-    int insertIndex = testPanelWidgets_.casesLayout->count();
-    if (testPanelWidgets_.addButton) {
-        const int addIndex = testPanelWidgets_.casesLayout->indexOf(testPanelWidgets_.addButton);
-        if (addIndex >= 0) {
-            insertIndex = addIndex;
-        }
+void MainWindow::setTestCases(const std::vector<TestCase> &tests) {
+    clearAllTestCases();
+    if (!caseModel_) {
+        return;
     }
-    testPanelWidgets_.casesLayout->insertWidget(insertIndex, widgets.panel);
-    caseWidgets_.push_back(widgets);
-    testCases_.push_back({});
+    caseModel_->setTests(tests);
+    if (testPanelWidgets_.casesView && !tests.empty()) {
+        testPanelWidgets_.casesView->setCurrentIndex(caseModel_->index(0));
+    }
+}
+
+TestPanelBuilder::CaseWidgets MainWindow::createCaseEditor(QWidget *parent) {
+    // Called by the delegate for each pooled editor; the editor is reused for
+    // whichever case is focused, so handlers look the row up when they fire.
+    TestPanelBuilder::CaseWidgets widgets = testPanelBuilder_.createCase(parent, this, 1);
 
     auto markDirtyOnChange = [this]() {
         markDirty();
@@ -1959,8 +2010,7 @@ void MainWindow::addTestCase() {
 
     // Connect run button
     if (widgets.runButton) {
-        connect(widgets.runButton, &QPushButton::clicked, this,
-                [this, button = widgets.runButton]() {
+        connect(widgets.runButton, &QPushButton::clicked, this, [this]() {
             if (executionController_ &&
                 executionController_->state() != ExecutionController::State::Idle) {
                 if (runAllSequentialActive_) {
@@ -1970,68 +2020,184 @@ void MainWindow::addTestCase() {
                 return;
             }
 
-            const int caseIndex = indexForButton(button);
-            if (caseIndex < 0 || caseIndex >= static_cast<int>(caseWidgets_.size())) {
+            const int index = caseDelegate_ ? caseDelegate_->openRow() : -1;
+            if (!caseModel_ || !caseModel_->isValidRow(index)) {
                 return;
             }
 
-            TestCase &testCase = testCases_.at(static_cast<size_t>(caseIndex));
-            const auto &caseWidgets = caseWidgets_.at(static_cast<size_t>(caseIndex));
-
-            if (caseWidgets.inputEditor) {
-                testCase.input = caseWidgets.inputEditor->toPlainText();
-            }
-            if (caseWidgets.expectedEditor) {
-                testCase.expectedOutput = caseWidgets.expectedEditor->toPlainText();
-            }
-
             // Set template for transclusion before running
             applyRuntimeSettings();
+            beginTimingRun();
             executionController_->setTimeoutMs(currentTimeout_ * 1000);
-            executionController_->runWithBindings(makeBindings(caseWidgets));
+            activeRunIndex_ = index;
+            executionController_->runWithBindings(makeBindings(static_cast<size_t>(index)));
         });
     }
 
     // Connect delete button
     if (widgets.deleteButton) {
-        connect(widgets.deleteButton, &QPushButton::clicked, this,
-                [this, button = widgets.deleteButton]() {
-            const int caseIndex = indexForButton(button);
-            removeTestCase(caseIndex);
+        connect(widgets.deleteButton, &QPushButton::clicked, this, [this]() {
+            removeTestCase(caseDelegate_ ? caseDelegate_->openRow() : -1);
         });
     }
 
-    updateTestCaseTitles();
-    markDirty();
+    return widgets;
+}
+
+void MainWindow::setFocusedCase(int index) {
+    QListView *view = testPanelWidgets_.casesView;
+    if (!view || !caseModel_ || !caseDelegate_) {
+        return;
+    }
+    const int previous = caseDelegate_->openRow();
+    if (previous == index) {
+        return;
+    }
+
+    DirtyScope guard(this);
+    if (previous >= 0) {
+        const QModelIndex previousIndex = caseModel_->index(previous);
+        caseDelegate_->setModelData(caseDelegate_->openEditor().panel, caseModel_, previousIndex);
+        view->closePersistentEditor(previousIndex);
+    }
+    if (caseModel_->isValidRow(index)) {
+        view->openPersistentEditor(caseModel_->index(index));
+    }
+
+    // A run in progress follows its case into or out of the editor widgets
+    if (executionController_->state() != ExecutionController::State::Idle &&
+        activeRunIndex_ >= 0 &&
+        (activeRunIndex_ == previous || activeRunIndex_ == index)) {
+        executionController_->bind(makeBindings(static_cast<size_t>(activeRunIndex_)));
+    }
+}
+
+void MainWindow::refreshFocusedCase() {
+    // Needed after multi-row updates; the view only refreshes editors for
+    // single-row changes
+    const int row = caseDelegate_ ? caseDelegate_->openRow() : -1;
+    if (row < 0 || !caseModel_) {
+        return;
+    }
+    caseDelegate_->setEditorData(caseDelegate_->openEditor().panel, caseModel_->index(row));
+}
+
+void MainWindow::storeCaseOutcome(int index) {
+    if (!caseModel_ || !caseModel_->isValidRow(index)) {
+        return;
+    }
+    const ExecutionController::Outcome &outcome = executionController_->lastOutcome();
+    TestCaseRecord &record = caseModel_->recordRef(index);
+    record.status = outcome.status;
+    record.statusColor = outcome.statusColor;
+    record.output = outcome.output;
+    record.error = outcome.error;
+    record.showOutput = outcome.showOutput;
+    record.showError = outcome.showError;
+    record.diff.reset();
+    record.diffTicket = 0;
+    if (outcome.status.startsWith("WA")) {
+        requestCaseDiff(index);
+    }
+    // Only runs that finished on their own say anything about speed
+    const bool finished = outcome.status.startsWith("AC") || outcome.status.startsWith("WA");
+    updateCaseTiming(index, finished ? executionController_->lastExecutionTimeMs() : -1,
+                     TimingHistory::hash(caseData(static_cast<size_t>(index)).input.toUtf8()));
+    if (!runAllSequentialActive_) {
+        timingHistory_.flush();
+    }
+    caseModel_->recordsChanged(index, index);
+}
+
+void MainWindow::requestCaseDiff(int index) {
+    if (!caseModel_ || !caseModel_->isValidRow(index)) {
+        return;
+    }
+    using ReportPtr = std::shared_ptr<const DiffEngine::Report>;
+    const QString expected = caseData(static_cast<size_t>(index)).expectedOutput;
+    TestCaseRecord &record = caseModel_->recordRef(index);
+    const QString output = record.output;
+    const quint64 ticket = ++lastDiffTicket_;
+    record.diff.reset();
+    record.diffTicket = ticket;
+
+    // The row may move or go away while the diff runs
+    const QPersistentModelIndex row = caseModel_->index(index);
+    auto *watcher = new QFutureWatcher<ReportPtr>(this);
+    connect(watcher, &QFutureWatcher<ReportPtr>::finished, this, [this, watcher, row, ticket]() {
+        watcher->deleteLater();
+        if (!caseModel_ || !row.isValid()) {
+            return;
+        }
+        TestCaseRecord &record = caseModel_->recordRef(row.row());
+        // Rerun or cleared in the meantime
+        if (record.diffTicket != ticket) {
+            return;
+        }
+        record.diff = watcher->result();
+        caseModel_->recordsChanged(row.row(), row.row());
+    });
+    watcher->setFuture(QtConcurrent::run([expected, output]() -> ReportPtr {
+        return std::make_shared<const DiffEngine::Report>(DiffEngine::report(expected, output));
+    }));
+}
+
+TestCase MainWindow::caseData(size_t index) const {
+    if (!caseModel_ || !caseModel_->isValidRow(static_cast<int>(index))) {
+        return TestCase{};
+    }
+    if (caseDelegate_ && static_cast<int>(index) == caseDelegate_->openRow()) {
+        const auto &widgets = caseDelegate_->openEditor();
+        TestCase test;
+        if (widgets.inputEditor) {
+            test.input = widgets.inputEditor->toPlainText();
+        }
+        if (widgets.expectedEditor) {
+            test.expectedOutput = widgets.expectedEditor->toPlainText();
+        }
+        return test;
+    }
+    return caseModel_->record(static_cast<int>(index)).test;
 }
 
 void MainWindow::removeTestCase(int index) {
-    if (index < 0 || index >= static_cast<int>(caseWidgets_.size())) {
+    if (!caseModel_ || !caseModel_->isValidRow(index)) {
         return;
     }
 
-    TestPanelBuilder::CaseWidgets widgets = caseWidgets_.at(static_cast<size_t>(index));
-    if (widgets.panel) {
-        widgets.panel->deleteLater();
+    if (caseDelegate_ && caseDelegate_->openRow() == index && testPanelWidgets_.casesView) {
+        testPanelWidgets_.casesView->closePersistentEditor(caseModel_->index(index));
+    }
+    if (activeRunIndex_ == index &&
+        executionController_->state() != ExecutionController::State::Idle) {
+        // Keep a still running result from landing in another case's editor
+        ExecutionController::UiBindings detached;
+        detached.codeEditor = codeEditor_;
+        executionController_->bind(detached);
     }
 
-    caseWidgets_.erase(caseWidgets_.begin() + index);
-    if (static_cast<size_t>(index) < testCases_.size()) {
-        testCases_.erase(testCases_.begin() + index);
+    caseModel_->removeCase(index);
+    if (activeRunIndex_ == index) {
+        activeRunIndex_ = -1;
+    } else if (activeRunIndex_ > index) {
+        --activeRunIndex_;
     }
 
-    updateTestCaseTitles();
+    refreshFocusedCase();
     markDirty();
 }
 
 void MainWindow::clearAllTestCases() {
-    for (auto &widgets : caseWidgets_) {
-        if (widgets.panel) {
-            widgets.panel->deleteLater();
-        }
+    if (activeRunIndex_ >= 0 &&
+        executionController_->state() != ExecutionController::State::Idle) {
+        ExecutionController::UiBindings detached;
+        detached.codeEditor = codeEditor_;
+        executionController_->bind(detached);
     }
-    caseWidgets_.clear();
-    testCases_.clear();
+    if (caseModel_) {
+        caseModel_->clear();
+    }
+    activeRunIndex_ = -1;
     markDirty();
 }
 
@@ -2044,25 +2210,16 @@ void MainWindow::runNextSequentialTest() {
         const int nextIndex = runAllQueue_.front();
         runAllQueue_.pop_front();
 
-        if (nextIndex < 0 || nextIndex >= static_cast<int>(caseWidgets_.size())) {
+        if (!caseModel_ || !caseModel_->isValidRow(nextIndex)) {
             continue;
         }
 
         runAllCurrentIndex_ = nextIndex;
-
-        TestCase &testCase = testCases_.at(static_cast<size_t>(nextIndex));
-        const auto &widgets = caseWidgets_.at(static_cast<size_t>(nextIndex));
-
-        if (widgets.inputEditor) {
-            testCase.input = widgets.inputEditor->toPlainText();
-        }
-        if (widgets.expectedEditor) {
-            testCase.expectedOutput = widgets.expectedEditor->toPlainText();
-        }
+        activeRunIndex_ = nextIndex;
 
         applyRuntimeSettings();
         executionController_->setTimeoutMs(currentTimeout_ * 1000);
-        executionController_->runWithBindings(makeBindings(widgets));
+        executionController_->runWithBindings(makeBindings(static_cast<size_t>(nextIndex)));
         return;
     }
 
@@ -2071,42 +2228,30 @@ void MainWindow::runNextSequentialTest() {
 
 void MainWindow::cancelSequentialRunAll() {
     runAllSequentialActive_ = false;
+    executionController_->endBatch();
     runAllQueue_.clear();
     runAllCurrentIndex_ = -1;
+    updateRunAllProgress(0, 0);
 }
 
 void MainWindow::applyCompileErrorToAllCases(const QString &error) {
+    if (!caseModel_) {
+        return;
+    }
     const QString trimmedError = error.trimmed();
     const bool showError = !trimmedError.isEmpty();
 
-    for (auto &widgets : caseWidgets_) {
-        if (widgets.statusLabel) {
-            widgets.statusLabel->setText("CE");
-            widgets.statusLabel->setStyleSheet(
-                QString("color: %1; font-weight: 700;")
-                    .arg(themeManager_.colors().statusError.name()));
-        }
-
-        if (widgets.outputViewer) {
-            widgets.outputViewer->clear();
-        }
-        if (widgets.errorViewer) {
-            widgets.errorViewer->setPlainText(trimmedError);
-        }
-
-        if (widgets.outputBlock) {
-            widgets.outputBlock->setVisible(false);
-        }
-        if (widgets.errorBlock) {
-            widgets.errorBlock->setVisible(showError);
-        }
-        if (widgets.outputSplitter) {
-            widgets.outputSplitter->setVisible(showError);
-            if (showError) {
-                widgets.outputSplitter->setSizes({0, 1});
-            }
-        }
+    for (int i = 0; i < caseModel_->count(); ++i) {
+        TestCaseRecord &record = caseModel_->recordRef(i);
+        record.status = "CE";
+        record.statusColor = themeManager_.colors().statusError;
+        record.output.clear();
+        record.error = trimmedError;
+        record.showOutput = false;
+        record.showError = showError;
     }
+    caseModel_->recordsChanged(0, caseModel_->count() - 1);
+    refreshFocusedCase();
 }
 
 void MainWindow::runStressTest() {
@@ -2156,14 +2301,15 @@ void MainWindow::runStressTest() {
     }
 
     if (!stressWatcher_) {
-        stressWatcher_ = new QFutureWatcher<StressResult>(this);
-        connect(stressWatcher_, &QFutureWatcher<StressResult>::finished, this, [this]() {
+        stressWatcher_ = new QFutureWatcher<StressEngine::Result>(this);
+        connect(stressWatcher_, &QFutureWatcher<StressEngine::Result>::finished, this, [this]() {
             stressRunning_ = false;
+            stressEngine_.reset();
             if (stressRunButton_) {
                 stressRunButton_->setEnabled(true);
             }
 
-            const StressResult result = stressWatcher_->result();
+            const StressEngine::Result result = stressWatcher_->result();
             if (stressComplexityLabel_) {
                 if (!result.complexity.isEmpty()) {
                     stressComplexityLabel_->setText(result.complexity);
@@ -2185,7 +2331,7 @@ void MainWindow::runStressTest() {
                 return;
             }
 
-            if (result.passed) {
+            if (result.passed()) {
                 if (stressStatusLabel_) {
                     stressStatusLabel_->setText("Passed");
                     stressStatusLabel_->setStyleSheet(QString("color: %1; font-weight: 700;").arg(themeManager_.colors().statusAc.name()));
@@ -2244,477 +2390,192 @@ void MainWindow::runStressTest() {
         stressComplexityLabel_->clear();
     }
 
-    const int timeoutMs = currentTimeout_ * 1000;
-    const QString solutionCopy = solution;
-    const QString bruteCopy = brute;
-    const QString generatorCopy = generator;
-    CompilationConfig configCopy = compilationConfig_;
-    configCopy.templateCode = tmpl;
-    configCopy.transcludeTemplate = transcludeTemplateEnabled_;
-
-    const bool useParallel = multithreadingEnabled_;
-    stressWatcher_->setFuture(QtConcurrent::run([this, count, solutionCopy, bruteCopy, generatorCopy, configCopy, timeoutMs, useParallel]() {
-        return runStressTestWorker(count, solutionCopy, bruteCopy, generatorCopy, configCopy,
-                                   timeoutMs, useParallel);
+    StressEngine::Config config;
+    config.solution = solution;
+    config.brute = brute;
+    config.generator = generator;
+    config.compilation = compilationConfig_;
+    config.compilation.templateCode = tmpl;
+    config.compilation.transcludeTemplate = transcludeTemplateEnabled_;
+    config.timeoutMs = currentTimeout_ * 1000;
+    config.count = count;
+    config.jobs = multithreadingEnabled_ ? QThread::idealThreadCount() : 1;
+    config.cache = compileCache_;
+    config.outputs = outputCache_;
+
+    auto engine = std::make_shared<StressEngine>(config);
+    stressEngine_ = engine;
+    stressWatcher_->setFuture(QtConcurrent::run([engine]() {
+        return engine->run();
     }));
 }
 
-MainWindow::StressResult MainWindow::runStressTestWorker(int count,
-                                                        const QString &solution,
-                                                        const QString &brute,
-                                                        const QString &generator,
-                                                        const CompilationConfig &config,
-                                                        int timeoutMs,
-                                                        bool parallel) const {
-    StressResult result;
-    result.totalCount = count;
-
-    std::vector<double> inputSizes;
-    std::vector<double> solutionTimes;
-    inputSizes.reserve(static_cast<size_t>(count));
-    solutionTimes.reserve(static_cast<size_t>(count));
-
-    QTemporaryDir tempDir;
-    if (!tempDir.isValid()) {
-        result.error = "Failed to create temporary directory for stress testing.";
-        result.complexity = QString("Suspected: insufficient timing data");
-        return result;
-    }
-
-    const QString tempPath = tempDir.path();
-    const QString language = CompilationUtils::normalizeLanguage(config.language);
-
-#ifdef Q_OS_WIN
-    const QString exeSuffix = ".exe";
-#else
-    const QString exeSuffix;
-#endif
-
-    // ── Per-source preparation ──────────────────────────────────────────
-    // For each of the 3 sources (generator, brute, solution) we need:
-    //   runProgram  – the executable / interpreter path
-    //   runArgs     – arguments to pass before piping stdin
-    // C++:    compile → run the native binary
-    // Python: no compile → run via interpreter
-    // Java:   compile with javac → run via java -cp
-
-    struct SourceBinary {
-        QString program;
-        QStringList args;
-    };
+void MainWindow::fillExpectedFromBrute() {
+    if (fillEngine_ || !caseModel_ || caseModel_->count() == 0) {
+        return;
+    }
 
-    auto prepareSource = [&](const QString &rawCode,
-                             const QString &label,
-                             const QString &baseName,
-                             QString *errorOut) -> std::optional<SourceBinary> {
-        const QString code = CompilationUtils::applyTransclusion(
-            config.templateCode, rawCode, config.transcludeTemplate);
-
-        const QString sourceExt = language == "Python" ? "py"
-                                : language == "Java"   ? "java"
-                                                       : "cpp";
-
-        // Each source gets its own subdirectory to avoid name collisions
-        // (e.g. Java files with the same public class name).
-        const QString sourceDir = QDir(tempPath).filePath(baseName);
-        QDir().mkpath(sourceDir);
-
-        // For Java, detect the public class name from the *transcluded* code
-        const QString sourceBaseName =
-            language == "Java" ? CompilationUtils::detectJavaMainClass(code) : baseName;
-        const QString sourcePath =
-            QDir(sourceDir).filePath(QString("%1.%2").arg(sourceBaseName, sourceExt));
-
-        // Write the source file
-        QFile file(sourcePath);
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            if (errorOut) *errorOut = QString("Failed to write %1 source").arg(label);
-            return std::nullopt;
-        }
-        QTextStream out(&file);
-        out.setEncoding(QStringConverter::Utf8);
-        out << code;
-        file.close();
-
-        SourceBinary bin;
-
-        if (language == "Python") {
-            // No compilation needed — run through interpreter
-#ifdef Q_OS_WIN
-            const QString defaultPython = "python";
-#else
-            const QString defaultPython = "python3";
-#endif
-            bin.program = config.pythonPath.trimmed().isEmpty()
-                ? defaultPython : config.pythonPath.trimmed();
-            bin.args = CompilationUtils::splitArgs(config.pythonArgs);
-            bin.args << sourcePath;
-            return bin;
-        }
-
-        if (language == "Java") {
-            // Compile with javac
-            const QString javacPath = config.javaCompilerPath.trimmed().isEmpty()
-                ? "javac" : config.javaCompilerPath.trimmed();
-            QProcess compiler;
-            compiler.setWorkingDirectory(sourceDir);
-            compiler.start(javacPath, {sourcePath});
-            if (!compiler.waitForFinished(30000)) {
-                if (errorOut) *errorOut = QString("%1 compilation timed out").arg(label);
-                return std::nullopt;
-            }
-            if (compiler.exitCode() != 0) {
-                const QString err = QString::fromUtf8(compiler.readAllStandardError());
-                if (errorOut) *errorOut = err.isEmpty()
-                    ? QString("%1 compilation failed").arg(label) : err;
-                return std::nullopt;
-            }
-            bin.program = config.javaRunPath.trimmed().isEmpty()
-                ? "java" : config.javaRunPath.trimmed();
-            bin.args = CompilationUtils::splitArgs(config.javaArgs);
-            bin.args << "-cp" << sourceDir << sourceBaseName;
-            return bin;
-        }
-
-        // C++ — compile to native binary
-        const QString exePath = QDir(sourceDir).filePath(baseName + exeSuffix);
-        QStringList compileArgs = CompilationUtils::splitArgs(config.cppCompilerFlags);
-        if (compileArgs.isEmpty()) {
-            compileArgs << "-O2" << "-std=c++17";
-        }
-        compileArgs << sourcePath << "-o" << exePath;
-
-        const QString compilerPath = config.cppCompilerPath.trimmed().isEmpty()
-            ? "g++" : config.cppCompilerPath.trimmed();
-        QProcess compiler;
-        compiler.setWorkingDirectory(tempPath);
-        compiler.start(compilerPath, compileArgs);
-        if (!compiler.waitForFinished(30000)) {
-            if (errorOut) *errorOut = QString("%1 compilation timed out").arg(label);
-            return std::nullopt;
-        }
-        if (compiler.exitCode() != 0) {
-            const QString err = QString::fromUtf8(compiler.readAllStandardError());
-            if (errorOut) *errorOut = err.isEmpty()
-                ? QString("%1 compilation failed").arg(label) : err;
-            return std::nullopt;
-        }
-        bin.program = exePath;
-        return bin;
-    };
+    syncEditorToMode();
+    if (currentBruteCode_.trimmed().isEmpty()) {
+        updateTestSummary("Write a brute force in the stress panel first");
+        return;
+    }
+    QString tmpl = currentTemplate_;
+    if (tmpl.isEmpty()) {
+        tmpl = "//#main";
+    }
 
-    // Prepare all three sources
-    QString prepError;
-    auto generatorBin = prepareSource(generator, "Generator", "generator", &prepError);
-    if (!generatorBin) {
-        result.error = QString("Generator error:\n%1").arg(prepError);
-        result.complexity = QString("Suspected: insufficient timing data");
-        return result;
-    }
-    auto bruteBin = prepareSource(brute, "Brute", "brute", &prepError);
-    if (!bruteBin) {
-        result.error = QString("Brute error:\n%1").arg(prepError);
-        result.complexity = QString("Suspected: insufficient timing data");
-        return result;
-    }
-    auto solutionBin = prepareSource(solution, "Solution", "solution", &prepError);
-    if (!solutionBin) {
-        result.error = QString("Solution error:\n%1").arg(prepError);
-        result.complexity = QString("Suspected: insufficient timing data");
-        return result;
-    }
-
-    auto runProcess = [&](const SourceBinary &bin,
-                          const QString &input,
-                          const QString &workingDir,
-                          QString *stdoutOut,
-                          QString *stderrOut,
-                          qint64 *timeMs,
-                          QString *errorOut) -> bool {
-        QProcess process;
-        process.setWorkingDirectory(workingDir);
-        QElapsedTimer timer;
-        timer.start();
-        process.start(bin.program, bin.args);
-        if (!process.waitForStarted(1000)) {
-            if (errorOut) {
-                *errorOut = QString("Failed to start %1").arg(bin.program);
-            }
-            return false;
-        }
-        if (!input.isEmpty()) {
-            process.write(input.toUtf8());
+    // Cases as they are now; one whose input or expected output is edited
+    // before the brute finishes is left alone
+    const int caseCount = caseModel_->count();
+    std::vector<TestCase> cases;
+    QVector<QByteArray> inputBytes;
+    cases.reserve(static_cast<size_t>(caseCount));
+    inputBytes.reserve(caseCount);
+    for (int i = 0; i < caseCount; ++i) {
+        cases.push_back(caseData(static_cast<size_t>(i)));
+        inputBytes.push_back(cases.back().input.toUtf8());
+    }
+
+    if (!fillWatcher_) {
+        fillWatcher_ = new QFutureWatcher<QVector<StressEngine::Reference>>(this);
+    }
+    fillWatcher_->disconnect(this);
+
+    StressEngine::Config config;
+    config.brute = currentBruteCode_;
+    config.compilation = compilationConfig_;
+    config.compilation.templateCode = tmpl;
+    config.compilation.transcludeTemplate = transcludeTemplateEnabled_;
+    config.timeoutMs = currentTimeout_ * 1000;
+    config.jobs = multithreadingEnabled_ ? QThread::idealThreadCount() : 1;
+    config.cache = compileCache_;
+    config.outputs = outputCache_;
+    auto engine = std::make_shared<StressEngine>(config);
+    fillEngine_ = engine;
+    auto compileError = std::make_shared<QString>();
+
+    connect(fillWatcher_, &QFutureWatcher<QVector<StressEngine::Reference>>::finished, this,
+            [this, cases, compileError]() {
+        fillEngine_.reset();
+        if (testPanelWidgets_.fillExpectedButton) {
+            testPanelWidgets_.fillExpectedButton->setEnabled(true);
+        }
+        const QVector<StressEngine::Reference> references = fillWatcher_->result();
+        if (!compileError->isEmpty()) {
+            updateTestSummary(QString());
+            QMessageBox::warning(this, "Brute Failed", *compileError);
+            return;
         }
-        process.closeWriteChannel();
 
-        if (!process.waitForFinished(timeoutMs)) {
-            process.kill();
-            process.waitForFinished(1000);
-            if (errorOut) {
-                *errorOut = QString("Time Limit Exceeded: %1").arg(bin.program);
+        int filled = 0;
+        int cached = 0;
+        int failed = 0;
+        bool openFilled = false;
+        const int openRow = caseDelegate_ ? caseDelegate_->openRow() : -1;
+        const int count = std::min(static_cast<int>(references.size()), caseModel_->count());
+        for (int i = 0; i < count; ++i) {
+            const TestCase test = caseData(static_cast<size_t>(i));
+            const TestCase &before = cases[static_cast<size_t>(i)];
+            if (test.input != before.input || test.expectedOutput != before.expectedOutput) {
+                continue;
             }
-            return false;
-        }
-
-        if (timeMs) {
-            *timeMs = timer.elapsed();
-        }
-
-        if (stdoutOut) {
-            *stdoutOut = QString::fromUtf8(process.readAllStandardOutput());
-        }
-        if (stderrOut) {
-            *stderrOut = QString::fromUtf8(process.readAllStandardError());
-        }
-
-        if (process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0) {
-            if (errorOut) {
-                *errorOut = QString("Runtime Error: %1").arg(bin.program);
+            const StressEngine::Reference &reference = references[i];
+            TestCaseRecord &record = caseModel_->recordRef(i);
+            record.test = test;
+            record.clearResult();
+            if (!reference.ok) {
+                ++failed;
+                record.error = QString("Brute: %1").arg(reference.error.trimmed());
+                record.showError = true;
+                continue;
             }
-            return false;
-        }
-        return true;
-    };
-
-    std::vector<QString> inputs;
-    std::vector<QString> caseDirs;
-    inputs.reserve(static_cast<size_t>(count));
-    caseDirs.reserve(static_cast<size_t>(count));
-
-    for (int i = 0; i < count; ++i) {
-        const QString caseDir = QDir(tempPath).filePath(QString("case_%1").arg(i + 1));
-        QDir().mkpath(caseDir);
-
-        QString input;
-        QString stderrOut;
-        QString runError;
-        if (!runProcess(*generatorBin, QString(), caseDir, &input, &stderrOut, nullptr, &runError)) {
-            result.error = QString("Generator failed on test #%1:\n%2")
-                .arg(i + 1)
-                .arg(runError);
-            if (!stderrOut.isEmpty()) {
-                result.stderrOutput = stderrOut;
+            record.test.expectedOutput = QString::fromUtf8(reference.output);
+            ++filled;
+            openFilled = openFilled || i == openRow;
+            if (reference.cached) {
+                ++cached;
             }
-            result.complexity = QString("Suspected: insufficient timing data");
-            return result;
         }
-
-        inputs.push_back(input);
-        caseDirs.push_back(caseDir);
-        inputSizes.push_back(static_cast<double>(input.size()));
-    }
-
-    if (!parallel) {
-        for (int i = 0; i < count; ++i) {
-            const QString &input = inputs[static_cast<size_t>(i)];
-            const QString &caseDir = caseDirs[static_cast<size_t>(i)];
-            QString runError;
-
-            QString bruteOut;
-            QString bruteErr;
-            if (!runProcess(*bruteBin, input, caseDir, &bruteOut, &bruteErr, nullptr, &runError)) {
-                result.error = QString("Brute failed on test #%1:\n%2")
-                    .arg(i + 1)
-                    .arg(runError);
-                if (!bruteErr.isEmpty()) {
-                    result.stderrOutput = bruteErr;
-                }
-                result.complexity = suspectedComplexityLabel(inputSizes, solutionTimes);
-                return result;
-            }
-
-            QString solutionOut;
-            QString solutionErr;
-            qint64 solutionTime = -1;
-            if (!runProcess(*solutionBin, input, caseDir, &solutionOut, &solutionErr, &solutionTime, &runError)) {
-                result.error = QString("Solution failed on test #%1:\n%2")
-                    .arg(i + 1)
-                    .arg(runError);
-                if (!solutionErr.isEmpty()) {
-                    result.stderrOutput = solutionErr;
-                }
-                result.complexity = suspectedComplexityLabel(inputSizes, solutionTimes);
-                return result;
-            }
-
-            if (solutionTime > 0) {
-                solutionTimes.push_back(static_cast<double>(solutionTime));
+        if (count > 0) {
+            caseModel_->recordsChanged(0, count - 1);
+            // The open editor keeps its own text, which would be written back
+            // over the filled value when focus leaves it
+            if (openFilled) {
+                caseDelegate_->reloadOpenEditor();
             } else {
-                solutionTimes.push_back(0.0);
-            }
-
-            if (CompilationUtils::normalizeText(bruteOut) != CompilationUtils::normalizeText(solutionOut)) {
-                result.passed = false;
-                result.failedIndex = i;
-                result.input = input;
-                result.expected = bruteOut;
-                result.actual = solutionOut;
-                if (!solutionErr.isEmpty()) {
-                    result.stderrOutput = solutionErr;
-                } else if (!bruteErr.isEmpty()) {
-                    result.stderrOutput = bruteErr;
-                }
-                result.complexity = suspectedComplexityLabel(inputSizes, solutionTimes);
-                return result;
+                refreshFocusedCase();
             }
         }
-    } else {
-        struct StressCaseResult {
-            int index = -1;
-            bool passed = false;
-            QString error;
-            QString stderrOutput;
-            QString input;
-            QString expected;
-            QString actual;
-            qint64 solutionTime = -1;
-        };
-
-        QVector<int> indices;
-        indices.reserve(count);
-        for (int i = 0; i < count; ++i) {
-            indices.push_back(i);
-        }
-
-        const auto runCase = [&](int index) -> StressCaseResult {
-            StressCaseResult caseResult;
-            caseResult.index = index;
-            const QString &input = inputs[static_cast<size_t>(index)];
-            const QString &caseDir = caseDirs[static_cast<size_t>(index)];
-            caseResult.input = input;
-
-            QString runError;
-            QString bruteOut;
-            QString bruteErr;
-            if (!runProcess(*bruteBin, input, caseDir, &bruteOut, &bruteErr, nullptr, &runError)) {
-                caseResult.error = QString("Brute failed on test #%1:\n%2")
-                    .arg(index + 1)
-                    .arg(runError);
-                caseResult.stderrOutput = bruteErr;
-                return caseResult;
-            }
-
-            QString solutionOut;
-            QString solutionErr;
-            qint64 solutionTime = -1;
-            if (!runProcess(*solutionBin, input, caseDir, &solutionOut, &solutionErr, &solutionTime, &runError)) {
-                caseResult.error = QString("Solution failed on test #%1:\n%2")
-                    .arg(index + 1)
-                    .arg(runError);
-                caseResult.stderrOutput = solutionErr;
-                return caseResult;
-            }
-
-            caseResult.solutionTime = solutionTime;
-            if (CompilationUtils::normalizeText(bruteOut) != CompilationUtils::normalizeText(solutionOut)) {
-                caseResult.passed = false;
-                caseResult.expected = bruteOut;
-                caseResult.actual = solutionOut;
-                if (!solutionErr.isEmpty()) {
-                    caseResult.stderrOutput = solutionErr;
-                } else if (!bruteErr.isEmpty()) {
-                    caseResult.stderrOutput = bruteErr;
-                }
-                return caseResult;
-            }
-
-            caseResult.passed = true;
-            return caseResult;
-        };
-
-        const QVector<StressCaseResult> results = QtConcurrent::blockingMapped(indices, runCase);
-        solutionTimes.assign(static_cast<size_t>(count), 0.0);
-
-        int firstFailure = -1;
-        StressCaseResult failure;
-        for (const auto &caseResult : results) {
-            if (caseResult.index >= 0 &&
-                caseResult.index < static_cast<int>(solutionTimes.size()) &&
-                caseResult.solutionTime > 0) {
-                solutionTimes[static_cast<size_t>(caseResult.index)] =
-                    static_cast<double>(caseResult.solutionTime);
-            }
-            if (!caseResult.passed &&
-                (firstFailure == -1 || caseResult.index < firstFailure)) {
-                firstFailure = caseResult.index;
-                failure = caseResult;
-            }
+        if (filled > 0) {
+            markDirty();
         }
 
-        if (firstFailure != -1) {
-            result.passed = false;
-            result.failedIndex = firstFailure;
-            if (!failure.error.isEmpty()) {
-                result.error = failure.error;
-            }
-            result.input = failure.input;
-            result.expected = failure.expected;
-            result.actual = failure.actual;
-            result.stderrOutput = failure.stderrOutput;
-            result.complexity = suspectedComplexityLabel(inputSizes, solutionTimes);
-            return result;
+        QString summary = QString("Filled %1 expected %2 from brute")
+                              .arg(filled)
+                              .arg(filled == 1 ? "output" : "outputs");
+        if (cached > 0) {
+            summary += QString(" (%1 cached)").arg(cached);
         }
-    }
+        if (failed > 0) {
+            summary += QString(" \u2022 brute failed on %1").arg(failed);
+        }
+        updateTestSummary(summary);
+    });
 
-    result.passed = true;
-    result.complexity = suspectedComplexityLabel(inputSizes, solutionTimes);
-    return result;
+    if (testPanelWidgets_.fillExpectedButton) {
+        testPanelWidgets_.fillExpectedButton->setEnabled(false);
+    }
+    updateTestSummary(QString("Running brute on %1 %2...")
+                          .arg(caseCount)
+                          .arg(caseCount == 1 ? "case" : "cases"));
+    fillWatcher_->setFuture(QtConcurrent::run([engine, inputBytes, compileError]() {
+        return engine->runBrute(inputBytes, compileError.get());
+    }));
 }
 
 void MainWindow::runAllTests() {
-    if (caseWidgets_.empty() || !codeEditor_) {
+    if (!caseModel_ || caseModel_->count() == 0 || !codeEditor_) {
         return;
     }
     applyRuntimeSettings();
+    beginTimingRun();
 
     runAllInputSizes_.clear();
-    runAllInputSizes_.reserve(caseWidgets_.size());
-    runAllTimesMs_.assign(caseWidgets_.size(), -1.0);
+    const size_t caseCount = static_cast<size_t>(caseModel_->count());
+    runAllInputSizes_.reserve(caseCount);
+    runAllTimesMs_.assign(caseCount, -1.0);
     runAllCollecting_ = true;
     updateTestSummary(QString());
 
     // Collect all test inputs
     std::vector<TestInput> inputs;
-    for (size_t i = 0; i < caseWidgets_.size(); ++i) {
-        const auto &widgets = caseWidgets_[i];
-        const int inputSize = widgets.inputEditor
-            ? widgets.inputEditor->toPlainText().size()
-            : 0;
-        runAllInputSizes_.push_back(static_cast<double>(inputSize));
+    for (size_t i = 0; i < caseCount; ++i) {
+        const TestCase test = caseData(i);
+        runAllInputSizes_.push_back(static_cast<double>(test.input.size()));
         if (multithreadingEnabled_) {
             TestInput input;
             input.testIndex = static_cast<int>(i);
-            input.input = widgets.inputEditor ? widgets.inputEditor->toPlainText() : QString();
-            input.expectedOutput =
-                widgets.expectedEditor ? widgets.expectedEditor->toPlainText() : QString();
+            input.input = test.input.toUtf8();
+            input.expectedOutput = test.expectedOutput.toUtf8();
             inputs.push_back(input);
         }
-        
+
         // Reset status
-        if (widgets.statusLabel) {
-            widgets.statusLabel->setText("-");
-            widgets.statusLabel->setStyleSheet("font-weight: 700;");
-        }
-        if (widgets.outputViewer) {
-            widgets.outputViewer->clear();
-        }
-        if (widgets.errorViewer) {
-            widgets.errorViewer->clear();
-        }
-        if (widgets.outputBlock) {
-            widgets.outputBlock->setVisible(false);
-        }
-        if (widgets.errorBlock) {
-            widgets.errorBlock->setVisible(false);
-        }
-        if (widgets.outputSplitter) {
-            widgets.outputSplitter->setVisible(false);
-        }
+        TestCaseRecord &record = caseModel_->recordRef(static_cast<int>(i));
+        record.test = test;
+        record.clearResult();
     }
+    caseModel_->recordsChanged(0, caseModel_->count() - 1);
+    refreshFocusedCase();
     
     if (multithreadingEnabled_) {
         // Use parallel executor
         cancelSequentialRunAll();
+        parallelResultTimer_->stop();
+        pendingParallelResults_.clear();
+        runAllCompleted_ = 0;
+        updateRunAllProgress(0, static_cast<int>(caseCount));
         parallelExecutor_->setSourceCode(codeEditor_->text());
         parallelExecutor_->setTimeout(currentTimeout_ * 1000);
         parallelExecutor_->runAll(inputs);
@@ -2728,23 +2589,17 @@ void MainWindow::runAllTests() {
         }
 
         runAllSequentialActive_ = true;
+        executionController_->beginBatch();
         runAllQueue_.clear();
-        for (size_t i = 0; i < caseWidgets_.size(); ++i) {
+        for (size_t i = 0; i < caseCount; ++i) {
             runAllQueue_.push_back(static_cast<int>(i));
         }
+        runAllCompleted_ = 0;
+        updateRunAllProgress(0, static_cast<int>(caseCount));
         runNextSequentialTest();
     }
 }
 
-void MainWindow::updateTestCaseTitles() {
-    for (size_t i = 0; i < caseWidgets_.size(); ++i) {
-        auto *label = caseWidgets_[i].titleLabel;
-        if (label) {
-            label->setText(QString("TC %1").arg(static_cast<int>(i + 1)));
-        }
-    }
-}
-
 void MainWindow::updateTestSummary(const QString &text) {
     if (!testPanelWidgets_.summaryLabel) {
         return;
@@ -2758,92 +2613,166 @@ void MainWindow::updateTestSummary(const QString &text) {
     testPanelWidgets_.summaryLabel->setVisible(true);
 }
 
-void MainWindow::applyParallelResult(const TestResult &result) {
+bool MainWindow::applyParallelResult(const TestResult &result) {
     if (result.testIndex < 0 ||
-        result.testIndex >= static_cast<int>(caseWidgets_.size())) {
-        return;
+        !caseModel_ || !caseModel_->isValidRow(result.testIndex)) {
+        return false;
     }
 
-    auto &widgets = caseWidgets_.at(static_cast<size_t>(result.testIndex));
     if (runAllCollecting_ &&
-        result.testIndex >= 0 &&
         static_cast<size_t>(result.testIndex) < runAllTimesMs_.size()) {
         runAllTimesMs_[static_cast<size_t>(result.testIndex)] =
             static_cast<double>(result.executionTimeMs);
     }
 
-    if (widgets.outputViewer) {
-        if (!result.output.isEmpty()) {
-            widgets.outputViewer->setPlainText(result.output);
-            widgets.outputViewer->parentWidget()->show();
-        } else {
-            widgets.outputViewer->parentWidget()->hide();
+    TestCaseRecord &record = caseModel_->recordRef(result.testIndex);
+    record.output = QString::fromUtf8(result.output);
+    record.error = QString::fromUtf8(result.error);
+    if (!result.sanitizerReport.isEmpty()) {
+        if (!record.error.isEmpty()) {
+            record.error += "\n\n";
         }
+        record.error += "Diagnostic build:\n" + result.sanitizerReport;
     }
+    record.showOutput = !result.output.isEmpty();
+    record.showError = !record.error.isEmpty();
 
-    if (widgets.errorViewer) {
-        if (!result.error.isEmpty()) {
-            widgets.errorViewer->setPlainText(result.error);
-            widgets.errorViewer->parentWidget()->show();
-        } else {
-            widgets.errorViewer->parentWidget()->hide();
-        }
-    }
-
-    if (widgets.outputSplitter) {
-        const bool anyVisible =
-            (widgets.outputViewer && widgets.outputViewer->parentWidget()->isVisible()) ||
-            (widgets.errorViewer && widgets.errorViewer->parentWidget()->isVisible());
-        widgets.outputSplitter->setVisible(anyVisible);
-    }
-
-        if (widgets.statusLabel) {
-            const QString timeSuffix = result.executionTimeMs > 0
-                ? QString(" \u2022 %1 ms").arg(result.executionTimeMs)
-                : QString();
-            const bool isTle = result.error.contains("Time Limit Exceeded");
-            if (isTle) {
-                widgets.statusLabel->setText("TLE" + timeSuffix);
-                widgets.statusLabel->setStyleSheet(QString("color: %1; font-weight: 700;").arg(themeManager_.colors().statusError.name()));
-            } else if (result.exitCode != 0 || !result.error.isEmpty()) {
-                widgets.statusLabel->setText("Runtime Error" + timeSuffix);
-                widgets.statusLabel->setStyleSheet(QString("color: %1; font-weight: 700;").arg(themeManager_.colors().statusError.name()));
-            } else if (result.passed) {
-                widgets.statusLabel->setText("AC" + timeSuffix);
-                widgets.statusLabel->setStyleSheet(QString("color: %1; font-weight: 700;").arg(themeManager_.colors().statusAc.name()));
-            } else {
-                widgets.statusLabel->setText("Wrong Answer" + timeSuffix);
-                widgets.statusLabel->setStyleSheet(QString("color: %1; font-weight: 700;").arg(themeManager_.colors().statusError.name()));
-            }
-        }
+    const QString timeSuffix = result.executionTimeMs > 0
+        ? QString(" \u2022 %1 ms").arg(result.executionTimeMs)
+        : QString();
+    const QColor errorColor = themeManager_.colors().statusError;
+    // Same rule as a single Run and --judge; stderr is shown, not judged
+    const QString verdict = CompilationUtils::verdict(
+        result.error.contains("Time Limit Exceeded"), result.exitCode, result.passed);
+    if (verdict == "TLE") {
+        record.status = "TLE" + timeSuffix;
+        record.statusColor = errorColor;
+    } else if (verdict == "RE") {
+        record.status = "Runtime Error" + timeSuffix;
+        record.statusColor = errorColor;
+    } else if (verdict == "AC") {
+        record.status = "AC" + timeSuffix;
+        record.statusColor = themeManager_.colors().statusAc;
+    } else {
+        record.status = "Wrong Answer" + timeSuffix;
+        record.statusColor = errorColor;
+        requestCaseDiff(result.testIndex);
+    }
+    const bool finished = verdict == "AC" || verdict == "WA";
+    updateCaseTiming(result.testIndex, finished ? result.executionTimeMs : -1, result.inputKey);
+    return true;
 }
 
-int MainWindow::indexForButton(const QPushButton *button) const {
-    if (!button) {
-        return -1;
+void MainWindow::flushParallelResults() {
+    if (pendingParallelResults_.empty() || !caseModel_) {
+        pendingParallelResults_.clear();
+        return;
     }
-    for (size_t i = 0; i < caseWidgets_.size(); ++i) {
-        const auto &widgets = caseWidgets_[i];
-        if (widgets.runButton == button || widgets.deleteButton == button) {
-            return static_cast<int>(i);
+
+    Trace::Span span("ui update", QString::number(pendingParallelResults_.size()));
+
+    // Update the records first, then notify the view once for the whole batch
+    int first = caseModel_->count();
+    int last = -1;
+    for (const TestResult &result : pendingParallelResults_) {
+        if (!applyParallelResult(result)) {
+            continue;
         }
+        first = std::min(first, result.testIndex);
+        last = std::max(last, result.testIndex);
+        ++runAllCompleted_;
     }
-    return -1;
+    pendingParallelResults_.clear();
+
+    if (last >= 0) {
+        caseModel_->recordsChanged(first, last);
+        if (first != last) {
+            refreshFocusedCase();
+        }
+    }
+    updateRunAllProgress(runAllCompleted_, caseModel_->count());
+}
+
+void MainWindow::finishRunAllSummary() {
+    QString summary = Complexity::estimateLabel(runAllInputSizes_, runAllTimesMs_);
+    int slower = 0;
+    for (int i = 0; caseModel_ && i < caseModel_->count(); ++i) {
+        if (caseModel_->record(i).trendRegressed) {
+            ++slower;
+        }
+    }
+    if (slower > 0) {
+        const QString note = QString("%1 %2 slower than the previous solution")
+                                 .arg(slower)
+                                 .arg(slower == 1 ? "test" : "tests");
+        summary = summary.isEmpty() ? note : summary + " \u2022 " + note;
+    }
+    updateTestSummary(summary);
+    runAllCollecting_ = false;
+    timingHistory_.flush();
+}
+
+void MainWindow::beginTimingRun() {
+    QString problem = currentProblem_.value("url").toString();
+    if (problem.isEmpty() && hasSavedFile_) {
+        problem = QFileInfo(currentFilePath_).absoluteFilePath();
+    }
+    timingProblemKey_ = TimingHistory::hash(problem.toUtf8());
+    // Same key as the compile cache: a template or flag change is a new solution too
+    const QString code = CompilationUtils::applyTransclusion(
+        compilationConfig_.templateCode,
+        codeEditor_ ? codeEditor_->text() : QString(),
+        compilationConfig_.transcludeTemplate);
+    timingSolutionKey_ = TimingHistory::hash(CompileCache::key(code, compilationConfig_));
+}
+
+void MainWindow::updateCaseTiming(int index, qint64 timeMs, quint64 testKey) {
+    if (!caseModel_ || !caseModel_->isValidRow(index)) {
+        return;
+    }
+    if (timeMs >= 0) {
+        timingHistory_.record(timingProblemKey_, testKey, timingSolutionKey_, timeMs);
+    }
+    const TimingHistory::Trend trend = timingHistory_.trend(timingProblemKey_, testKey);
+    TestCaseRecord &record = caseModel_->recordRef(index);
+    record.trend = trend.text();
+    record.trendRegressed = trend.regressed;
 }
 
-ExecutionController::UiBindings MainWindow::makeBindings(
-    const TestPanelBuilder::CaseWidgets &widgets) const {
+void MainWindow::updateRunAllProgress(int completed, int total) {
+    QProgressBar *bar = testPanelWidgets_.progressBar;
+    if (!bar) {
+        return;
+    }
+    QWidget *row = bar->parentWidget();
+    if (total <= 0) {
+        row->setVisible(false);
+        return;
+    }
+    bar->setRange(0, total);
+    bar->setValue(std::min(completed, total));
+    row->setVisible(true);
+}
+
+ExecutionController::UiBindings MainWindow::makeBindings(size_t index) const {
     ExecutionController::UiBindings bindings;
     bindings.codeEditor = codeEditor_;
-    bindings.inputEditor = widgets.inputEditor;
-    bindings.expectedEditor = widgets.expectedEditor;
-    bindings.outputViewer = widgets.outputViewer;
-    bindings.errorViewer = widgets.errorViewer;
-    bindings.statusLabel = widgets.statusLabel;
-    bindings.outputSplitter = widgets.outputSplitter;
-    bindings.outputBlock = widgets.outputBlock;
-    bindings.errorBlock = widgets.errorBlock;
-    bindings.runButton = widgets.runButton;
+    if (caseDelegate_ && static_cast<int>(index) == caseDelegate_->openRow()) {
+        const auto &widgets = caseDelegate_->openEditor();
+        bindings.inputEditor = widgets.inputEditor;
+        bindings.expectedEditor = widgets.expectedEditor;
+        bindings.outputViewer = widgets.outputViewer;
+        bindings.errorViewer = widgets.errorViewer;
+        bindings.statusLabel = widgets.statusLabel;
+        bindings.outputSplitter = widgets.outputSplitter;
+        bindings.outputBlock = widgets.outputBlock;
+        bindings.errorBlock = widgets.errorBlock;
+        bindings.runButton = widgets.runButton;
+    } else if (caseModel_ && caseModel_->isValidRow(static_cast<int>(index))) {
+        const TestCase &test = caseModel_->record(static_cast<int>(index)).test;
+        bindings.input = test.input;
+        bindings.expectedOutput = test.expectedOutput;
+    }
     return bindings;
 }
 
@@ -2890,6 +2819,7 @@ void MainWindow::applyUiZoom() {
     };
     scaleActivityButton(sidebarToggle_);
     scaleActivityButton(stressTestButton_);
+    scaleActivityButton(monitorButton_);
     scaleActivityButton(templateButton_);
     scaleActivityButton(newFileButton_);
     scaleActivityButton(settingsButton_);
@@ -2931,7 +2861,7 @@ void MainWindow::applyUiZoom() {
             btn->setIconSize(iconSz);
             btn->setFixedSize(smallBtnSz);
         } else if (name == "RunAllButton" || name == "ClearCasesButton"
-                   || name == "AddCaseButton") {
+                   || name == "FillExpectedButton" || name == "AddCaseButton") {
             btn->setIconSize(iconSz);
             btn->setMinimumHeight(smallBtnPx);
         }
@@ -3081,18 +3011,23 @@ void MainWindow::openFile() {
     
     // Validate the file can be loaded before discarding current work.
     CpackFileHandler handler;
-    if (!handler.load(path)) {
+    if (!handler.load(path, TestStore::kPrefix)) {
         QMessageBox::critical(this, "Error", 
             "Failed to open file: " + handler.errorString());
         return;
     }
+    std::vector<TestCase> tests;
+    int timeoutSec = 5;
+    if (!readCpackTests(handler, tests, timeoutSec)) {
+        return;
+    }
 
     // Only now ask the user to discard unsaved work — the new file is known-good.
     if (!confirmDiscardUnsaved("opening another file")) {
         return;
     }
 
-    loadCpackFromHandler(handler, path, true);
+    loadCpackFromHandler(handler, tests, timeoutSec, path, true);
 }
 
 void MainWindow::saveFile() {
@@ -3102,44 +3037,8 @@ void MainWindow::saveFile() {
     }
     
     CpackFileHandler handler;
-    
-    syncEditorToMode();
-
-    handler.addFile("solution.cpp", currentSolutionCode_.toUtf8());
-    handler.addFile("brute.cpp", currentBruteCode_.toUtf8());
-    handler.addFile("generator.cpp", currentGeneratorCode_.toUtf8());
-    handler.addFile("template.cpp", currentTemplate_.toUtf8());
-
-    if (problemEdited_) {
-        handler.addFile("problem.json", currentProblemRaw_.toUtf8());
-    } else if (!currentProblem_.isEmpty()) {
-        QJsonDocument problemDoc(currentProblem_);
-        handler.addFile("problem.json", problemDoc.toJson(QJsonDocument::Indented));
-    }
+    captureSnapshot().writeTo(handler);
 
-    if (testcasesEdited_) {
-        handler.addFile("testcases.json", currentTestcasesRaw_.toUtf8());
-    } else {
-        QJsonArray testsArray;
-        for (const auto &widgets : caseWidgets_) {
-            QJsonObject testObj;
-            if (widgets.inputEditor) {
-                testObj["input"] = widgets.inputEditor->toPlainText();
-            }
-            if (widgets.expectedEditor) {
-                testObj["output"] = widgets.expectedEditor->toPlainText();
-            }
-            testsArray.append(testObj);
-        }
-        if (!testsArray.isEmpty()) {
-            QJsonObject testsDoc;
-            testsDoc["tests"] = testsArray;
-            testsDoc["timeout"] = currentTimeout_;
-            QJsonDocument doc(testsDoc);
-            handler.addFile("testcases.json", doc.toJson(QJsonDocument::Indented));
-        }
-    }
-    
     if (!handler.save(currentFilePath_)) {
         QMessageBox::critical(this, "Error", 
             "Failed to save file: " + handler.errorString());
@@ -3186,7 +3085,7 @@ void MainWindow::onProblemReceived(const QJsonObject &problem) {
         return;
     }
     // Ensure UI is ready
-    if (!testPanelWidgets_.casesLayout || !testPanelWidgets_.casesContainer) {
+    if (!caseModel_) {
         return;
     }
     
@@ -3204,8 +3103,11 @@ void MainWindow::onProblemReceived(const QJsonObject &problem) {
     // Check if .cpack file already exists
     if (QFile::exists(cpackPath)) {
         CpackFileHandler handler;
-        if (handler.load(cpackPath)) {
-            loadCpackFromHandler(handler, cpackPath, true);
+        std::vector<TestCase> tests;
+        int timeoutSec = 5;
+        if (handler.load(cpackPath, TestStore::kPrefix) &&
+            TestStore::readTests(handler, tests, timeoutSec)) {
+            loadCpackFromHandler(handler, tests, timeoutSec, cpackPath, true);
             baseWindowTitle_ = QString("CF Dojo - %1").arg(problemName);
             setDirty(false);
             raise();
@@ -3253,32 +3155,17 @@ void MainWindow::onProblemReceived(const QJsonObject &problem) {
     currentTimeout_ = 5;
     updateProblemMetaUi();
     
-    // Clear existing test cases and add new ones from problem
-    clearAllTestCases();
-    
-    QJsonArray tests = problem["tests"].toArray();
-    for (const QJsonValue &testVal : tests) {
-        QJsonObject test = testVal.toObject();
-        QString input = test["input"].toString();
-        QString output = test["output"].toString();
-        
-        // Add test case
-        addTestCase();
-        
-        // Fill in the test case data
-        if (!caseWidgets_.empty()) {
-            auto &widgets = caseWidgets_.back();
-            if (widgets.inputEditor) {
-                widgets.inputEditor->setPlainText(input);
-            }
-            if (widgets.expectedEditor) {
-                widgets.expectedEditor->setPlainText(output);
-            }
-        }
+    // Replace existing test cases with the ones from the problem
+    std::vector<TestCase> tests;
+    const QJsonArray testsArray = problem["tests"].toArray();
+    for (const QJsonValue &testVal : testsArray) {
+        const QJsonObject test = testVal.toObject();
+        tests.push_back({test["input"].toString(), test["output"].toString()});
     }
-    
+    setTestCases(tests);
+
     // If no tests, add one empty test case
-    if (tests.isEmpty()) {
+    if (tests.empty()) {
         addTestCase();
     }
     currentTestcasesRaw_ = buildTestcasesJson();
@@ -4,6 +4,9 @@
 #include "execution/CompilationConfig.h"
 #include "execution/ExecutionController.h"
 #include "execution/ParallelExecutor.h"
+#include "execution/StressEngine.h"
+#include "file/ProjectSnapshot.h"
+#include "file/TimingHistory.h"
 #include "ui/TestPanelBuilder.h"
 #include "theme/ThemeManager.h"
 
@@ -14,6 +17,7 @@
 #include <QString>
 #include <QJsonObject>
 #include <deque>
+#include <memory>
 #include <vector>
 
 class QShortcut;
@@ -24,8 +28,11 @@ class QsciScintilla;
 class QFileSystemModel;
 class QTreeView;
 class ActivityBarButton;
+class ResourceMonitorPanel;
 class CollapsibleSplitter;
 class CompanionListener;
+class CompileCache;
+class SpeculativeCompiler;
 class SettingsDialog;
 class QPushButton;
 class QLabel;
@@ -36,14 +43,12 @@ class QStandardItemModel;
 class QStandardItem;
 class QCloseEvent;
 class CpackFileHandler;
+class AutosaveWriter;
+class TestCaseDelegate;
+class TestCaseModel;
 template <typename T>
 class QFutureWatcher;
 
-struct TestCase {
-    QString input;
-    QString expectedOutput;
-};
-
 class MainWindow : public QMainWindow {
     Q_OBJECT
 
@@ -68,18 +73,6 @@ private slots:
     void onProblemReceived(const QJsonObject &problem);
 
 private:
-    struct StressResult {
-        bool passed = false;
-        int failedIndex = -1;
-        int totalCount = 0;
-        QString input;
-        QString expected;
-        QString actual;
-        QString error;
-        QString stderrOutput;
-        QString complexity;
-    };
-
     enum class EditorMode {
         Solution,
         Brute,
@@ -94,6 +87,7 @@ private:
     void setupMainEditor();
     void setupMenuBar();
     void openHelpDialog();
+    void exportTrace();
     void openAboutDialog();
     void setupZoomShortcuts();
     void setupCompanionListener();
@@ -105,27 +99,38 @@ private:
     void saveFileAsWithTitle(const QString &title);
     void populateCpackTree();
     void runStressTest();
-    StressResult runStressTestWorker(int count,
-                                     const QString &solution,
-                                     const QString &brute,
-                                     const QString &generator,
-                                     const CompilationConfig &config,
-                                     int timeoutMs,
-                                     bool parallel) const;
+    // Run the brute over every case's input and write its outputs in as
+    // the expected outputs
+    void fillExpectedFromBrute();
     void updateTestSummary(const QString &text);
-    void applyParallelResult(const TestResult &result);
+    // Updates the record only; the caller notifies the model
+    bool applyParallelResult(const TestResult &result);
+    void flushParallelResults();
+    void updateRunAllProgress(int completed, int total);
+    void finishRunAllSummary();
+    // Hash the problem and solution that the next results belong to
+    void beginTimingRun();
+    // Record a finished run (timeMs < 0: nothing to record) and refresh the
+    // case's trend; the caller notifies the model. `testKey` is
+    // TimingHistory::hash of the input that ran.
+    void updateCaseTiming(int index, qint64 timeMs, quint64 testKey);
 
     void addTestCase();
+    void setTestCases(const std::vector<TestCase> &tests);
+    TestPanelBuilder::CaseWidgets createCaseEditor(QWidget *parent);
+    void setFocusedCase(int index);
+    void refreshFocusedCase();
+    void storeCaseOutcome(int index);
+    // Diff the case's output against its expected output on a worker thread
+    void requestCaseDiff(int index);
+    TestCase caseData(size_t index) const;
     void removeTestCase(int index);
     void clearAllTestCases();
-    void updateTestCaseTitles();
     void runAllTests();
     void runNextSequentialTest();
     void cancelSequentialRunAll();
     void applyCompileErrorToAllCases(const QString &error);
-    int indexForButton(const QPushButton *button) const;
-    ExecutionController::UiBindings makeBindings(
-        const TestPanelBuilder::CaseWidgets &widgets) const;
+    ExecutionController::UiBindings makeBindings(size_t index) const;
     void setEditorMode(EditorMode mode);
     void syncEditorToMode();
     void updateEditorModeButtons();
@@ -136,18 +141,31 @@ private:
     void scheduleAutosave();
     void performAutosave();
     void clearAutosaveFiles();
+    void offerAutosaveRecovery();
     QString autosaveDir() const;
     QString autosaveCpackPath() const;
+    QString autosaveJournalPath() const;
     QString autosaveMetaPath() const;
+    // Reads every test so a damaged archive is refused before anything is
+    // replaced; shows the error and returns false if one cannot be read
+    bool readCpackTests(const CpackFileHandler &handler,
+                        std::vector<TestCase> &tests,
+                        int &timeoutSec);
     void loadCpackFromHandler(const CpackFileHandler &handler,
+                              const std::vector<TestCase> &tests,
+                              int timeoutSec,
                               const QString &path,
                               bool markSavedFile);
     QString buildProblemJson() const;
     QString buildTestcasesJson() const;
+    ProjectSnapshot captureSnapshot();
+    std::vector<TestCase> collectTestCases() const;
     void updateActivityBarActiveStates(bool collapsed);
     void updateTemplateAvailability();
     void loadRuntimeSettings();
     void applyRuntimeSettings();
+    // Language and template of the current problem on top of the saved settings
+    CompilationConfig runtimeConfig() const;
     void applyFileExplorerRootDirectory(const QString &path);
     QString languageForPath(const QString &path) const;
     void setCurrentLanguage(const QString &language);
@@ -167,6 +185,7 @@ private:
     QWidget *activityBarEdge_ = nullptr;
     ActivityBarButton *sidebarToggle_ = nullptr;
     ActivityBarButton *stressTestButton_ = nullptr;
+    ActivityBarButton *monitorButton_ = nullptr;
     ActivityBarButton *templateButton_ = nullptr;
     ActivityBarButton *newFileButton_ = nullptr;
     QPointer<ActivityBarButton> settingsButton_;
@@ -178,17 +197,24 @@ private:
     QStackedWidget *sideStack_ = nullptr;
     QWidget *fileExplorer_ = nullptr;
     QWidget *stressTestPanel_ = nullptr;
+    ResourceMonitorPanel *resourceMonitorPanel_ = nullptr;
     QWidget *cpackPanel_ = nullptr;
     QPushButton *stressRunButton_ = nullptr;
     QLabel *stressStatusLabel_ = nullptr;
     QLabel *stressComplexityLabel_ = nullptr;
     QPlainTextEdit *stressLog_ = nullptr;
     QLineEdit *stressCountEdit_ = nullptr;
-    QFutureWatcher<StressResult> *stressWatcher_ = nullptr;
+    QFutureWatcher<StressEngine::Result> *stressWatcher_ = nullptr;
+    std::shared_ptr<StressEngine> stressEngine_;  // running stress test
     bool stressRunning_ = false;
+    QFutureWatcher<QVector<StressEngine::Reference>> *fillWatcher_ = nullptr;
+    std::shared_ptr<StressEngine> fillEngine_;  // running brute over the cases
     std::vector<double> runAllInputSizes_;
     std::vector<double> runAllTimesMs_;
     bool runAllCollecting_ = false;
+    TimingHistory timingHistory_;
+    quint64 timingProblemKey_ = 0;
+    quint64 timingSolutionKey_ = 0;
     QTreeView *cpackTree_ = nullptr;
     QStandardItemModel *cpackModel_ = nullptr;
     QStandardItem *cpackTemplateItem_ = nullptr;
@@ -196,7 +222,8 @@ private:
     QFileSystemModel *fileModel_ = nullptr;
     QsciScintilla *codeEditor_ = nullptr;
     TestPanelBuilder::PanelWidgets testPanelWidgets_;
-    std::vector<TestPanelBuilder::CaseWidgets> caseWidgets_;
+    TestCaseModel *caseModel_ = nullptr;
+    TestCaseDelegate *caseDelegate_ = nullptr;
 
     // Menu
     QMenuBar *menuBar_ = nullptr;
@@ -207,6 +234,7 @@ private:
     QLabel *copyToastLabel_ = nullptr;
     QTimer *copyToastTimer_ = nullptr;
     QTimer *autosaveTimer_ = nullptr;
+    AutosaveWriter *autosaveWriter_ = nullptr;
 
     // Zoom
     double uiScale_ = 1.0;
@@ -216,7 +244,11 @@ private:
     QShortcut *zoomResetShortcut_ = nullptr;
 
     // Test case data
-    std::vector<TestCase> testCases_;
+    int activeRunIndex_ = -1;
+    std::vector<TestResult> pendingParallelResults_;
+    QTimer *parallelResultTimer_ = nullptr;
+    int runAllCompleted_ = 0;
+    quint64 lastDiffTicket_ = 0;
     
     // Current file
     QString currentFilePath_;
@@ -244,12 +276,17 @@ private:
     
     // Experimental settings
     bool multithreadingEnabled_ = false;
+    bool binaryTestStoreEnabled_ = false;
+    bool backgroundCompileEnabled_ = false;
     bool defaultTranscludeTemplateEnabled_ = false;
     bool transcludeTemplateEnabled_ = false;
-    int autosaveIntervalMs_ = 15000;
+    int autosaveIntervalMs_ = 3000;
     QString defaultLanguage_ = "C++";
     QString currentLanguage_ = "C++";
     CompilationConfig compilationConfig_;
+    std::shared_ptr<CompileCache> compileCache_;
+    std::shared_ptr<OutputCache> outputCache_;  // brute outputs for stress and fill
+    SpeculativeCompiler *speculativeCompiler_ = nullptr;
     QString fileExplorerRootDir_;
 
     // Dirty state
@@ -95,10 +95,11 @@ QWidget* SettingsDialog::createGeneralTab() {
     autosaveLayout->setSpacing(8);
 
     autosaveIntervalSpin_ = new QSpinBox(autosaveGroup);
-    autosaveIntervalSpin_->setRange(5, 300);
-    autosaveIntervalSpin_->setSingleStep(5);
+    // Autosave only appends deltas to a journal, so short intervals are cheap
+    autosaveIntervalSpin_->setRange(1, 300);
+    autosaveIntervalSpin_->setSingleStep(1);
     autosaveIntervalSpin_->setSuffix(" s");
-    autosaveIntervalSpin_->setValue(15);
+    autosaveIntervalSpin_->setValue(3);
     connect(autosaveIntervalSpin_, QOverload<int>::of(&QSpinBox::valueChanged),
             this, &SettingsDialog::settingsChanged);
 
@@ -182,6 +183,33 @@ QWidget* SettingsDialog::createLanguagesTab() {
     cppCompilerFlagsEdit_->setPlaceholderText("-O2 -std=c++17");
     cppLayout->addRow("Compiler Flags:", cppCompilerFlagsEdit_);
 
+    cppDiagnosticFlagsEdit_ = new QLineEdit(cppGroup);
+    cppDiagnosticFlagsEdit_->setPlaceholderText("-O1 -g -std=c++17 -fsanitize=address,undefined");
+    cppDiagnosticFlagsEdit_->setToolTip(
+        "Run All also builds the solution with these flags in the background and\n"
+        "reruns every test that crashes or exits non-zero with that build,\n"
+        "attaching the sanitizer report to the test. Leave empty to turn it off.");
+    cppLayout->addRow("Diagnostic Flags:", cppDiagnosticFlagsEdit_);
+
+    cppLinkerCombo_ = new QComboBox(cppGroup);
+    cppLinkerCombo_->setEditable(true);
+    cppLinkerCombo_->addItems({"auto", "default", "mold", "lld", "gold"});
+    cppLinkerCombo_->setToolTip(
+        "auto picks the fastest installed linker (mold, lld, gold) and falls\n"
+        "back to the compiler's default if the compiler does not accept it.\n"
+        "Any other value is passed as -fuse-ld=<value>.");
+    connect(cppLinkerCombo_, &QComboBox::currentTextChanged,
+            this, &SettingsDialog::settingsChanged);
+    cppLayout->addRow("Linker:", cppLinkerCombo_);
+
+    cppPrecompiledHeaderCheckbox_ = new QCheckBox("Precompile <bits/stdc++.h> (GCC)", cppGroup);
+    cppPrecompiledHeaderCheckbox_->setToolTip(
+        "Builds <bits/stdc++.h> once per compiler and flags in the background\n"
+        "and reuses it for every solution that includes it.");
+    connect(cppPrecompiledHeaderCheckbox_, &QCheckBox::toggled,
+            this, &SettingsDialog::settingsChanged);
+    cppLayout->addRow(cppPrecompiledHeaderCheckbox_);
+
     auto *pythonGroup = new QGroupBox("Python", widget);
     auto *pythonLayout = new QFormLayout(pythonGroup);
 
@@ -193,6 +221,18 @@ QWidget* SettingsDialog::createLanguagesTab() {
     pythonArgsEdit_->setPlaceholderText("-O");
     pythonLayout->addRow("Run Args:", pythonArgsEdit_);
 
+    pythonForkServerCheckbox_ = new QCheckBox("Fork tests from a preloaded interpreter", pythonGroup);
+    pythonForkServerCheckbox_->setToolTip(
+        "Run All and stress testing fork each test from an interpreter that has\n"
+        "already compiled the solution and imported its modules, instead of\n"
+        "starting python every time. Not available on Windows.");
+#ifdef Q_OS_WIN
+    pythonForkServerCheckbox_->setEnabled(false);
+#endif
+    pythonLayout->addRow(pythonForkServerCheckbox_);
+    connect(pythonForkServerCheckbox_, &QCheckBox::toggled,
+            this, &SettingsDialog::settingsChanged);
+
     auto *javaGroup = new QGroupBox("Java", widget);
     auto *javaLayout = new QFormLayout(javaGroup);
 
@@ -208,6 +248,15 @@ QWidget* SettingsDialog::createLanguagesTab() {
     javaArgsEdit_->setPlaceholderText("");
     javaLayout->addRow("Run Args:", javaArgsEdit_);
 
+    javaPersistentJvmCheckbox_ = new QCheckBox("Keep a JVM running between tests", javaGroup);
+    javaPersistentJvmCheckbox_->setToolTip(
+        "Run All and stress testing load each test into a JVM that is already\n"
+        "running instead of starting java every time. Solutions must use\n"
+        "System.in and System.out; anything else is run the usual way.");
+    javaLayout->addRow(javaPersistentJvmCheckbox_);
+    connect(javaPersistentJvmCheckbox_, &QCheckBox::toggled,
+            this, &SettingsDialog::settingsChanged);
+
     layout->addWidget(defaultGroup);
     layout->addWidget(cppGroup);
     layout->addWidget(pythonGroup);
@@ -231,7 +280,7 @@ QWidget* SettingsDialog::createExperimentalTab() {
 
     layout->addSpacing(12);
 
-    auto *perfGroup = new QGroupBox("Multithreading", widget);
+    auto *perfGroup = new QGroupBox("Performance", widget);
     auto *perfLayout = new QVBoxLayout(perfGroup);
 
     multithreadingCheckbox_ = new QCheckBox("Enable parallel test execution", perfGroup);
@@ -242,7 +291,29 @@ QWidget* SettingsDialog::createExperimentalTab() {
     connect(multithreadingCheckbox_, &QCheckBox::toggled,
             this, &SettingsDialog::onMultithreadingToggled);
 
+    backgroundCompileCheckbox_ = new QCheckBox("Compile in the background while editing", perfGroup);
+    backgroundCompileCheckbox_->setToolTip(
+        "Build the solution at low priority whenever you pause typing,\n"
+        "so Run usually starts without waiting for the compiler.");
+    perfLayout->addWidget(backgroundCompileCheckbox_);
+    connect(backgroundCompileCheckbox_, &QCheckBox::toggled,
+            this, &SettingsDialog::settingsChanged);
+
     layout->addWidget(perfGroup);
+
+    auto *storageGroup = new QGroupBox("Storage", widget);
+    auto *storageLayout = new QVBoxLayout(storageGroup);
+
+    binaryTestStoreCheckbox_ = new QCheckBox("Save test cases in binary format", storageGroup);
+    binaryTestStoreCheckbox_->setToolTip(
+        "Store each test input/output as a raw archive entry instead of testcases.json.\n"
+        "Large tests load faster, with no JSON escaping to undo.\n"
+        "Older CF Dojo versions will not see these tests.");
+    storageLayout->addWidget(binaryTestStoreCheckbox_);
+    connect(binaryTestStoreCheckbox_, &QCheckBox::toggled,
+            this, &SettingsDialog::settingsChanged);
+
+    layout->addWidget(storageGroup);
     layout->addStretch();
 
     return widget;
@@ -336,6 +407,38 @@ QString SettingsDialog::compilerFlags() const {
     return cppCompilerFlagsEdit_ ? cppCompilerFlagsEdit_->text() : "";
 }
 
+void SettingsDialog::setDiagnosticFlags(const QString &flags) {
+    if (cppDiagnosticFlagsEdit_) {
+        cppDiagnosticFlagsEdit_->setText(flags);
+    }
+}
+
+QString SettingsDialog::diagnosticFlags() const {
+    return cppDiagnosticFlagsEdit_ ? cppDiagnosticFlagsEdit_->text() : "";
+}
+
+void SettingsDialog::setLinker(const QString &linker) {
+    if (cppLinkerCombo_) {
+        QSignalBlocker blocker(cppLinkerCombo_);
+        cppLinkerCombo_->setCurrentText(linker.trimmed().isEmpty() ? "auto" : linker);
+    }
+}
+
+QString SettingsDialog::linker() const {
+    return cppLinkerCombo_ ? cppLinkerCombo_->currentText().trimmed() : "auto";
+}
+
+void SettingsDialog::setPrecompiledHeaderEnabled(bool enabled) {
+    if (cppPrecompiledHeaderCheckbox_) {
+        QSignalBlocker blocker(cppPrecompiledHeaderCheckbox_);
+        cppPrecompiledHeaderCheckbox_->setChecked(enabled);
+    }
+}
+
+bool SettingsDialog::isPrecompiledHeaderEnabled() const {
+    return cppPrecompiledHeaderCheckbox_ ? cppPrecompiledHeaderCheckbox_->isChecked() : true;
+}
+
 void SettingsDialog::setDefaultLanguage(const QString &language) {
     if (!defaultLanguageCombo_) {
         return;
@@ -370,6 +473,17 @@ QString SettingsDialog::pythonArgs() const {
     return pythonArgsEdit_ ? pythonArgsEdit_->text() : "";
 }
 
+void SettingsDialog::setPythonForkServerEnabled(bool enabled) {
+    if (pythonForkServerCheckbox_) {
+        QSignalBlocker blocker(pythonForkServerCheckbox_);
+        pythonForkServerCheckbox_->setChecked(enabled);
+    }
+}
+
+bool SettingsDialog::isPythonForkServerEnabled() const {
+    return pythonForkServerCheckbox_ ? pythonForkServerCheckbox_->isChecked() : false;
+}
+
 void SettingsDialog::setJavaCompilerPath(const QString &path) {
     if (javaCompilerPathEdit_) {
         javaCompilerPathEdit_->setText(path);
@@ -400,6 +514,17 @@ QString SettingsDialog::javaArgs() const {
     return javaArgsEdit_ ? javaArgsEdit_->text() : "";
 }
 
+void SettingsDialog::setJavaPersistentJvmEnabled(bool enabled) {
+    if (javaPersistentJvmCheckbox_) {
+        QSignalBlocker blocker(javaPersistentJvmCheckbox_);
+        javaPersistentJvmCheckbox_->setChecked(enabled);
+    }
+}
+
+bool SettingsDialog::isJavaPersistentJvmEnabled() const {
+    return javaPersistentJvmCheckbox_ ? javaPersistentJvmCheckbox_->isChecked() : false;
+}
+
 void SettingsDialog::setRootDir(const QString &path) {
     if (rootDirEdit_) {
         rootDirEdit_->setText(path);
@@ -419,7 +544,7 @@ void SettingsDialog::setAutosaveIntervalSeconds(int seconds) {
 }
 
 int SettingsDialog::autosaveIntervalSeconds() const {
-    return autosaveIntervalSpin_ ? autosaveIntervalSpin_->value() : 15;
+    return autosaveIntervalSpin_ ? autosaveIntervalSpin_->value() : 3;
 }
 
 void SettingsDialog::setMultithreadingEnabled(bool enabled) {
@@ -432,6 +557,28 @@ bool SettingsDialog::isMultithreadingEnabled() const {
     return multithreadingCheckbox_ ? multithreadingCheckbox_->isChecked() : false;
 }
 
+void SettingsDialog::setBinaryTestStoreEnabled(bool enabled) {
+    if (binaryTestStoreCheckbox_) {
+        QSignalBlocker blocker(binaryTestStoreCheckbox_);
+        binaryTestStoreCheckbox_->setChecked(enabled);
+    }
+}
+
+bool SettingsDialog::isBinaryTestStoreEnabled() const {
+    return binaryTestStoreCheckbox_ ? binaryTestStoreCheckbox_->isChecked() : false;
+}
+
+void SettingsDialog::setBackgroundCompileEnabled(bool enabled) {
+    if (backgroundCompileCheckbox_) {
+        QSignalBlocker blocker(backgroundCompileCheckbox_);
+        backgroundCompileCheckbox_->setChecked(enabled);
+    }
+}
+
+bool SettingsDialog::isBackgroundCompileEnabled() const {
+    return backgroundCompileCheckbox_ ? backgroundCompileCheckbox_->isChecked() : false;
+}
+
 void SettingsDialog::onMultithreadingToggled(bool checked) {
     if (!checked || !multithreadingCheckbox_) {
         return;
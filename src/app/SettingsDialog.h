@@ -30,11 +30,19 @@ public:
     QString compilerPath() const;
     void setCompilerFlags(const QString &flags);
     QString compilerFlags() const;
+    void setDiagnosticFlags(const QString &flags);
+    QString diagnosticFlags() const;
+    void setLinker(const QString &linker);
+    QString linker() const;
+    void setPrecompiledHeaderEnabled(bool enabled);
+    bool isPrecompiledHeaderEnabled() const;
 
     void setPythonPath(const QString &path);
     QString pythonPath() const;
     void setPythonArgs(const QString &args);
     QString pythonArgs() const;
+    void setPythonForkServerEnabled(bool enabled);
+    bool isPythonForkServerEnabled() const;
 
     void setJavaCompilerPath(const QString &path);
     QString javaCompilerPath() const;
@@ -42,6 +50,8 @@ public:
     QString javaRunPath() const;
     void setJavaArgs(const QString &args);
     QString javaArgs() const;
+    void setJavaPersistentJvmEnabled(bool enabled);
+    bool isJavaPersistentJvmEnabled() const;
 
     // General settings
     void setRootDir(const QString &path);
@@ -52,6 +62,10 @@ public:
     // Experimental settings
     void setMultithreadingEnabled(bool enabled);
     bool isMultithreadingEnabled() const;
+    void setBinaryTestStoreEnabled(bool enabled);
+    bool isBinaryTestStoreEnabled() const;
+    void setBackgroundCompileEnabled(bool enabled);
+    bool isBackgroundCompileEnabled() const;
 
 signals:
     void settingsChanged();
@@ -92,14 +106,21 @@ private:
 
     QLineEdit *cppCompilerPathEdit_ = nullptr;
     QLineEdit *cppCompilerFlagsEdit_ = nullptr;
+    QLineEdit *cppDiagnosticFlagsEdit_ = nullptr;
+    QComboBox *cppLinkerCombo_ = nullptr;
+    QCheckBox *cppPrecompiledHeaderCheckbox_ = nullptr;
 
     QLineEdit *pythonPathEdit_ = nullptr;
     QLineEdit *pythonArgsEdit_ = nullptr;
+    QCheckBox *pythonForkServerCheckbox_ = nullptr;
 
     QLineEdit *javaCompilerPathEdit_ = nullptr;
     QLineEdit *javaRunPathEdit_ = nullptr;
     QLineEdit *javaArgsEdit_ = nullptr;
+    QCheckBox *javaPersistentJvmCheckbox_ = nullptr;
     
     // Experimental tab
     QCheckBox *multithreadingCheckbox_ = nullptr;
+    QCheckBox *binaryTestStoreCheckbox_ = nullptr;
+    QCheckBox *backgroundCompileCheckbox_ = nullptr;
 };
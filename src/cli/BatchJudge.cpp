@@ -0,0 +1,322 @@
+#include "cli/BatchJudge.h"
+#include "cli/CliProject.h"
+#include "cli/JudgeRunner.h"
+#include "execution/CompileCache.h"
+#include "execution/ParallelExecutor.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <QXmlStreamWriter>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace {
+
+struct Problem {
+    QString path;
+    QString name;  // path relative to the batch directory
+    CliProject project;
+    QString loadError;
+    CompileCache::Artifact artifact;
+    std::unique_ptr<QTemporaryDir> workDir;
+    std::vector<TestResult> results;
+    int passed = 0;
+
+    bool judged() const { return loadError.isEmpty() && artifact.ok; }
+    bool allPassed() const {
+        return judged() && passed == static_cast<int>(results.size());
+    }
+    qint64 testTimeMs() const {
+        qint64 total = 0;
+        for (const TestResult &result : results) {
+            total += result.executionTimeMs;
+        }
+        return total;
+    }
+    QString failure() const {
+        if (!loadError.isEmpty()) {
+            return loadError;
+        }
+        return artifact.ok ? QString() : artifact.error;
+    }
+};
+
+struct Job {
+    int problem = -1;
+    int test = -1;
+};
+
+void writeText(const std::vector<Problem> &problems, qint64 elapsedMs) {
+    QTextStream out(stdout);
+    int passedProblems = 0;
+    for (const Problem &problem : problems) {
+        if (!problem.judged()) {
+            out << "ERROR " << problem.name << ": "
+                << problem.failure().trimmed().section('\n', 0, 0) << "\n";
+            continue;
+        }
+        const bool ok = problem.allPassed();
+        passedProblems += ok ? 1 : 0;
+        out << QString("%1  %2: %3/%4 passed%5\n")
+                   .arg(ok ? "OK   " : "FAIL ")
+                   .arg(problem.name)
+                   .arg(problem.passed)
+                   .arg(problem.results.size())
+                   .arg(problem.artifact.cached ? " (cached build)" : QString());
+        if (ok) {
+            continue;
+        }
+        for (size_t i = 0; i < problem.results.size(); ++i) {
+            const QString verdict = JudgeRunner::verdict(problem.results[i]);
+            if (verdict != "AC") {
+                out << QString("       TC %1  %2\n").arg(i + 1).arg(verdict);
+            }
+        }
+    }
+    out << QString("%1/%2 problems passed in %3 s\n")
+               .arg(passedProblems)
+               .arg(problems.size())
+               .arg(static_cast<double>(elapsedMs) / 1000.0, 0, 'f', 1);
+}
+
+void writeJson(const std::vector<Problem> &problems, const QString &root, qint64 elapsedMs) {
+    QJsonArray entries;
+    int passedProblems = 0;
+    for (const Problem &problem : problems) {
+        QJsonObject entry;
+        entry["file"] = problem.name;
+        entry["compiled"] = problem.judged();
+        if (!problem.judged()) {
+            entry["error"] = problem.failure();
+            entries.append(entry);
+            continue;
+        }
+        passedProblems += problem.allPassed() ? 1 : 0;
+        entry["cachedBuild"] = problem.artifact.cached;
+        entry["compileMs"] = problem.artifact.compileMs;
+        if (!problem.artifact.cached && problem.artifact.linkMs > 0) {
+            entry["linkMs"] = problem.artifact.linkMs;
+            entry["linker"] = problem.artifact.linker.isEmpty()
+                ? QStringLiteral("default") : problem.artifact.linker;
+            entry["precompiledHeader"] = problem.artifact.precompiledHeader;
+        }
+        entry["passed"] = problem.passed;
+        entry["total"] = static_cast<int>(problem.results.size());
+        QJsonArray tests;
+        for (size_t i = 0; i < problem.results.size(); ++i) {
+            const TestResult &result = problem.results[i];
+            QJsonObject test;
+            test["index"] = static_cast<int>(i) + 1;
+            test["verdict"] = JudgeRunner::verdict(result);
+            test["timeMs"] = result.executionTimeMs;
+            test["exitCode"] = result.exitCode;
+            tests.append(test);
+        }
+        entry["tests"] = tests;
+        entries.append(entry);
+    }
+
+    QJsonObject report;
+    report["directory"] = root;
+    report["elapsedMs"] = elapsedMs;
+    report["passedProblems"] = passedProblems;
+    report["totalProblems"] = static_cast<int>(problems.size());
+    report["problems"] = entries;
+    QTextStream(stdout) << QJsonDocument(report).toJson(QJsonDocument::Indented);
+}
+
+QString seconds(qint64 ms) {
+    return QString::number(static_cast<double>(ms) / 1000.0, 'f', 3);
+}
+
+void writeJUnit(const std::vector<Problem> &problems, qint64 elapsedMs) {
+    int tests = 0;
+    int failures = 0;
+    int errors = 0;
+    for (const Problem &problem : problems) {
+        if (!problem.judged()) {
+            ++tests;
+            ++errors;
+            continue;
+        }
+        tests += static_cast<int>(problem.results.size());
+        failures += static_cast<int>(problem.results.size()) - problem.passed;
+    }
+
+    QString xml;
+    QXmlStreamWriter writer(&xml);
+    writer.setAutoFormatting(true);
+    writer.writeStartDocument();
+    writer.writeStartElement("testsuites");
+    writer.writeAttribute("name", "CF Dojo");
+    writer.writeAttribute("tests", QString::number(tests));
+    writer.writeAttribute("failures", QString::number(failures));
+    writer.writeAttribute("errors", QString::number(errors));
+    writer.writeAttribute("time", seconds(elapsedMs));
+
+    for (const Problem &problem : problems) {
+        writer.writeStartElement("testsuite");
+        writer.writeAttribute("name", problem.name);
+        if (!problem.judged()) {
+            // Load and compile errors become one errored case
+            writer.writeAttribute("tests", "1");
+            writer.writeAttribute("failures", "0");
+            writer.writeAttribute("errors", "1");
+            writer.writeStartElement("testcase");
+            writer.writeAttribute("name", "compile");
+            writer.writeAttribute("classname", problem.name);
+            writer.writeStartElement("error");
+            writer.writeAttribute("message", problem.failure().trimmed().section('\n', 0, 0));
+            writer.writeCharacters(problem.failure());
+            writer.writeEndElement();
+            writer.writeEndElement();
+            writer.writeEndElement();
+            continue;
+        }
+
+        const int total = static_cast<int>(problem.results.size());
+        writer.writeAttribute("tests", QString::number(total));
+        writer.writeAttribute("failures", QString::number(total - problem.passed));
+        writer.writeAttribute("errors", "0");
+        writer.writeAttribute("time", seconds(problem.testTimeMs()));
+        for (size_t i = 0; i < problem.results.size(); ++i) {
+            const TestResult &result = problem.results[i];
+            const QString verdict = JudgeRunner::verdict(result);
+            writer.writeStartElement("testcase");
+            writer.writeAttribute("name", QString("TC %1").arg(i + 1));
+            writer.writeAttribute("classname", problem.name);
+            writer.writeAttribute("time", seconds(result.executionTimeMs));
+            if (verdict != "AC") {
+                writer.writeStartElement("failure");
+                writer.writeAttribute("type", verdict);
+                writer.writeAttribute("message", verdict == "RE"
+                    ? QString("exit code %1").arg(result.exitCode)
+                    : verdict);
+                if (!result.error.isEmpty()) {
+                    writer.writeCharacters(QString::fromUtf8(result.error));
+                }
+                writer.writeEndElement();
+            }
+            writer.writeEndElement();
+        }
+        writer.writeEndElement();
+    }
+
+    writer.writeEndElement();
+    writer.writeEndDocument();
+    QTextStream(stdout) << xml;
+}
+
+} // namespace
+
+namespace BatchJudge {
+
+int run(const Options &options) {
+    QElapsedTimer clock;
+    clock.start();
+
+    const QDir root(options.directory);
+    if (!root.exists()) {
+        QTextStream(stderr) << options.directory << ": no such directory\n";
+        return 2;
+    }
+    QStringList paths;
+    QDirIterator it(root.path(), {"*.cpack"}, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        paths << it.next();
+    }
+    if (paths.isEmpty()) {
+        QTextStream(stderr) << options.directory << ": no .cpack files found\n";
+        return 2;
+    }
+    paths.sort();
+
+    const int jobs = options.jobs > 0 ? options.jobs : QThread::idealThreadCount();
+    QThreadPool pool;
+    pool.setMaxThreadCount(jobs);
+    CompileCache cache;
+
+    // Load and compile every problem
+    std::vector<Problem> problems(static_cast<size_t>(paths.size()));
+    QVector<int> indices;
+    for (int i = 0; i < paths.size(); ++i) {
+        problems[static_cast<size_t>(i)].path = paths.at(i);
+        problems[static_cast<size_t>(i)].name = root.relativeFilePath(paths.at(i));
+        indices.push_back(i);
+    }
+    QtConcurrent::blockingMap(&pool, indices, [&problems, &cache](int index) {
+        Problem &problem = problems[static_cast<size_t>(index)];
+        if (!CliProject::load(problem.path, QString(), problem.project, problem.loadError)) {
+            return;
+        }
+        problem.artifact = cache.get(problem.project.solution, problem.project.config);
+        if (!problem.artifact.ok) {
+            return;
+        }
+        // Tests write next to themselves, never into the shared cache entry
+        problem.workDir = std::make_unique<QTemporaryDir>();
+        if (!problem.workDir->isValid()) {
+            problem.loadError = "Failed to create temporary directory";
+            return;
+        }
+        problem.results.assign(problem.project.tests.size(), TestResult{});
+    });
+
+    // One queue for the tests of all problems
+    QVector<Job> queue;
+    for (size_t p = 0; p < problems.size(); ++p) {
+        if (!problems[p].judged()) {
+            continue;
+        }
+        for (size_t t = 0; t < problems[p].results.size(); ++t) {
+            queue.push_back({static_cast<int>(p), static_cast<int>(t)});
+        }
+    }
+    QtConcurrent::blockingMap(&pool, queue, [&problems](const Job &job) {
+        Problem &problem = problems[static_cast<size_t>(job.problem)];
+        const TestCase &test = problem.project.tests[static_cast<size_t>(job.test)];
+        TestInput input;
+        input.testIndex = job.test;
+        input.input = test.input.toUtf8();
+        input.expectedOutput = test.expectedOutput.toUtf8();
+        problem.results[static_cast<size_t>(job.test)] = ParallelExecutor::runSingleTest(
+            input, problem.artifact.program, problem.artifact.args,
+            problem.workDir->path(), problem.project.timeoutSec * 1000);
+    });
+
+    bool allPassed = true;
+    for (Problem &problem : problems) {
+        problem.passed = static_cast<int>(std::count_if(
+            problem.results.begin(), problem.results.end(),
+            [](const TestResult &result) { return JudgeRunner::verdict(result) == "AC"; }));
+        allPassed = allPassed && problem.allPassed();
+    }
+
+    const qint64 elapsedMs = clock.elapsed();
+    switch (options.format) {
+    case Format::Json:
+        writeJson(problems, root.absolutePath(), elapsedMs);
+        break;
+    case Format::JUnit:
+        writeJUnit(problems, elapsedMs);
+        break;
+    case Format::Text:
+        writeText(problems, elapsedMs);
+        break;
+    }
+    return allPassed ? 0 : 1;
+}
+
+} // namespace BatchJudge
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <QString>
+
+// Headless `--batch`: judges every .cpack under a directory. Solutions are
+// compiled in parallel through the shared CompileCache, then the tests of
+// all problems go through one job queue, so a problem with many tests does
+// not hold back the rest. Prints a text summary, JSON or JUnit XML.
+// Exit codes: 0 all passed, 1 some problem failed, 2 nothing to judge.
+namespace BatchJudge {
+
+enum class Format { Text, Json, JUnit };
+
+struct Options {
+    QString directory;
+    int jobs = 0;  // 0: one per core
+    Format format = Format::Text;
+};
+
+int run(const Options &options);
+
+} // namespace BatchJudge
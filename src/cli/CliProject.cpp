@@ -0,0 +1,60 @@
+#include "cli/CliProject.h"
+#include "execution/CompilationSettings.h"
+#include "file/CpackFileHandler.h"
+#include "file/TestStore.h"
+
+#include <QFile>
+#include <QFileInfo>
+
+bool CliProject::load(const QString &path,
+                      const QString &solutionPath,
+                      CliProject &project,
+                      QString &error) {
+    CpackFileHandler handler;
+    if (!handler.load(path, TestStore::kPrefix)) {
+        error = QString("Failed to load %1: %2").arg(path, handler.errorString());
+        return false;
+    }
+    if (!handler.hasFile("solution.cpp")) {
+        error = QString("%1: unsupported CPack format").arg(path);
+        return false;
+    }
+
+    project = CliProject();
+    project.path = path;
+    project.config = CompilationSettings::load();
+    project.solution = QString::fromUtf8(handler.getFile("solution.cpp"));
+    project.brute = QString::fromUtf8(handler.getFile("brute.cpp"));
+    project.generator = QString::fromUtf8(handler.getFile("generator.cpp"));
+
+    if (!solutionPath.isEmpty()) {
+        QFile file(solutionPath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            error = QString("Failed to read %1: %2").arg(solutionPath, file.errorString());
+            return false;
+        }
+        project.solution = QString::fromUtf8(file.readAll());
+
+        const QString suffix = QFileInfo(solutionPath).suffix().toLower();
+        if (suffix == "py") {
+            project.config.language = "Python";
+        } else if (suffix == "java") {
+            project.config.language = "Java";
+        } else if (suffix == "cpp" || suffix == "cc" || suffix == "cxx") {
+            project.config.language = "C++";
+        }
+    }
+
+    if (handler.hasFile("template.cpp")) {
+        project.config.templateCode = QString::fromUtf8(handler.getFile("template.cpp"));
+    } else {
+        project.config.templateCode = CompilationSettings::defaultTemplate(project.config.language);
+    }
+
+    QString testsError;
+    if (!TestStore::readTests(handler, project.tests, project.timeoutSec, &testsError)) {
+        error = QString("Failed to load %1: %2").arg(path, testsError);
+        return false;
+    }
+    return true;
+}
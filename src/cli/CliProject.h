@@ -0,0 +1,26 @@
+#pragma once
+
+#include "execution/CompilationConfig.h"
+#include "file/ProjectSnapshot.h"
+
+#include <QString>
+#include <vector>
+
+// What the command-line modes need from a .cpack, loaded without any widgets
+struct CliProject {
+    QString path;
+    QString solution;
+    QString brute;
+    QString generator;
+    std::vector<TestCase> tests;
+    int timeoutSec = 5;
+    // Compiler settings saved by the GUI, with the archive's template
+    CompilationConfig config;
+
+    // Load `path`. A non-empty solutionPath replaces solution.cpp; its
+    // extension (.py, .java) also picks the language.
+    static bool load(const QString &path,
+                     const QString &solutionPath,
+                     CliProject &project,
+                     QString &error);
+};
@@ -0,0 +1,147 @@
+#include "cli/CommandLine.h"
+#include "cli/BatchJudge.h"
+#include "cli/JudgeRunner.h"
+#include "cli/StressRunner.h"
+#include "execution/Trace.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QTextStream>
+#include <QTimer>
+
+#include <cstring>
+
+namespace {
+
+constexpr const char *kHeadlessFlags[] = {"--judge", "--stress", "--batch"};
+
+int exitWithUsage(const QCommandLineParser &parser, const QString &error) {
+    QTextStream(stderr) << error << "\n\n" << parser.helpText();
+    return 2;
+}
+
+} // namespace
+
+namespace CommandLine {
+
+bool isHeadless(int argc, char *argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        for (const char *flag : kHeadlessFlags) {
+            if (std::strcmp(argv[i], flag) == 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+int run() {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("CF Dojo headless judge, batch judge and stress tester");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    const QCommandLineOption judgeOption(
+        "judge", "Compile the solution of <cpack> and run all of its tests.", "cpack");
+    const QCommandLineOption stressOption(
+        "stress", "Stress test the solution of <cpack> against its brute force.", "cpack");
+    const QCommandLineOption batchOption(
+        "batch", "Judge every .cpack under <dir>.", "dir");
+    const QCommandLineOption solutionOption(
+        "solution", "Use <file> instead of the archive's solution.cpp.", "file");
+    const QCommandLineOption countOption(
+        "count", "Stress test rounds to run (default: 100).", "n");
+    const QCommandLineOption secondsOption(
+        "seconds", "Stress test for <s> seconds instead of a fixed count.", "s");
+    const QCommandLineOption jobsOption(
+        "jobs", "Run at most <n> tests at once (default: one per core).", "n");
+    const QCommandLineOption jsonOption("json", "Print the report as JSON.");
+    const QCommandLineOption junitOption("junit", "Print the batch report as JUnit XML.");
+    const QCommandLineOption traceOption(
+        "trace", "Record a Chrome trace of the run and write it to <file>.", "file");
+    parser.addOptions({judgeOption, stressOption, batchOption, solutionOption, countOption,
+                       secondsOption, jobsOption, jsonOption, junitOption, traceOption});
+    parser.process(*QCoreApplication::instance());
+
+    // Positive integer option; 0 when not given, -1 when invalid
+    auto positiveValue = [&parser](const QCommandLineOption &option) {
+        if (!parser.isSet(option)) {
+            return 0;
+        }
+        bool ok = false;
+        const int value = parser.value(option).toInt(&ok);
+        return ok && value > 0 ? value : -1;
+    };
+    const int jobs = positiveValue(jobsOption);
+    const int count = positiveValue(countOption);
+    const int seconds = positiveValue(secondsOption);
+    if (jobs < 0) {
+        return exitWithUsage(parser, "--jobs expects a positive number");
+    }
+    if (count < 0 || seconds < 0) {
+        return exitWithUsage(parser, "--count and --seconds expect a positive number");
+    }
+
+    const int modes = (parser.isSet(judgeOption) ? 1 : 0) +
+                      (parser.isSet(stressOption) ? 1 : 0) +
+                      (parser.isSet(batchOption) ? 1 : 0);
+    if (modes != 1) {
+        return exitWithUsage(parser, "Pass exactly one of --judge, --stress and --batch");
+    }
+    if (parser.isSet(batchOption) && parser.isSet(jsonOption) && parser.isSet(junitOption)) {
+        return exitWithUsage(parser, "Pass either --json or --junit, not both");
+    }
+    if (parser.isSet(stressOption) && count > 0 && seconds > 0) {
+        return exitWithUsage(parser, "Pass either --count or --seconds, not both");
+    }
+
+    auto runMode = [&]() {
+        if (parser.isSet(batchOption)) {
+            BatchJudge::Options options;
+            options.directory = parser.value(batchOption);
+            options.jobs = jobs;
+            options.format = parser.isSet(jsonOption)  ? BatchJudge::Format::Json
+                           : parser.isSet(junitOption) ? BatchJudge::Format::JUnit
+                                                       : BatchJudge::Format::Text;
+            return BatchJudge::run(options);
+        }
+
+        if (parser.isSet(stressOption)) {
+            StressRunner::Options options;
+            options.cpackPath = parser.value(stressOption);
+            options.solutionPath = parser.value(solutionOption);
+            if (count > 0) {
+                options.count = count;
+            }
+            options.seconds = seconds;
+            options.jobs = jobs;
+            return StressRunner::run(options);
+        }
+
+        JudgeRunner::Options options;
+        options.cpackPath = parser.value(judgeOption);
+        options.solutionPath = parser.value(solutionOption);
+        options.jobs = jobs;
+        options.json = parser.isSet(jsonOption);
+
+        JudgeRunner runner(options);
+        QObject::connect(&runner, &JudgeRunner::finished,
+                         QCoreApplication::instance(), &QCoreApplication::exit);
+        QTimer::singleShot(0, &runner, &JudgeRunner::start);
+        return QCoreApplication::exec();
+    };
+
+    const QString tracePath = parser.value(traceOption);
+    Trace::setEnabled(!tracePath.isEmpty());
+    const int status = runMode();
+    if (!tracePath.isEmpty()) {
+        Trace::setEnabled(false);
+        QString error;
+        if (!Trace::save(tracePath, &error)) {
+            QTextStream(stderr) << tracePath << ": " << error << "\n";
+        }
+    }
+    return status;
+}
+
+} // namespace CommandLine
@@ -0,0 +1,14 @@
+#pragma once
+
+// Headless entry points (`--judge`, ...). These run on a QCoreApplication
+// and never construct a widget, so they work without a display.
+namespace CommandLine {
+
+// True when argv asks for a headless mode; checked before any
+// application object exists to pick QCoreApplication over QApplication
+bool isHeadless(int argc, char *argv[]);
+
+// Parses the application's arguments and runs the requested mode
+int run();
+
+} // namespace CommandLine
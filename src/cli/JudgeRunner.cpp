@@ -0,0 +1,164 @@
+#include "cli/JudgeRunner.h"
+#include "execution/CompilationUtils.h"
+#include "execution/DiffEngine.h"
+
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <QThreadPool>
+
+namespace {
+
+void printJson(const QJsonObject &report) {
+    QTextStream(stdout) << QJsonDocument(report).toJson(QJsonDocument::Indented);
+}
+
+} // namespace
+
+QString JudgeRunner::verdict(const TestResult &result) {
+    return CompilationUtils::verdict(result.error.contains("Time Limit Exceeded"),
+                                     result.exitCode, result.passed);
+}
+
+JudgeRunner::JudgeRunner(const Options &options, QObject *parent)
+    : QObject(parent),
+      options_(options),
+      executor_(new ParallelExecutor(this)) {
+    connect(executor_, &ParallelExecutor::compilationFinished,
+            this, &JudgeRunner::onCompilationFinished);
+    connect(executor_, &ParallelExecutor::allTestsFinished,
+            this, &JudgeRunner::onAllTestsFinished);
+}
+
+void JudgeRunner::start() {
+    QString error;
+    if (!CliProject::load(options_.cpackPath, options_.solutionPath, project_, error)) {
+        fail(error);
+        return;
+    }
+    if (project_.tests.empty()) {
+        fail(QString("%1 has no test cases").arg(options_.cpackPath));
+        return;
+    }
+    // ParallelExecutor runs tests on the global pool
+    if (options_.jobs > 0) {
+        QThreadPool::globalInstance()->setMaxThreadCount(options_.jobs);
+    }
+
+    std::vector<TestInput> inputs;
+    inputs.reserve(project_.tests.size());
+    for (size_t i = 0; i < project_.tests.size(); ++i) {
+        TestInput input;
+        input.testIndex = static_cast<int>(i);
+        input.input = project_.tests[i].input.toUtf8();
+        input.expectedOutput = project_.tests[i].expectedOutput.toUtf8();
+        inputs.push_back(input);
+    }
+
+    executor_->setConfig(project_.config);
+    executor_->setSourceCode(project_.solution);
+    executor_->setTimeout(project_.timeoutSec * 1000);
+    timer_.start();
+    executor_->runAll(inputs);
+}
+
+void JudgeRunner::onCompilationFinished(bool success, const QString &error) {
+    compileMs_ = timer_.elapsed();
+    if (!success) {
+        fail(error.trimmed().isEmpty() ? QStringLiteral("Compilation failed") : error);
+    }
+}
+
+void JudgeRunner::onAllTestsFinished(const std::vector<TestResult> &results) {
+    DiffEngine::Options diffOptions;
+    diffOptions.maxDifferences = 1;
+
+    int passed = 0;
+    QJsonArray tests;
+    QString lines;
+    QTextStream text(&lines);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const TestResult &result = results[i];
+        const QString verdict = JudgeRunner::verdict(result);
+        if (verdict == "AC") {
+            ++passed;
+        }
+
+        QJsonObject test;
+        test["index"] = static_cast<int>(i) + 1;
+        test["verdict"] = verdict;
+        test["timeMs"] = result.executionTimeMs;
+        test["exitCode"] = result.exitCode;
+        QString detail;
+        if (verdict == "WA" && i < project_.tests.size()) {
+            const DiffEngine::Result diff = DiffEngine::compare(
+                DiffEngine::splitLines(project_.tests[i].expectedOutput),
+                DiffEngine::splitLines(QString::fromUtf8(result.output)),
+                diffOptions);
+            if (diff.firstMismatchLine >= 0) {
+                QJsonObject mismatch;
+                mismatch["line"] = diff.firstMismatchLine + 1;
+                mismatch["column"] = diff.firstMismatchColumn + 1;
+                test["firstMismatch"] = mismatch;
+                detail = QString("first mismatch at line %1, column %2")
+                    .arg(diff.firstMismatchLine + 1)
+                    .arg(diff.firstMismatchColumn + 1);
+            }
+        } else if (verdict == "RE") {
+            detail = QString("exit code %1").arg(result.exitCode);
+        }
+        if (!result.sanitizerReport.isEmpty()) {
+            test["sanitizerReport"] = result.sanitizerReport;
+        }
+        tests.append(test);
+
+        text << QString("  TC %1  %2 %3 ms")
+                    .arg(i + 1)
+                    .arg(verdict, -4)
+                    .arg(result.executionTimeMs, 5);
+        if (!detail.isEmpty()) {
+            text << "  " << detail;
+        }
+        text << "\n";
+        if (!result.sanitizerReport.isEmpty()) {
+            text << "    " << QString(result.sanitizerReport).replace("\n", "\n    ") << "\n";
+        }
+    }
+
+    const int total = static_cast<int>(results.size());
+    if (options_.json) {
+        QJsonObject report;
+        report["file"] = options_.cpackPath;
+        report["language"] = project_.config.language;
+        report["compiled"] = true;
+        report["compileMs"] = compileMs_;
+        report["passed"] = passed;
+        report["total"] = total;
+        report["tests"] = tests;
+        printJson(report);
+    } else {
+        QTextStream out(stdout);
+        out << QString("%1: %2/%3 passed (compile %4 ms)\n")
+                   .arg(QFileInfo(options_.cpackPath).fileName())
+                   .arg(passed)
+                   .arg(total)
+                   .arg(compileMs_)
+            << lines;
+    }
+    emit finished(passed == total ? 0 : 1);
+}
+
+void JudgeRunner::fail(const QString &error) {
+    if (options_.json) {
+        QJsonObject report;
+        report["file"] = options_.cpackPath;
+        report["compiled"] = false;
+        report["error"] = error;
+        printJson(report);
+    } else {
+        QTextStream(stderr) << error << (error.endsWith('\n') ? "" : "\n");
+    }
+    emit finished(2);
+}
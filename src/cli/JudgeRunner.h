@@ -0,0 +1,46 @@
+#pragma once
+
+#include "cli/CliProject.h"
+#include "execution/ParallelExecutor.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QString>
+#include <vector>
+
+// Headless `--judge`: compiles a project's solution and runs all of its
+// tests through ParallelExecutor, then prints a text or JSON report.
+// Exit codes: 0 all passed, 1 some test failed, 2 load/compile error.
+class JudgeRunner : public QObject {
+    Q_OBJECT
+
+public:
+    struct Options {
+        QString cpackPath;
+        QString solutionPath;  // empty: solution.cpp from the archive
+        int jobs = 0;          // 0: one per core
+        bool json = false;
+    };
+
+    explicit JudgeRunner(const Options &options, QObject *parent = nullptr);
+
+    // Starts judging; finished() is emitted once the report is printed
+    void start();
+
+    // AC, WA, TLE or RE, as the GUI judges it (CompilationUtils::verdict)
+    static QString verdict(const TestResult &result);
+
+signals:
+    void finished(int exitCode);
+
+private:
+    void onCompilationFinished(bool success, const QString &error);
+    void onAllTestsFinished(const std::vector<TestResult> &results);
+    void fail(const QString &error);
+
+    Options options_;
+    CliProject project_;
+    ParallelExecutor *executor_ = nullptr;
+    QElapsedTimer timer_;
+    qint64 compileMs_ = 0;
+};
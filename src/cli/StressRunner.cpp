@@ -0,0 +1,100 @@
+#include "cli/StressRunner.h"
+#include "cli/CliProject.h"
+#include "execution/StressEngine.h"
+
+#include <QFileInfo>
+#include <QTextStream>
+#include <QThread>
+
+namespace {
+// Progress lines on stderr are at least this far apart
+constexpr qint64 kProgressIntervalMs = 5000;
+
+double ratePerSecond(int rounds, qint64 elapsedMs) {
+    return elapsedMs > 0 ? rounds * 1000.0 / static_cast<double>(elapsedMs) : 0.0;
+}
+} // namespace
+
+namespace StressRunner {
+
+int run(const Options &options) {
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    CliProject project;
+    QString error;
+    if (!CliProject::load(options.cpackPath, options.solutionPath, project, error)) {
+        err << error << "\n";
+        return 2;
+    }
+    if (project.brute.trimmed().isEmpty() || project.generator.trimmed().isEmpty()) {
+        err << options.cpackPath << " needs brute.cpp and generator.cpp for stress testing\n";
+        return 2;
+    }
+
+    StressEngine::Config config;
+    config.solution = project.solution;
+    config.brute = project.brute;
+    config.generator = project.generator;
+    config.compilation = project.config;
+    config.timeoutMs = project.timeoutSec * 1000;
+    config.count = options.count;
+    config.durationMs = static_cast<qint64>(options.seconds) * 1000;
+    config.jobs = options.jobs > 0 ? options.jobs : QThread::idealThreadCount();
+    qint64 lastProgressMs = 0;
+    config.onProgress = [&err, &lastProgressMs](int rounds, qint64 elapsedMs) {
+        if (elapsedMs - lastProgressMs < kProgressIntervalMs) {
+            return;
+        }
+        lastProgressMs = elapsedMs;
+        err << QString("  %L1 rounds, %2 rounds/s\n")
+                   .arg(rounds)
+                   .arg(ratePerSecond(rounds, elapsedMs), 0, 'f', 1);
+        err.flush();
+    };
+
+    StressEngine engine(config);
+    const StressEngine::Result result = engine.run();
+    const QString name = QFileInfo(options.cpackPath).fileName();
+    const double seconds = static_cast<double>(result.elapsedMs) / 1000.0;
+
+    if (result.status == StressEngine::Result::Status::Error) {
+        err << name << ": " << result.error << "\n";
+        if (!result.stderrOutput.isEmpty()) {
+            err << "\nStderr:\n" << result.stderrOutput << "\n";
+        }
+        return 2;
+    }
+
+    if (result.passed()) {
+        out << QString("%1: %L2 rounds passed in %3 s (%4 rounds/s, %5 jobs)\n")
+                   .arg(name)
+                   .arg(result.totalCount)
+                   .arg(seconds, 0, 'f', 1)
+                   .arg(ratePerSecond(result.totalCount, result.elapsedMs), 0, 'f', 1)
+                   .arg(config.jobs);
+        out << result.complexity << "\n";
+        return 0;
+    }
+
+    if (result.status == StressEngine::Result::Status::WrongAnswer) {
+        out << QString("%1: mismatch at test #%2 after %3 s\n")
+                   .arg(name)
+                   .arg(result.failedIndex + 1)
+                   .arg(seconds, 0, 'f', 1);
+    } else {
+        out << name << ": " << result.error << "\n";
+    }
+    out << "\nInput:\n" << result.input;
+    if (result.status == StressEngine::Result::Status::WrongAnswer) {
+        out << "\n\nBrute output:\n" << result.expected
+            << "\n\nSolution output:\n" << result.actual;
+    }
+    if (!result.stderrOutput.isEmpty()) {
+        out << "\n\nStderr:\n" << result.stderrOutput;
+    }
+    out << "\n";
+    return 1;
+}
+
+} // namespace StressRunner
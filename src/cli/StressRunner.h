@@ -0,0 +1,20 @@
+#pragma once
+
+#include <QString>
+
+// Headless `--stress`: runs StressEngine on a project's generator, brute
+// and solution and prints throughput, or the failing round.
+// Exit codes: 0 no mismatch, 1 mismatch or solution failure, 2 other errors.
+namespace StressRunner {
+
+struct Options {
+    QString cpackPath;
+    QString solutionPath;  // empty: solution.cpp from the archive
+    int count = 100;
+    int seconds = 0;       // > 0: run for this long instead of `count` rounds
+    int jobs = 0;          // 0: one per core
+};
+
+int run(const Options &options);
+
+} // namespace StressRunner
@@ -11,11 +11,17 @@ struct CompilationConfig {
     QString language = "C++";
     QString cppCompilerPath = "g++";
     QString cppCompilerFlags = "-O2 -std=c++17";
+    QString cppDiagnosticFlags;  // sanitizer build for failed tests; empty: off
+    // Build speed only, so not part of the compile cache key
+    QString cppLinker = "auto";        // "auto", "default", or a -fuse-ld value
+    bool cppPrecompiledHeader = true;  // GCC: reuse a compiled <bits/stdc++.h>
     QString pythonPath = "python3";
     QString pythonArgs;
     QString javaCompilerPath = "javac";
     QString javaRunPath = "java";
     QString javaArgs;
+    bool javaPersistentJvm = false;  // run Java tests in a warm JVM (JvmRunner)
+    bool pythonForkServer = false;   // fork Python tests from a server (PythonRunner)
     bool transcludeTemplate = false;
     QString templateCode{CompilationUtils::kDefaultTemplateCode};
 };
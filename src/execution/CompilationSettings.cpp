@@ -0,0 +1,36 @@
+#include "execution/CompilationSettings.h"
+
+#include <QSettings>
+
+namespace CompilationSettings {
+
+CompilationConfig load() {
+    QSettings settings("CF Dojo", "CF Dojo");
+    CompilationConfig config;
+    config.language = CompilationUtils::normalizeLanguage(
+        settings.value("defaultLanguage", "C++").toString());
+    config.cppCompilerPath = settings.value("cppCompilerPath", "g++").toString();
+    config.cppCompilerFlags = settings.value("cppCompilerFlags", "-O2 -std=c++17").toString();
+    config.cppDiagnosticFlags = settings.value("cppDiagnosticFlags", "").toString();
+    config.cppLinker = settings.value("cppLinker", "auto").toString();
+    config.cppPrecompiledHeader = settings.value("cppPrecompiledHeader", true).toBool();
+    config.pythonPath = settings.value("pythonPath", "python3").toString();
+    config.pythonArgs = settings.value("pythonArgs", "").toString();
+    config.pythonForkServer = settings.value("pythonForkServer", false).toBool();
+    config.javaCompilerPath = settings.value("javaCompilerPath", "javac").toString();
+    config.javaRunPath = settings.value("javaRunPath", "java").toString();
+    config.javaArgs = settings.value("javaArgs", "").toString();
+    config.javaPersistentJvm = settings.value("javaPersistentJvm", false).toBool();
+    config.transcludeTemplate = settings.value("transcludeTemplate", false).toBool();
+    config.templateCode = defaultTemplate(config.language);
+    return config;
+}
+
+QString defaultTemplate(const QString &language) {
+    QSettings settings("CF Dojo", "CF Dojo");
+    const QString key = QStringLiteral("defaultTemplate/%1").arg(language);
+    const QString stored = settings.value(key).toString();
+    return stored.isEmpty() ? QString{CompilationUtils::kDefaultTemplateCode} : stored;
+}
+
+} // namespace CompilationSettings
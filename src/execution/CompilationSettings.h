@@ -0,0 +1,17 @@
+#pragma once
+
+#include "execution/CompilationConfig.h"
+
+#include <QString>
+
+// Compiler and language settings as saved by the settings dialog
+// (QSettings "CF Dojo"). Shared by the GUI and the headless modes.
+namespace CompilationSettings {
+
+// Everything except the template comes from the saved settings; the
+// template is the saved default for the default language.
+CompilationConfig load();
+
+QString defaultTemplate(const QString &language);
+
+} // namespace CompilationSettings
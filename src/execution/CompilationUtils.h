@@ -1,11 +1,15 @@
 #pragma once
 
+#include <QByteArray>
+#include <QByteArrayView>
 #include <QProcess>
 #include <QRegularExpression>
 #include <QString>
 #include <QStringList>
 
+#include <algorithm>
 #include <array>
+#include <vector>
 
 namespace CompilationUtils {
 
@@ -68,12 +72,33 @@ inline QString applyTransclusion(const QString &templateCode,
     return solution;
 }
 
+// The sanitizer output in a diagnostic run's stderr: everything from the
+// first AddressSanitizer/UBSan/... report on, or empty when there is none
+inline QString sanitizerReport(const QString &errorOutput) {
+    static const QRegularExpression reportStart(
+        "^(==\\d+==(ERROR|WARNING): \\w+Sanitizer|.*: runtime error: )",
+        QRegularExpression::MultilineOption);
+    const QRegularExpressionMatch match = reportStart.match(errorOutput);
+    if (!match.hasMatch()) {
+        return {};
+    }
+    return errorOutput.mid(match.capturedStart()).trimmed();
+}
+
+// A blank line for judging holds only ASCII whitespace; U+00A0, U+3000
+// and friends are output like any other character
+inline bool isJudgedSpace(char32_t c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
 inline QString normalizeText(const QString &text) {
     QString normalized = text;
     normalized.replace("\r\n", "\n");
     normalized.replace("\r", "\n");
     QStringList lines = normalized.split('\n');
-    while (!lines.isEmpty() && lines.last().trimmed().isEmpty()) {
+    while (!lines.isEmpty() &&
+           std::all_of(lines.last().cbegin(), lines.last().cend(),
+                       [](QChar c) { return isJudgedSpace(c.unicode()); })) {
         lines.removeLast();
     }
     for (QString &line : lines) {
@@ -84,4 +109,56 @@ inline QString normalizeText(const QString &text) {
     return lines.join('\n');
 }
 
+// The lines normalizeText() keeps, as views into `text`: split at \n, \r\n
+// or \r, trailing blank lines (isJudgedSpace) dropped, trailing spaces and
+// tabs cut
+inline std::vector<QByteArrayView> judgedLines(QByteArrayView text) {
+    std::vector<QByteArrayView> lines;
+    qsizetype start = 0;
+    for (qsizetype i = 0; i <= text.size(); ++i) {
+        if (i < text.size() && text[i] != '\n' && text[i] != '\r') {
+            continue;
+        }
+        lines.push_back(text.sliced(start, i - start));
+        if (i + 1 < text.size() && text[i] == '\r' && text[i + 1] == '\n') {
+            ++i;
+        }
+        start = i + 1;
+    }
+    while (!lines.empty()) {
+        const QByteArrayView last = lines.back();
+        if (!std::all_of(last.begin(), last.end(),
+                         [](char c) { return isJudgedSpace(static_cast<unsigned char>(c)); })) {
+            break;
+        }
+        lines.pop_back();
+    }
+    for (QByteArrayView &line : lines) {
+        while (!line.isEmpty() && (line.back() == ' ' || line.back() == '\t')) {
+            line.chop(1);
+        }
+    }
+    return lines;
+}
+
+// normalizeText(a) == normalizeText(b) on UTF-8 output, without decoding
+// or copying it. Invalid UTF-8 is compared byte for byte, where decoding
+// would have turned different bytes into the same U+FFFD.
+inline bool sameOutput(QByteArrayView actual, QByteArrayView expected) {
+    return judgedLines(actual) == judgedLines(expected);
+}
+
+// Verdict of a finished test, the same in Run All, Run and --judge: "TLE",
+// "RE" for a non-zero exit or a crash (output on stderr alone is not an
+// error), then "AC" or "WA" by the judged output
+inline QString verdict(bool timedOut, int exitCode, bool passed) {
+    if (timedOut) {
+        return QStringLiteral("TLE");
+    }
+    if (exitCode != 0) {
+        return QStringLiteral("RE");
+    }
+    return passed ? QStringLiteral("AC") : QStringLiteral("WA");
+}
+
 } // namespace CompilationUtils
@@ -0,0 +1,622 @@
+#include "execution/CompileCache.h"
+#include "execution/CompilationUtils.h"
+#include "execution/Trace.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QProcess>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
+namespace {
+constexpr const char *kReadyFile = "ready";
+constexpr int kCancelPollMs = 50;
+constexpr qint64 kDefaultMaxBytes = 512LL * 1024 * 1024;
+// Another process may be running an entry it loaded this long ago; it has
+// no lease here, so only its last use protects it
+constexpr qint64 kEvictGraceMs = 10 * 60 * 1000;
+
+constexpr const char *kPrecompiledHeader = "bits/stdc++.h.gch";
+
+#ifdef Q_OS_WIN
+constexpr const char *kExecutableName = "solution.exe";
+constexpr const char *kObjectName = "solution.obj";
+#else
+constexpr const char *kExecutableName = "solution";
+constexpr const char *kObjectName = "solution.o";
+#endif
+
+QString trimmedOr(const QString &value, const QString &fallback) {
+    const QString trimmed = value.trimmed();
+    return trimmed.isEmpty() ? fallback : trimmed;
+}
+
+// Everything but the ready marker, which eviction removes first
+void makeReadOnly(const QString &dir) {
+    const QFile::Permissions read =
+        QFile::ReadOwner | QFile::ReadUser | QFile::ReadGroup | QFile::ReadOther;
+    const QFile::Permissions exec =
+        QFile::ExeOwner | QFile::ExeUser | QFile::ExeGroup | QFile::ExeOther;
+    QDirIterator it(dir, QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QString path = it.next();
+        QFile::setPermissions(path, QFileInfo(path).isExecutable() ? read | exec : read);
+    }
+}
+
+qint64 directorySize(const QString &dir) {
+    qint64 bytes = 0;
+    QDirIterator it(dir, QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        bytes += it.fileInfo().size();
+    }
+    return bytes;
+}
+
+// Runs one compiler invocation to completion, polling so a cancelled build
+// stops within kCancelPollMs; false with `error` set when it fails
+// Fills result.error, .cancelled and .transient on failure
+bool runCompiler(const QString &program,
+                 const QStringList &args,
+                 const QString &workDir,
+                 const CompileCache::BuildOptions &options,
+                 CompileCache::Artifact &result) {
+    result.cancelled = false;
+    result.transient = false;
+    QElapsedTimer timer;
+    timer.start();
+    QProcess compiler;
+    compiler.setWorkingDirectory(workDir);
+#ifdef Q_OS_UNIX
+    if (options.lowPriority) {
+        compiler.setChildProcessModifier([]() { ::setpriority(PRIO_PROCESS, 0, 10); });
+    }
+#endif
+    compiler.start(program, args);
+    while (!compiler.waitForFinished(kCancelPollMs)) {
+        const bool stop = options.cancelled && options.cancelled->load();
+        if (compiler.state() == QProcess::NotRunning) {
+            result.error = compiler.errorString();
+            result.transient = true;
+            return false;
+        }
+        if (stop || timer.elapsed() >= options.timeoutMs) {
+            compiler.kill();
+            compiler.waitForFinished(1000);
+            result.cancelled = stop;
+            result.transient = !stop;
+            result.error = stop ? "Cancelled" : "Compilation timed out";
+            return false;
+        }
+    }
+    if (compiler.exitStatus() != QProcess::NormalExit || compiler.exitCode() != 0) {
+        result.error = QString::fromUtf8(compiler.readAllStandardError());
+        if (result.error.trimmed().isEmpty()) {
+            result.error = "Compilation failed";
+        }
+        // Killed from outside (OOM, a signal) says nothing about the code
+        result.transient = compiler.exitStatus() != QProcess::NormalExit;
+        return false;
+    }
+    return true;
+}
+
+struct Toolchain {
+    bool clang = false;
+    QByteArray version;  // `--version` output, so upgrades invalidate the PCH
+};
+
+// Asks each C++ compiler once per session
+const Toolchain &toolchain(const QString &compiler) {
+    static QMutex mutex;
+    static std::map<QString, Toolchain> known;
+    QMutexLocker lock(&mutex);
+    auto it = known.find(compiler);
+    if (it == known.end()) {
+        Toolchain tools;
+        QProcess process;
+        process.start(compiler, {"--version"});
+        if (process.waitForFinished(5000)) {
+            tools.version = process.readAllStandardOutput();
+        }
+        tools.clang = tools.version.contains("clang");
+        it = known.emplace(compiler, tools).first;
+    }
+    return it->second;
+}
+
+QMutex brokenLinkersMutex;
+std::set<QString> brokenLinkers;  // "<compiler>\n<linker>" the driver rejected
+
+bool isBrokenLinker(const QString &compiler, const QString &linker) {
+    QMutexLocker lock(&brokenLinkersMutex);
+    return brokenLinkers.count(compiler + '\n' + linker) > 0;
+}
+
+void markBrokenLinker(const QString &compiler, const QString &linker) {
+    QMutexLocker lock(&brokenLinkersMutex);
+    brokenLinkers.insert(compiler + '\n' + linker);
+}
+
+// The -fuse-ld value to link with, or empty for the driver's default (bfd
+// for GCC on Linux, which is the slowest of them)
+QString chooseLinker(const CompilationConfig &config,
+                     const QString &compiler,
+                     const Toolchain &tools) {
+    const QString choice = config.cppLinker.trimmed().toLower();
+    if (choice == "default" || config.cppCompilerFlags.contains("-fuse-ld")) {
+        return {};
+    }
+    if (!choice.isEmpty() && choice != "auto") {
+        return isBrokenLinker(compiler, choice) ? QString() : choice;
+    }
+    // lld is clang's own; GCC drives mold best (GCC 12+)
+    const std::vector<std::pair<QString, QString>> candidates = tools.clang
+        ? std::vector<std::pair<QString, QString>>{{"lld", "ld.lld"}, {"mold", "mold"}}
+        : std::vector<std::pair<QString, QString>>{
+              {"mold", "mold"}, {"lld", "ld.lld"}, {"gold", "ld.gold"}};
+    for (const auto &[linker, executable] : candidates) {
+        if (!isBrokenLinker(compiler, linker) &&
+            !QStandardPaths::findExecutable(executable).isEmpty()) {
+            return linker;
+        }
+    }
+    return {};
+}
+
+QString defaultPython() {
+#ifdef Q_OS_WIN
+    return QStringLiteral("python");
+#else
+    return QStringLiteral("python3");
+#endif
+}
+} // namespace
+
+CompileCache::CompileCache(const QString &directory)
+    : directory_(directory),
+      maxBytes_(kDefaultMaxBytes) {
+    QDir().mkpath(directory_);
+    leases_ = leasesFor(directory_);
+}
+
+std::shared_ptr<CompileCache::Leases> CompileCache::leasesFor(const QString &directory) {
+    static QMutex mutex;
+    static std::map<QString, std::weak_ptr<Leases>> byDirectory;
+    const QFileInfo info(directory);
+    const QString path =
+        info.canonicalFilePath().isEmpty() ? info.absoluteFilePath() : info.canonicalFilePath();
+
+    QMutexLocker lock(&mutex);
+    std::shared_ptr<Leases> leases = byDirectory[path].lock();
+    if (!leases) {
+        for (auto it = byDirectory.begin(); it != byDirectory.end();) {
+            it = it->second.expired() ? byDirectory.erase(it) : std::next(it);
+        }
+        leases = std::make_shared<Leases>();
+        byDirectory[path] = leases;
+    }
+    return leases;
+}
+
+CompileCache::~CompileCache() {
+    closing_ = true;
+    if (pchBuilder_.joinable()) {
+        pchBuilder_.join();
+    }
+}
+
+QString CompileCache::defaultDirectory() {
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation))
+        .filePath("compile");
+}
+
+QByteArray CompileCache::key(const QString &code, const CompilationConfig &config) {
+    const QString language = CompilationUtils::normalizeLanguage(config.language);
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    auto add = [&hash](const QString &value) {
+        hash.addData(value.toUtf8());
+        hash.addData(QByteArray(1, '\0'));
+    };
+    add(language);
+    if (language == "Python") {
+        add(config.pythonPath.trimmed());
+    } else if (language == "Java") {
+        add(config.javaCompilerPath.trimmed());
+    } else {
+        add(config.cppCompilerPath.trimmed());
+        add(config.cppCompilerFlags.trimmed());
+    }
+    add(code);
+    return hash.result().toHex().left(32);
+}
+
+CompileCache::Artifact CompileCache::get(const QString &source, const CompilationConfig &config) {
+    return get(source, config, BuildOptions());
+}
+
+CompileCache::Artifact CompileCache::get(const QString &source,
+                                         const CompilationConfig &config,
+                                         const BuildOptions &options) {
+    const QString code = CompilationUtils::applyTransclusion(
+        config.templateCode, source, config.transcludeTemplate);
+    const QByteArray entryKey = key(code, config);
+    const QString entryDir = QDir(directory_).filePath(QString::fromLatin1(entryKey));
+
+    for (;;) {
+        std::promise<Artifact> promise;
+        std::shared_future<Artifact> future;
+        bool owner = false;
+        {
+            QMutexLocker lock(&mutex_);
+            const auto it = entries_.find(entryKey);
+            if (it != entries_.end()) {
+                future = it->second;
+            } else {
+                future = promise.get_future().share();
+                entries_.emplace(entryKey, future);
+                owner = true;
+            }
+        }
+
+        if (owner) {
+            Artifact artifact = load(entryDir, config);
+            if (!artifact.ok) {
+                artifact = build(code, entryDir, config, options);
+            }
+            artifact.key = entryKey;
+            if (artifact.cancelled || artifact.transient) {
+                // Forget it so the next request builds again
+                QMutexLocker lock(&mutex_);
+                entries_.erase(entryKey);
+            }
+            const bool built = artifact.ok && !artifact.cached;
+            promise.set_value(std::move(artifact));
+            if (built) {
+                evict();
+            }
+        }
+        Artifact artifact = future.get();
+        // Someone else's cancelled build says nothing about this request
+        if (artifact.cancelled && !owner) {
+            continue;
+        }
+        if (!artifact.ok || acquire(artifact)) {
+            return artifact;
+        }
+        // Evicted between the build and now; build it again
+        QMutexLocker lock(&mutex_);
+        entries_.erase(entryKey);
+    }
+}
+
+CompileCache::Artifact CompileCache::find(const QString &source,
+                                          const CompilationConfig &config) const {
+    const QString code = CompilationUtils::applyTransclusion(
+        config.templateCode, source, config.transcludeTemplate);
+    const QByteArray entryKey = key(code, config);
+    Artifact artifact = load(QDir(directory_).filePath(QString::fromLatin1(entryKey)), config);
+    artifact.key = entryKey;
+    if (artifact.ok && !acquire(artifact)) {
+        return Artifact();
+    }
+    return artifact;
+}
+
+int CompileCache::leaseCount(const QByteArray &key) const {
+    QMutexLocker lock(&leases_->mutex);
+    const auto it = leases_->counts.find(key);
+    return it == leases_->counts.end() ? 0 : it->second;
+}
+
+bool CompileCache::acquire(Artifact &artifact) const {
+    QMutexLocker lock(&leases_->mutex);
+    // evict() removes the marker under this lock, so a present marker
+    // cannot disappear before the lease is counted
+    if (!QFileInfo::exists(QDir(artifact.workDir).filePath(kReadyFile))) {
+        return false;
+    }
+    ++leases_->counts[artifact.key];
+    const std::shared_ptr<Leases> leases = leases_;
+    const QByteArray entryKey = artifact.key;
+    artifact.lease = std::shared_ptr<const void>(leases.get(), [leases, entryKey](const void *) {
+        QMutexLocker lock(&leases->mutex);
+        const auto it = leases->counts.find(entryKey);
+        if (it != leases->counts.end() && --it->second <= 0) {
+            leases->counts.erase(it);
+        }
+    });
+    return true;
+}
+
+int CompileCache::evict() {
+    struct Entry {
+        QString path;
+        QByteArray key;
+        QDateTime lastUsed;
+        qint64 bytes = 0;
+    };
+    std::vector<Entry> entries;
+    qint64 total = 0;
+    const QFileInfoList dirs = QDir(directory_).entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QFileInfo &dir : dirs) {
+        // Scratch builds have no marker yet
+        const QFileInfo ready(QDir(dir.filePath()).filePath(kReadyFile));
+        if (!ready.exists()) {
+            continue;
+        }
+        Entry entry;
+        entry.path = dir.filePath();
+        entry.key = dir.fileName().toLatin1();
+        entry.lastUsed = ready.lastModified();
+        entry.bytes = directorySize(entry.path);
+        total += entry.bytes;
+        entries.push_back(std::move(entry));
+    }
+    if (total <= maxBytes_) {
+        return 0;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+        return a.lastUsed < b.lastUsed;
+    });
+    const QDateTime now = QDateTime::currentDateTime();
+    int removed = 0;
+    QMutexLocker lock(&leases_->mutex);
+    for (const Entry &entry : entries) {
+        if (total <= maxBytes_) {
+            break;
+        }
+        if (leases_->counts.count(entry.key) || entry.lastUsed.msecsTo(now) < kEvictGraceMs) {
+            continue;
+        }
+        // Without its marker the entry is gone for every process at once
+        if (!QFile::remove(QDir(entry.path).filePath(kReadyFile))) {
+            continue;
+        }
+        QDir(entry.path).removeRecursively();
+        {
+            QMutexLocker entriesLock(&mutex_);
+            entries_.erase(entry.key);
+        }
+        total -= entry.bytes;
+        ++removed;
+    }
+    return removed;
+}
+
+CompileCache::Artifact CompileCache::load(const QString &entryDir,
+                                          const CompilationConfig &config) const {
+    Artifact artifact;
+    QFile ready(QDir(entryDir).filePath(kReadyFile));
+    if (!ready.open(QIODevice::ReadOnly)) {
+        return artifact;
+    }
+    const QString mainClass = QString::fromUtf8(ready.readAll()).trimmed();
+    // The marker's mtime is the entry's last use for eviction
+    ready.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+
+    const QString language = CompilationUtils::normalizeLanguage(config.language);
+    artifact.workDir = entryDir;
+    if (language == "Python") {
+        artifact.program = trimmedOr(config.pythonPath, defaultPython());
+        artifact.args = CompilationUtils::splitArgs(config.pythonArgs);
+        artifact.args << QDir(entryDir).filePath("solution.py");
+    } else if (language == "Java") {
+        artifact.program = trimmedOr(config.javaRunPath, "java");
+        artifact.args = CompilationUtils::splitArgs(config.javaArgs);
+        artifact.args << "-cp" << entryDir << mainClass;
+        artifact.mainClass = mainClass;
+    } else {
+        artifact.program = QDir(entryDir).filePath(kExecutableName);
+        if (!QFileInfo::exists(artifact.program)) {
+            return Artifact();
+        }
+    }
+    artifact.ok = true;
+    artifact.cached = true;
+    return artifact;
+}
+
+CompileCache::Artifact CompileCache::build(const QString &code,
+                                           const QString &entryDir,
+                                           const CompilationConfig &config,
+                                           const BuildOptions &options) {
+    Artifact artifact;
+    QElapsedTimer timer;
+    timer.start();
+
+    QTemporaryDir scratch(QDir(directory_).filePath("build-XXXXXX"));
+    if (!scratch.isValid()) {
+        artifact.error = "Failed to create temporary directory";
+        artifact.transient = true;
+        return artifact;
+    }
+
+    const QString language = CompilationUtils::normalizeLanguage(config.language);
+    const QString mainClass =
+        language == "Java" ? CompilationUtils::detectJavaMainClass(code) : QString();
+    const QString sourceName = language == "Python" ? QStringLiteral("solution.py")
+                             : language == "Java"   ? mainClass + ".java"
+                                                    : QStringLiteral("solution.cpp");
+    const QString sourcePath = scratch.filePath(sourceName);
+
+    QFile file(sourcePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        artifact.error = "Failed to write source file";
+        artifact.transient = true;
+        return artifact;
+    }
+    file.write(code.toUtf8());
+    file.close();
+
+    qint64 linkMs = 0;
+    QString linker;
+    bool precompiled = false;
+    if (language == "Java") {
+        if (!runCompiler(trimmedOr(config.javaCompilerPath, "javac"), {sourcePath},
+                         scratch.path(), options, artifact)) {
+            return artifact;
+        }
+    } else if (language != "Python") {
+        const QString compiler = trimmedOr(config.cppCompilerPath, "g++");
+        const QStringList flags = CompilationUtils::splitArgs(config.cppCompilerFlags);
+        const Toolchain &tools = toolchain(compiler);
+
+        // Clang only takes a PCH named on the command line and rejects any
+        // mismatch; GCC quietly falls back to the header
+        QStringList compileArgs = flags;
+        if (config.cppPrecompiledHeader && !tools.clang && code.contains("bits/stdc++.h")) {
+            const QString pchDir = precompiledHeader(compiler, tools.version, flags);
+            if (!pchDir.isEmpty()) {
+                compileArgs << "-I" << pchDir;
+                precompiled = true;
+            }
+        }
+        const QString objectPath = scratch.filePath(kObjectName);
+        compileArgs << "-c" << sourcePath << "-o" << objectPath;
+        const qint64 compileStart = Trace::now();
+        if (!runCompiler(compiler, compileArgs, scratch.path(), options, artifact)) {
+            return artifact;
+        }
+        Trace::complete("compile object", compileStart,
+                        precompiled ? QStringLiteral("pch") : QString());
+
+        QElapsedTimer linkTimer;
+        linkTimer.start();
+        const qint64 linkStart = Trace::now();
+        linker = chooseLinker(config, compiler, tools);
+        QStringList linkArgs = flags;
+        linkArgs << objectPath << "-o" << scratch.filePath(kExecutableName);
+        bool linked = runCompiler(compiler,
+                                  linker.isEmpty() ? linkArgs
+                                                   : linkArgs + QStringList{"-fuse-ld=" + linker},
+                                  scratch.path(), options, artifact);
+        if (!linked && !linker.isEmpty() && !artifact.cancelled) {
+            // Not installed, or a driver too old for it: if the default
+            // linker works, stop asking for this one
+            linked = runCompiler(compiler, linkArgs, scratch.path(), options, artifact);
+            if (linked) {
+                markBrokenLinker(compiler, linker);
+            }
+            linker.clear();
+        }
+        if (!linked) {
+            return artifact;
+        }
+        Trace::complete("link", linkStart, linker.isEmpty() ? QStringLiteral("default") : linker);
+        linkMs = linkTimer.elapsed();
+        QFile::remove(objectPath);
+    }
+
+    // Handed to several engines at once; none of them may modify it
+    makeReadOnly(scratch.path());
+
+    QFile ready(scratch.filePath(kReadyFile));
+    if (!ready.open(QIODevice::WriteOnly)) {
+        artifact.error = "Failed to write compile cache entry";
+        artifact.transient = true;
+        return artifact;
+    }
+    ready.write(mainClass.toUtf8());
+    ready.close();
+
+    // Publish; if another process got there first its entry is just as good,
+    // but a broken one (binary deleted by hand) is replaced
+    bool published = QDir().rename(scratch.path(), entryDir);
+    if (!published && !load(entryDir, config).ok) {
+        QDir(entryDir).removeRecursively();
+        published = QDir().rename(scratch.path(), entryDir);
+    }
+    if (published) {
+        scratch.setAutoRemove(false);
+    }
+    const qint64 compileMs = timer.elapsed();
+    artifact = load(entryDir, config);
+    if (!artifact.ok) {
+        artifact.error = "Failed to publish compile cache entry";
+        artifact.transient = true;
+        return artifact;
+    }
+    artifact.cached = false;
+    artifact.compileMs = compileMs;
+    artifact.linkMs = linkMs;
+    artifact.linker = linker;
+    artifact.precompiledHeader = precompiled;
+    return artifact;
+}
+
+QString CompileCache::precompiledHeader(const QString &compiler,
+                                        const QByteArray &version,
+                                        const QStringList &flags) {
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(compiler.toUtf8());
+    hash.addData(QByteArray(1, '\0'));
+    hash.addData(version);
+    hash.addData(QByteArray(1, '\0'));
+    hash.addData(flags.join(QChar('\0')).toUtf8());
+    const QString pchRoot = QDir(directory_).filePath("pch");
+    const QString pchDir = QDir(pchRoot).filePath(QString::fromLatin1(hash.result().toHex().left(32)));
+    if (QFileInfo::exists(QDir(pchDir).filePath(kPrecompiledHeader))) {
+        return pchDir;
+    }
+
+    QMutexLocker lock(&pchMutex_);
+    if (pchBuilding_ || pchFailed_.count(pchDir)) {
+        return {};
+    }
+    if (pchBuilder_.joinable()) {
+        pchBuilder_.join();
+    }
+    pchBuilding_ = true;
+    pchBuilder_ = std::thread([this, compiler, flags, pchRoot, pchDir]() {
+        Trace::Span span("precompile header");
+        bool ok = false;
+        QDir().mkpath(pchRoot);
+        QTemporaryDir scratch(QDir(pchRoot).filePath("build-XXXXXX"));
+        if (scratch.isValid() && QDir(scratch.path()).mkpath("bits")) {
+            const QString wrapper = scratch.filePath("pch.h");
+            QFile file(wrapper);
+            if (file.open(QIODevice::WriteOnly)) {
+                file.write("#include <bits/stdc++.h>\n");
+                file.close();
+                // Same flags as the solution, or GCC will not use it
+                QStringList args = flags;
+                args << "-x" << "c++-header" << wrapper
+                     << "-o" << scratch.filePath(kPrecompiledHeader);
+                BuildOptions options;
+                options.lowPriority = true;
+                options.cancelled = &closing_;
+                CompileCache::Artifact result;
+                ok = runCompiler(compiler, args, scratch.path(), options, result);
+                QFile::remove(wrapper);
+                if (ok && QDir().rename(scratch.path(), pchDir)) {
+                    scratch.setAutoRemove(false);
+                }
+                // A lost race leaves the other builder's header in place
+                ok = ok || result.cancelled;
+            }
+        }
+        QMutexLocker lock(&pchMutex_);
+        if (!ok) {
+            pchFailed_.insert(pchDir);
+        }
+        pchBuilding_ = false;
+    });
+    return {};
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "execution/CompilationConfig.h"
+
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <future>
+#include <map>
+#include <memory>
+#include <set>
+#include <thread>
+
+// Content-addressed store of compiled solutions. The key hashes the
+// transcluded source together with every setting that affects the build,
+// so identical sources (e.g. many problems sharing a template and an
+// unchanged solution) compile once per machine, not once per run.
+//
+// Entries live in <directory>/<key>/ and only count once their "ready"
+// marker exists; they are built in a scratch directory and renamed into
+// place, so concurrent processes never see half-written binaries.
+// get() is thread-safe and concurrent requests for one key share a build.
+//
+// This is the one owner of compiled binaries: Run, Run All and stress
+// (solution, brute and generator alike) all fetch their executables here,
+// so switching between them never recompiles. Published files are
+// read-only. A failed build is remembered for the session only when the
+// compiler itself rejected the code. Each returned Artifact holds a lease
+// on its entry; entries are evicted least recently used first once the
+// cache outgrows its budget, but never while leased or recently used by any
+// process. Caches on the same directory within a process share their lease
+// counts, so one instance's evict() respects the leases taken through
+// another (e.g. a harness runner's).
+//
+// C++ is compiled to an object and linked in a second step, with mold, lld
+// or gold when available (CompilationConfig::cppLinker); a linker the
+// driver rejects is dropped for the rest of the session. With GCC, sources
+// that include <bits/stdc++.h> pick up a precompiled copy of it built once
+// per compiler and flags under <directory>/pch; until that exists (it is
+// built in the background) they compile as usual.
+class CompileCache {
+public:
+    struct Artifact {
+        bool ok = false;
+        QString program;    // executable or interpreter
+        QStringList args;   // arguments before stdin is piped
+        QString workDir;    // entry directory
+        QString mainClass;  // Java: class on the workDir classpath to run
+        QString error;      // compiler output when !ok
+        bool cached = false;
+        bool cancelled = false;  // BuildOptions::cancelled was raised
+        // Failed for a reason of the moment (timeout, compiler missing, disk)
+        // rather than in the compiler's diagnostics; not kept, so the next
+        // request builds again
+        bool transient = false;
+        qint64 compileMs = 0;
+        qint64 linkMs = 0;               // C++: the part of compileMs spent linking
+        QString linker;                  // C++: -fuse-ld used, empty for the default
+        bool precompiledHeader = false;  // C++: compiled against the cached PCH
+        QByteArray key;
+        // Keeps the entry from being evicted while any copy is alive
+        std::shared_ptr<const void> lease;
+    };
+
+    // For speculative builds: compile at reduced priority (Unix) and give
+    // up as soon as *cancelled becomes true. A cancelled build is not kept.
+    struct BuildOptions {
+        bool lowPriority = false;
+        const std::atomic<bool> *cancelled = nullptr;
+        int timeoutMs = 30000;  // per compiler invocation
+    };
+
+    explicit CompileCache(const QString &directory = defaultDirectory());
+    ~CompileCache();
+
+    CompileCache(const CompileCache &) = delete;
+    CompileCache &operator=(const CompileCache &) = delete;
+
+    // <cache location>/compile
+    static QString defaultDirectory();
+
+    static QByteArray key(const QString &code, const CompilationConfig &config);
+
+    // Transclude `source` into the config's template, then compile it
+    // unless an entry already exists
+    Artifact get(const QString &source, const CompilationConfig &config);
+    Artifact get(const QString &source,
+                 const CompilationConfig &config,
+                 const BuildOptions &options);
+
+    // The published entry for `source`, or !ok; never builds
+    Artifact find(const QString &source, const CompilationConfig &config) const;
+
+    // Soft limit on the size of all entries together
+    void setMaxBytes(qint64 bytes) { maxBytes_ = bytes; }
+    qint64 maxBytes() const { return maxBytes_; }
+    int leaseCount(const QByteArray &key) const;
+
+    // Removes least recently used entries until the cache fits its budget;
+    // returns how many were removed. Runs after every build.
+    int evict();
+
+private:
+    // Shared with outstanding leases, which may outlive the cache, and with
+    // every other cache on the same directory
+    struct Leases {
+        QMutex mutex;
+        std::map<QByteArray, int> counts;
+    };
+    static std::shared_ptr<Leases> leasesFor(const QString &directory);
+
+    Artifact load(const QString &entryDir, const CompilationConfig &config) const;
+    // Leases `artifact` unless its entry was evicted meanwhile
+    bool acquire(Artifact &artifact) const;
+    Artifact build(const QString &code,
+                   const QString &entryDir,
+                   const CompilationConfig &config,
+                   const BuildOptions &options);
+    // Directory to put before the include path so GCC finds the
+    // precompiled <bits/stdc++.h>; empty (and building) while it is missing
+    QString precompiledHeader(const QString &compiler,
+                              const QByteArray &version,
+                              const QStringList &flags);
+
+    QString directory_;
+    qint64 maxBytes_;
+    std::shared_ptr<Leases> leases_;
+    QMutex mutex_;
+    std::map<QByteArray, std::shared_future<Artifact>> entries_;
+
+    QMutex pchMutex_;
+    std::thread pchBuilder_;            // one header at a time
+    std::atomic<bool> pchBuilding_{false};
+    std::set<QString> pchFailed_;       // not retried this session
+    std::atomic<bool> closing_{false};  // stops the builder
+};
@@ -0,0 +1,129 @@
+#include "execution/Complexity.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Complexity {
+
+Regression fitLogLog(const std::vector<double> &sizes,
+                     const std::vector<double> &timesMs) {
+    Regression result;
+    std::vector<double> xs;
+    std::vector<double> ys;
+    xs.reserve(sizes.size());
+    ys.reserve(timesMs.size());
+
+    for (size_t i = 0; i < sizes.size() && i < timesMs.size(); ++i) {
+        const double n = sizes[i];
+        const double t = timesMs[i];
+        if (n > 0.0) {
+            const double tForFit = t > 0.0 ? t : 1.0;
+            xs.push_back(std::log(n));
+            ys.push_back(std::log(tForFit));
+            if (t > 0.0) {
+                result.maxMs = std::max(result.maxMs, t);
+            }
+        }
+    }
+
+    if (xs.size() < 3) {
+        return result;
+    }
+
+    double sumX = 0.0;
+    double sumY = 0.0;
+    for (size_t i = 0; i < xs.size(); ++i) {
+        sumX += xs[i];
+        sumY += ys[i];
+    }
+    const double meanX = sumX / xs.size();
+    const double meanY = sumY / ys.size();
+
+    double num = 0.0;
+    double den = 0.0;
+    for (size_t i = 0; i < xs.size(); ++i) {
+        const double dx = xs[i] - meanX;
+        num += dx * (ys[i] - meanY);
+        den += dx * dx;
+    }
+
+    if (den <= 0.0) {
+        return result;
+    }
+
+    const double slope = num / den;
+    const double intercept = meanY - slope * meanX;
+
+    double ssTot = 0.0;
+    double ssRes = 0.0;
+    for (size_t i = 0; i < xs.size(); ++i) {
+        const double fit = intercept + slope * xs[i];
+        ssTot += (ys[i] - meanY) * (ys[i] - meanY);
+        ssRes += (ys[i] - fit) * (ys[i] - fit);
+    }
+    const double r2 = ssTot > 0.0 ? (1.0 - (ssRes / ssTot)) : 0.0;
+
+    result.ok = true;
+    result.slope = slope;
+    result.r2 = r2;
+    return result;
+}
+
+QString estimateLabel(const std::vector<double> &sizes,
+                      const std::vector<double> &timesMs) {
+    const Regression reg = fitLogLog(sizes, timesMs);
+    if (!reg.ok) {
+        return QString();
+    }
+    return QString("Estimated: T ≈ a·n^%1 (R²=%2)")
+        .arg(reg.slope, 0, 'f', 2)
+        .arg(reg.r2, 0, 'f', 2);
+}
+
+QString suspectedLabel(const std::vector<double> &sizes,
+                       const std::vector<double> &timesMs) {
+    const Regression reg = fitLogLog(sizes, timesMs);
+    if (!reg.ok) {
+        return QString("Suspected: insufficient timing data");
+    }
+    struct Bucket {
+        const char *label;
+        const char *title;
+        const char *desc;
+    };
+
+    const double k = reg.slope;
+    Bucket bucket;
+    if (k < 0.15) {
+        bucket = {"O(1)", "constant", "Doesn’t scale with input."};
+    } else if (k < 0.5) {
+        bucket = {"O(log n)", "logarithmic", "Grows very slowly. Doubling n adds ~1 step."};
+    } else if (k < 1.15) {
+        bucket = {"O(n)", "linear", "Double input → double work."};
+    } else if (k < 1.6) {
+        bucket = {"O(n log n)", "near-linear", "Slightly worse than linear, still excellent."};
+    } else if (k < 2.4) {
+        bucket = {"O(n²)", "quadratic", "Works for small n, explodes fast."};
+    } else if (k < 3.2) {
+        bucket = {"O(n³)", "cubic", "Only acceptable for very small n."};
+    } else {
+        bucket = {"O(2ⁿ)/O(n!)", "exponential / factorial", "Impossible past tiny n."};
+    }
+
+    const QString maxTime =
+        reg.maxMs > 0.0 ? QString(" • max %1 ms").arg(reg.maxMs, 0, 'f', 0)
+                        : QString(" • max <1 ms");
+    const QString summary = QString("Suspected: %1 — %2")
+        .arg(bucket.label)
+        .arg(bucket.title);
+    const QString fit = QString("Fit: n^%1 (R²=%2)%3")
+        .arg(reg.slope, 0, 'f', 2)
+        .arg(reg.r2, 0, 'f', 2)
+        .arg(maxTime);
+    return QString("%1\n%2\n%3")
+        .arg(summary)
+        .arg(bucket.desc)
+        .arg(fit);
+}
+
+} // namespace Complexity
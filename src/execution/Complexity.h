@@ -0,0 +1,28 @@
+#pragma once
+
+#include <QString>
+#include <vector>
+
+// Empirical time complexity from (input size, running time) samples: a
+// least-squares fit of log(time) against log(size).
+namespace Complexity {
+
+struct Regression {
+    bool ok = false;
+    double slope = 0.0;
+    double r2 = 0.0;
+    double maxMs = 0.0;
+};
+
+Regression fitLogLog(const std::vector<double> &sizes,
+                     const std::vector<double> &timesMs);
+
+// One-line fit summary, empty when there are fewer than 3 samples
+QString estimateLabel(const std::vector<double> &sizes,
+                      const std::vector<double> &timesMs);
+
+// Nearest complexity class with a short explanation
+QString suspectedLabel(const std::vector<double> &sizes,
+                       const std::vector<double> &timesMs);
+
+} // namespace Complexity
@@ -0,0 +1,395 @@
+#include "execution/DiffEngine.h"
+
+#include <QHash>
+
+#include <algorithm>
+
+namespace {
+
+using Edit = DiffEngine::Edit;
+using Kind = DiffEngine::Edit::Kind;
+
+// Myers diff over interned lines. Regions are split at the middle snake
+// and recursed into left to right, so edits come out in order and the run
+// can stop as soon as enough differences are known.
+class Differ {
+public:
+    Differ(const std::vector<int> &a,
+           const std::vector<int> &b,
+           const DiffEngine::Options &options,
+           DiffEngine::Result &result)
+        : a_(a), b_(b), options_(options), result_(result) {}
+
+    void run() {
+        diff(0, static_cast<int>(a_.size()), 0, static_cast<int>(b_.size()));
+    }
+
+private:
+    void diff(int aLo, int aHi, int bLo, int bHi) {
+        if (stopped_) {
+            return;
+        }
+
+        int prefix = 0;
+        while (aLo + prefix < aHi && bLo + prefix < bHi && a_[aLo + prefix] == b_[bLo + prefix]) {
+            ++prefix;
+        }
+        add(Kind::Equal, aLo, bLo, prefix);
+        aLo += prefix;
+        bLo += prefix;
+
+        int suffix = 0;
+        while (aLo < aHi - suffix && bLo < bHi - suffix &&
+               a_[aHi - 1 - suffix] == b_[bHi - 1 - suffix]) {
+            ++suffix;
+        }
+        aHi -= suffix;
+        bHi -= suffix;
+
+        if (aLo < aHi || bLo < bHi) {
+            // Whatever is left starts a new difference; skip the search if
+            // that one would be over the limit anyway
+            if (result_.differences >= options_.maxDifferences &&
+                (result_.edits.empty() || result_.edits.back().kind == Kind::Equal)) {
+                stop();
+                return;
+            }
+            if (aLo == aHi) {
+                add(Kind::Insert, aLo, bLo, bHi - bLo);
+            } else if (bLo == bHi) {
+                add(Kind::Delete, aLo, bLo, aHi - aLo);
+            } else {
+                int splitA = 0;
+                int splitB = 0;
+                if (bisect(aLo, aHi, bLo, bHi, splitA, splitB)) {
+                    diff(aLo, splitA, bLo, splitB);
+                    diff(splitA, aHi, splitB, bHi);
+                } else {
+                    add(Kind::Delete, aLo, bLo, aHi - aLo);
+                    add(Kind::Insert, aHi, bLo, bHi - bLo);
+                }
+            }
+        }
+
+        add(Kind::Equal, aHi, bHi, suffix);
+    }
+
+    // Find the middle snake of a[aLo, aHi) x b[bLo, bHi) by searching from
+    // both ends at once; O(N + M) memory. Returns false when the region
+    // needs more than maxEditDistance edits.
+    bool bisect(int aLo, int aHi, int bLo, int bHi, int &splitA, int &splitB) {
+        const int n = aHi - aLo;
+        const int m = bHi - bLo;
+        const int maxD = std::min((n + m + 1) / 2, std::max(options_.maxEditDistance, 1));
+        const int vOffset = maxD;
+        const int vLength = 2 * maxD + 2;
+        forward_.assign(static_cast<size_t>(vLength), -1);
+        backward_.assign(static_cast<size_t>(vLength), -1);
+        forward_[static_cast<size_t>(vOffset + 1)] = 0;
+        backward_[static_cast<size_t>(vOffset + 1)] = 0;
+
+        const int delta = n - m;
+        // With an odd delta the paths meet while extending forward
+        const bool front = (delta % 2 != 0);
+        int k1Start = 0;
+        int k1End = 0;
+        int k2Start = 0;
+        int k2End = 0;
+        auto at = [](std::vector<int> &v, int index) -> int & {
+            return v[static_cast<size_t>(index)];
+        };
+
+        for (int d = 0; d < maxD; ++d) {
+            for (int k1 = -d + k1Start; k1 <= d - k1End; k1 += 2) {
+                const int k1Offset = vOffset + k1;
+                int x1 = 0;
+                if (k1 == -d || (k1 != d && at(forward_, k1Offset - 1) < at(forward_, k1Offset + 1))) {
+                    x1 = at(forward_, k1Offset + 1);
+                } else {
+                    x1 = at(forward_, k1Offset - 1) + 1;
+                }
+                int y1 = x1 - k1;
+                while (x1 < n && y1 < m && a_[aLo + x1] == b_[bLo + y1]) {
+                    ++x1;
+                    ++y1;
+                }
+                at(forward_, k1Offset) = x1;
+                if (x1 > n) {
+                    k1End += 2;  // ran off the right edge
+                } else if (y1 > m) {
+                    k1Start += 2;  // ran off the bottom edge
+                } else if (front) {
+                    const int k2Offset = vOffset + delta - k1;
+                    if (k2Offset >= 0 && k2Offset < vLength && at(backward_, k2Offset) != -1) {
+                        const int x2 = n - at(backward_, k2Offset);
+                        if (x1 >= x2) {
+                            splitA = aLo + x1;
+                            splitB = bLo + y1;
+                            return true;
+                        }
+                    }
+                }
+            }
+
+            for (int k2 = -d + k2Start; k2 <= d - k2End; k2 += 2) {
+                const int k2Offset = vOffset + k2;
+                int x2 = 0;
+                if (k2 == -d || (k2 != d && at(backward_, k2Offset - 1) < at(backward_, k2Offset + 1))) {
+                    x2 = at(backward_, k2Offset + 1);
+                } else {
+                    x2 = at(backward_, k2Offset - 1) + 1;
+                }
+                int y2 = x2 - k2;
+                while (x2 < n && y2 < m && a_[aHi - 1 - x2] == b_[bHi - 1 - y2]) {
+                    ++x2;
+                    ++y2;
+                }
+                at(backward_, k2Offset) = x2;
+                if (x2 > n) {
+                    k2End += 2;
+                } else if (y2 > m) {
+                    k2Start += 2;
+                } else if (!front) {
+                    const int k1Offset = vOffset + delta - k2;
+                    if (k1Offset >= 0 && k1Offset < vLength && at(forward_, k1Offset) != -1) {
+                        const int x1 = at(forward_, k1Offset);
+                        const int y1 = vOffset + x1 - k1Offset;
+                        if (x1 >= n - x2) {
+                            splitA = aLo + x1;
+                            splitB = bLo + y1;
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    void add(Kind kind, int aStart, int bStart, int count) {
+        if (count <= 0) {
+            return;
+        }
+        if (stopped_) {
+            if (kind != Kind::Equal) {
+                result_.truncated = true;
+            }
+            return;
+        }
+
+        std::vector<Edit> &edits = result_.edits;
+        if (kind != Kind::Equal && (edits.empty() || edits.back().kind == Kind::Equal)) {
+            if (result_.differences >= options_.maxDifferences) {
+                stop();
+                return;
+            }
+            ++result_.differences;
+        }
+        if (!edits.empty() && edits.back().kind == kind) {
+            Edit &last = edits.back();
+            const bool contiguous = kind == Kind::Insert
+                ? last.actualLine + last.count == bStart
+                : last.expectedLine + last.count == aStart;
+            if (contiguous) {
+                last.count += count;
+                return;
+            }
+        }
+        edits.push_back({kind, aStart, bStart, count});
+    }
+
+    void stop() {
+        stopped_ = true;
+        result_.truncated = true;
+    }
+
+    const std::vector<int> &a_;
+    const std::vector<int> &b_;
+    const DiffEngine::Options &options_;
+    DiffEngine::Result &result_;
+    std::vector<int> forward_;
+    std::vector<int> backward_;
+    bool stopped_ = false;
+};
+
+int commonPrefix(const QString &a, const QString &b) {
+    const qsizetype limit = std::min(a.size(), b.size());
+    qsizetype i = 0;
+    while (i < limit && a.at(i) == b.at(i)) {
+        ++i;
+    }
+    return static_cast<int>(i);
+}
+
+int commonSuffix(const QString &a, const QString &b, int prefix) {
+    const qsizetype limit = std::min(a.size(), b.size()) - prefix;
+    qsizetype i = 0;
+    while (i < limit && a.at(a.size() - 1 - i) == b.at(b.size() - 1 - i)) {
+        ++i;
+    }
+    return static_cast<int>(i);
+}
+
+QString skippedNote(int count) {
+    return QString("\u2026 %L1 unchanged line%2 \u2026").arg(count).arg(count == 1 ? "" : "s");
+}
+
+} // namespace
+
+QStringList DiffEngine::splitLines(const QString &text) {
+    QString normalized = text;
+    normalized.replace("\r\n", "\n");
+    normalized.replace('\r', '\n');
+    QStringList lines = normalized.split('\n');
+    for (QString &line : lines) {
+        qsizetype end = line.size();
+        while (end > 0 && (line.at(end - 1) == ' ' || line.at(end - 1) == '\t')) {
+            --end;
+        }
+        line.truncate(end);
+    }
+    while (!lines.isEmpty() && lines.last().isEmpty()) {
+        lines.removeLast();
+    }
+    return lines;
+}
+
+DiffEngine::Result DiffEngine::compare(const QStringList &expected,
+                                       const QStringList &actual,
+                                       const Options &options) {
+    Result result;
+
+    const qsizetype common = std::min(expected.size(), actual.size());
+    qsizetype first = 0;
+    while (first < common && expected.at(first) == actual.at(first)) {
+        ++first;
+    }
+    if (first == expected.size() && first == actual.size()) {
+        if (first > 0) {
+            result.edits.push_back({Edit::Kind::Equal, 0, 0, static_cast<int>(first)});
+        }
+        return result;
+    }
+    result.firstMismatchLine = static_cast<int>(first);
+    result.firstMismatchColumn = first < common
+        ? commonPrefix(expected.at(first), actual.at(first))
+        : 0;
+
+    // Intern lines so the search compares ints
+    QHash<QString, int> ids;
+    ids.reserve(expected.size() + actual.size());
+    auto intern = [&ids](const QStringList &lines) {
+        std::vector<int> out;
+        out.reserve(static_cast<size_t>(lines.size()));
+        for (const QString &line : lines) {
+            auto it = ids.constFind(line);
+            if (it == ids.constEnd()) {
+                it = ids.insert(line, static_cast<int>(ids.size()));
+            }
+            out.push_back(it.value());
+        }
+        return out;
+    };
+    const std::vector<int> a = intern(expected);
+    const std::vector<int> b = intern(actual);
+
+    Differ(a, b, options, result).run();
+    return result;
+}
+
+DiffEngine::Report DiffEngine::report(const QString &expected,
+                                      const QString &actual,
+                                      const Options &options) {
+    const QStringList expectedLines = splitLines(expected);
+    const QStringList actualLines = splitLines(actual);
+
+    Report report;
+    report.result = compare(expectedLines, actualLines, options);
+    std::vector<Line> &lines = report.lines;
+    const std::vector<Edit> &edits = report.result.edits;
+    const int context = std::max(options.contextLines, 0);
+
+    auto full = [&lines, &options]() {
+        return static_cast<int>(lines.size()) >= options.maxReportLines;
+    };
+    auto addContext = [&](const Edit &edit, int from, int to) {
+        for (int i = from; i < to && !full(); ++i) {
+            Line line;
+            line.kind = Line::Kind::Context;
+            line.expectedLine = edit.expectedLine + i;
+            line.actualLine = edit.actualLine + i;
+            line.text = expectedLines.at(line.expectedLine);
+            lines.push_back(line);
+        }
+    };
+
+    for (size_t i = 0; i < edits.size() && !full(); ++i) {
+        const Edit &edit = edits[i];
+        if (edit.kind == Edit::Kind::Equal) {
+            const bool hasBefore = i > 0;
+            const bool hasAfter = i + 1 < edits.size();
+            const int head = hasBefore ? std::min(context, edit.count) : 0;
+            const int tail = hasAfter ? std::min(context, edit.count - head) : 0;
+            addContext(edit, 0, head);
+            const int skipped = edit.count - head - tail;
+            if (skipped > 0 && (hasBefore || hasAfter)) {
+                lines.push_back({Line::Kind::Skipped, skippedNote(skipped)});
+            }
+            addContext(edit, edit.count - tail, edit.count);
+            continue;
+        }
+
+        // A run of deletes followed by inserts: pair lines up for highlighting
+        const Edit *removed = nullptr;
+        const Edit *added = nullptr;
+        if (edit.kind == Edit::Kind::Delete) {
+            removed = &edit;
+            if (i + 1 < edits.size() && edits[i + 1].kind == Edit::Kind::Insert) {
+                added = &edits[++i];
+            }
+        } else {
+            added = &edit;
+        }
+        const int removedCount = removed ? removed->count : 0;
+        const int addedCount = added ? added->count : 0;
+
+        auto addChanged = [&](Line::Kind kind, const Edit *run, int count, int otherCount,
+                              const QStringList &source, const QStringList &other,
+                              const Edit *otherRun) {
+            for (int k = 0; k < count && !full(); ++k) {
+                Line line;
+                line.kind = kind;
+                if (kind == Line::Kind::Removed) {
+                    line.expectedLine = run->expectedLine + k;
+                    line.text = source.at(line.expectedLine);
+                } else {
+                    line.actualLine = run->actualLine + k;
+                    line.text = source.at(line.actualLine);
+                }
+                if (k < otherCount) {
+                    const QString &counterpart = other.at(kind == Line::Kind::Removed
+                        ? otherRun->actualLine + k
+                        : otherRun->expectedLine + k);
+                    const int prefix = commonPrefix(line.text, counterpart);
+                    const int suffix = commonSuffix(line.text, counterpart, prefix);
+                    line.changeStart = prefix;
+                    line.changeLength = static_cast<int>(line.text.size()) - prefix - suffix;
+                }
+                lines.push_back(line);
+            }
+        };
+        addChanged(Line::Kind::Removed, removed, removedCount, addedCount,
+                   expectedLines, actualLines, added);
+        addChanged(Line::Kind::Added, added, addedCount, removedCount,
+                   actualLines, expectedLines, removed);
+    }
+
+    if (full()) {
+        lines.push_back({Line::Kind::Skipped, QStringLiteral("\u2026 diff too long, rest not shown \u2026")});
+    } else if (report.result.truncated) {
+        lines.push_back({Line::Kind::Skipped,
+                         QString("\u2026 stopped after %1 differences \u2026")
+                             .arg(report.result.differences)});
+    }
+    return report;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <vector>
+
+// Line diff between expected and actual output (Myers' O(ND) algorithm with
+// the linear-space middle-snake refinement). Lines are compared the way the
+// judge compares them: trailing whitespace and trailing empty lines are
+// ignored. Pure and thread-safe; meant to run on a worker thread.
+class DiffEngine {
+public:
+    struct Options {
+        // Stop once this many separate differences have been found
+        int maxDifferences = 20;
+        // Regions needing more edits than this are reported as one
+        // replacement instead of being diffed further (bounds the cost)
+        int maxEditDistance = 4000;
+        // Unchanged lines shown around each difference in the report
+        int contextLines = 2;
+        // Report lines beyond this are dropped
+        int maxReportLines = 5000;
+    };
+
+    struct Edit {
+        enum class Kind { Equal, Delete, Insert };
+        Kind kind = Kind::Equal;
+        int expectedLine = 0;  // first line in expected (Equal, Delete)
+        int actualLine = 0;    // first line in actual (Equal, Insert)
+        int count = 0;
+    };
+
+    struct Result {
+        std::vector<Edit> edits;  // in order; ends early when truncated
+        int differences = 0;      // runs of deletes/inserts found
+        bool truncated = false;   // stopped at maxDifferences
+        int firstMismatchLine = -1;    // 0-based; -1 when identical
+        int firstMismatchColumn = -1;  // 0-based column in that line
+
+        bool identical() const { return differences == 0; }
+    };
+
+    // One line of the rendered unified diff
+    struct Line {
+        enum class Kind { Context, Removed, Added, Skipped };
+        Kind kind = Kind::Context;
+        QString text;  // for Skipped: a short note
+        int expectedLine = -1;
+        int actualLine = -1;
+        // Changed character range of a Removed/Added line paired with its
+        // counterpart; start == -1 when the whole line is highlighted
+        int changeStart = -1;
+        int changeLength = 0;
+    };
+
+    struct Report {
+        Result result;
+        std::vector<Line> lines;
+    };
+
+    static QStringList splitLines(const QString &text);
+
+    static Result compare(const QStringList &expected,
+                          const QStringList &actual,
+                          const Options &options);
+    static Result compare(const QStringList &expected, const QStringList &actual) {
+        return compare(expected, actual, Options());
+    }
+
+    // compare() plus a unified diff of the differences with context
+    static Report report(const QString &expected,
+                         const QString &actual,
+                         const Options &options);
+    static Report report(const QString &expected, const QString &actual) {
+        return report(expected, actual, Options());
+    }
+};
@@ -1,10 +1,14 @@
 #include "execution/ExecutionController.h"
 #include "execution/CompilationUtils.h"
+#include "execution/CompileCache.h"
+#include "execution/InputCache.h"
+#include "execution/ProcessRegistry.h"
+#include "execution/Trace.h"
 
-#include <QDir>
-#include <QFile>
+#include <QFutureWatcher>
 #include <QIcon>
 #include <QLabel>
+#include "ui/AutoResizingTextEdit.h"
 #include "ui/IconUtils.h"
 #include <QPlainTextEdit>
 #include <QProcess>
@@ -13,24 +17,29 @@
 #include <QSize>
 #include <QSplitter>
 #include <QStyle>
-#include <QStringConverter>
 #include <QTemporaryDir>
-#include <QTextStream>
 #include <QTimer>
+#include <QtConcurrent>
 #include <Qsci/qsciscintilla.h>
 #include <csignal>
+#include <utility>
 #ifdef Q_OS_UNIX
 #include <unistd.h>
 #endif
 
+namespace {
+// Outputs up to this many bytes (actual + expected) are compared inline
+constexpr qsizetype kInlineCompareBytes = 256 * 1024;
+} // namespace
+
 ExecutionController::ExecutionController(QObject *parent)
     : QObject(parent),
-      compilerProcess_(new QProcess(this)),
-      runProcess_(new QProcess(this)) {
+      compileCache_(std::make_shared<CompileCache>()),
+      runProcess_(new QProcess(this)),
+      verdictWatcher_(new QFutureWatcher<bool>(this)) {
 
     // Create new process groups so we can kill entire trees
 #ifdef Q_OS_UNIX
-    compilerProcess_->setChildProcessModifier([]() { ::setsid(); });
     runProcess_->setChildProcessModifier([]() { ::setsid(); });
 #endif
 
@@ -56,54 +65,70 @@ ExecutionController::ExecutionController(QObject *parent)
 #endif
         runProcess_->kill();
         runProcess_->waitForFinished(1000);
+        Trace::complete("run", runStartUs_, "TLE");
         lastExecutionTimeMs_ = timeoutMs_;
         updateStatus("Time Limit Exceeded");
-        if (ui_.errorViewer) {
-            ui_.errorViewer->setPlainText("Time Limit Exceeded");
-        }
+        setErrorText("Time Limit Exceeded");
         updateOutputPanels(false, true);
         setState(State::Idle);
         cleanupTempDir();
         emit executionFinished(QString(), "Time Limit Exceeded", -1);
     });
     
-    // Compiler process signals
-    connect(compilerProcess_, &QProcess::finished,
-            this, &ExecutionController::onCompilationFinished);
-
+    connect(verdictWatcher_, &QFutureWatcher<bool>::finished, this, [this]() {
+        if (!verdictPending_) {
+            return;  // stopped while checking
+        }
+        verdictPending_ = false;
+        Trace::complete("normalize", verdictStartUs_, "worker");
+        completeRun(verdictWatcher_->result() ? "Accepted" : "Wrong Answer");
+    });
+    
     // Run process signals
     connect(runProcess_, &QProcess::finished,
             this, &ExecutionController::onRunFinished);
     connect(runProcess_, &QProcess::errorOccurred,
             this, &ExecutionController::onRunError);
     
-    // Send input when process starts
+    // Keep the resource monitor's view of the running child current
+    connect(runProcess_, &QProcess::stateChanged, this, [this](QProcess::ProcessState state) {
+        if (state == QProcess::NotRunning && runPid_ > 0) {
+            ProcessRegistry::removeChild(runPid_);
+            runPid_ = 0;
+        }
+    });
+
     connect(runProcess_, &QProcess::started, this, [this]() {
-        if (ui_.inputEditor) {
-            const QString input = ui_.inputEditor->toPlainText();
-            if (!input.isEmpty()) {
-                runProcess_->write(input.toUtf8());
-            }
+        runPid_ = runProcess_->processId();
+        ProcessRegistry::addChild(runPid_, "Run");
+        Trace::complete("spawn", runStartUs_);
+        // Only when the input file could not be written
+        if (!pipeInput_.isEmpty()) {
+            Trace::Span span("write stdin");
+            runProcess_->write(pipeInput_.toUtf8());
+            pipeInput_.clear();
+            runProcess_->closeWriteChannel();
         }
-        runProcess_->closeWriteChannel();
     });
 }
 
 ExecutionController::~ExecutionController() {
     // Kill any running processes
-    if (compilerProcess_->state() != QProcess::NotRunning) {
-        compilerProcess_->kill();
-        compilerProcess_->waitForFinished(1000);
-    }
+    cancelCompilation();
     if (runProcess_->state() != QProcess::NotRunning) {
         runProcess_->kill();
         runProcess_->waitForFinished(1000);
     }
-    // Ensure temp directory is cleaned up
+    // Ensure temp directory is cleaned up, batch build included
+    batchBuilt_ = false;
     cleanupTempDir();
 }
 
 void ExecutionController::bind(const UiBindings &bindings) {
+    if (ui_.runButton && ui_.runButton != bindings.runButton) {
+        // The old button no longer controls this run
+        updateRunButtonForState(State::Idle);
+    }
     ui_ = bindings;
     updateRunButtonForState(state_);
 }
@@ -115,28 +140,52 @@ void ExecutionController::runWithBindings(const UiBindings &bindings) {
     if (state_ != State::Idle) {
         return;
     }
-    
+
+    if (batchBuilt_ && tempDir_ && tempDir_->isValid()) {
+        clearOutputs();
+        stopRequested_ = false;
+        lastExecutionTimeMs_ = -1;
+        startExecution();
+        return;
+    }
     startCompilation();
 }
 
+void ExecutionController::beginBatch() {
+    batchActive_ = true;
+    batchBuilt_ = false;
+}
+
+void ExecutionController::endBatch() {
+    batchActive_ = false;
+    batchBuilt_ = false;
+    // A run still in flight cleans up when it finishes
+    if (state_ == State::Idle) {
+        cleanupTempDir();
+    }
+}
+
 void ExecutionController::stop() {
     if (state_ == State::Idle) {
         return;
     }
 
+    if (verdictPending_) {
+        // The program already finished; just drop the pending comparison
+        verdictPending_ = false;
+        finishedRun_ = FinishedRun();
+        updateStatus("Stopped");
+        setState(State::Idle);
+        cleanupTempDir();
+        return;
+    }
+
     stopRequested_ = true;
     if (timeoutTimer_->isActive()) {
         timeoutTimer_->stop();
     }
 
-    if (compilerProcess_->state() != QProcess::NotRunning) {
-#ifdef Q_OS_UNIX
-        const qint64 pid = compilerProcess_->processId();
-        if (pid > 0) ::kill(-static_cast<pid_t>(pid), SIGKILL);
-#endif
-        compilerProcess_->kill();
-        compilerProcess_->waitForFinished(1000);
-    }
+    cancelCompilation();
     if (runProcess_->state() != QProcess::NotRunning) {
 #ifdef Q_OS_UNIX
         const qint64 pid = runProcess_->processId();
@@ -200,120 +249,81 @@ void ExecutionController::startCompilation() {
     timedOut_ = false;
 
     cleanupTempDir();
+    const qint64 tempDirStart = Trace::now();
     tempDir_ = std::make_unique<QTemporaryDir>();
+    Trace::complete("create temp dir", tempDirStart);
     if (!tempDir_ || !tempDir_->isValid()) {
         updateStatus("Compile Error");
-        if (ui_.errorViewer) {
-            ui_.errorViewer->setPlainText("Failed to create a temporary build directory.");
-        }
+        setErrorText("Failed to create a temporary build directory.");
         updateOutputPanels(false, true);
         setState(State::Idle);
         return;
     }
 
     const QString solution = ui_.codeEditor ? ui_.codeEditor->text() : QString();
-    const QString code = CompilationUtils::applyTransclusion(
-        config_.templateCode, solution, config_.transcludeTemplate);
-    const QString language = CompilationUtils::normalizeLanguage(config_.language);
-    const QString tempPath = tempDir_->path();
-    const QString sourceExt = language == "Python" ? "py"
-                           : language == "Java"   ? "java"
-                                                   : "cpp";
-    const QString sourceBaseName =
-        language == "Java" ? CompilationUtils::detectJavaMainClass(code) : "solution";
-    const QString sourcePath =
-        QDir(tempPath).filePath(QString("%1.%2").arg(sourceBaseName, sourceExt));
-#ifdef Q_OS_WIN
-    const QString outputPath = QDir(tempPath).filePath("solution.exe");
-#else
-    const QString outputPath = QDir(tempPath).filePath("solution");
-#endif
-
-    runProgram_.clear();
-    runArgs_.clear();
-    QFile file(sourcePath);
-    if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QTextStream out(&file);
-        out.setEncoding(QStringConverter::Utf8);
-        out << code;
-        file.close();
-    } else {
-        updateStatus("Compile Error");
-        if (ui_.errorViewer) {
-            ui_.errorViewer->setPlainText("Failed to write source file to temporary directory.");
-        }
-        updateOutputPanels(false, true);
-        setState(State::Idle);
-        cleanupTempDir();
+    compileStartUs_ = Trace::now();
+    compileDetail_ = CompilationUtils::normalizeLanguage(config_.language);
+
+    // Usually built already, by an earlier run, Run All, stress or
+    // SpeculativeCompiler
+    const CompileCache::Artifact cached = compileCache_->find(solution, config_);
+    if (cached.ok) {
+        compileDetail_ = "cached";
+        finishCompilation(cached);
         return;
     }
 
-
-
-    if (language == "Python") {
-#ifdef Q_OS_WIN
-        const QString defaultPython = "python";
-#else
-        const QString defaultPython = "python3";
-#endif
-        runProgram_ = config_.pythonPath.trimmed().isEmpty() ? defaultPython : config_.pythonPath.trimmed();
-        runArgs_ = CompilationUtils::splitArgs(config_.pythonArgs);
-        runArgs_ << sourcePath;
-        emit compilationSucceeded();
-        startExecution();
-        return;
-    }
-
-    if (language == "Java") {
-        runProgram_ = config_.javaRunPath.trimmed().isEmpty() ? "java" : config_.javaRunPath.trimmed();
-        runArgs_ = CompilationUtils::splitArgs(config_.javaArgs);
-        runArgs_ << "-cp" << tempPath << sourceBaseName;
-    } else {
-        runProgram_ = outputPath;
-    }
-
-    // Kill any running compilation
-    if (compilerProcess_->state() != QProcess::NotRunning) {
-        compilerProcess_->kill();
-        compilerProcess_->waitForFinished(1000);
-    }
-
-    compilerProcess_->setWorkingDirectory(tempPath);
-    if (language == "Java") {
-        const QString javacPath =
-            config_.javaCompilerPath.trimmed().isEmpty() ? "javac" : config_.javaCompilerPath.trimmed();
-        compilerProcess_->start(javacPath, {sourcePath});
-    } else {
-        const QString compilerPath =
-            config_.cppCompilerPath.trimmed().isEmpty() ? "g++" : config_.cppCompilerPath.trimmed();
-        QStringList compileArgs = CompilationUtils::splitArgs(config_.cppCompilerFlags);
-        compileArgs << sourcePath << "-o" << outputPath;
-        compilerProcess_->start(compilerPath, compileArgs);
-    }
+    cancelCompilation();
+    compileCancelled_ = std::make_shared<std::atomic<bool>>(false);
+    auto *watcher = new QFutureWatcher<CompileCache::Artifact>(this);
+    compileWatcher_ = watcher;
+    connect(watcher, &QFutureWatcher<CompileCache::Artifact>::finished, this, [this, watcher]() {
+        watcher->deleteLater();
+        // Stopped, or superseded by a newer compile
+        if (watcher != compileWatcher_) {
+            return;
+        }
+        compileWatcher_ = nullptr;
+        finishCompilation(watcher->result());
+    });
+    const std::shared_ptr<CompileCache> cache = compileCache_;
+    const std::shared_ptr<std::atomic<bool>> cancelled = compileCancelled_;
+    const CompilationConfig config = config_;
+    watcher->setFuture(QtConcurrent::run([cache, cancelled, solution, config]() {
+        CompileCache::BuildOptions options;
+        options.cancelled = cancelled.get();
+        return cache->get(solution, config, options);
+    }));
 }
 
-void ExecutionController::onCompilationFinished(int exitCode, QProcess::ExitStatus status) {
-    if (stopRequested_) {
-        stopRequested_ = false;
-        cleanupTempDir();
-        setState(State::Idle);
-        return;
-    }
-    if (exitCode == 0 && status == QProcess::NormalExit) {
-        emit compilationSucceeded();
-        startExecution();
-    } else {
-        const QString error = QString::fromUtf8(compilerProcess_->readAllStandardError());
+void ExecutionController::finishCompilation(const CompileCache::Artifact &artifact) {
+    Trace::complete("compile", compileStartUs_, compileDetail_);
+    compileStartUs_ = -1;
+    if (!artifact.ok) {
+        const QString error = artifact.error;
         updateStatus("Compile Error");
-        if (ui_.errorViewer) {
-            ui_.errorViewer->setPlainText(error);
-        }
+        setErrorText(error);
         updateOutputPanels(false, !error.isEmpty());
-        
+
         setState(State::Idle);
         emit compilationFailed(error);
         cleanupTempDir();
+        return;
+    }
+    artifact_ = artifact;
+    runProgram_ = artifact.program;
+    runArgs_ = artifact.args;
+    batchBuilt_ = batchActive_;
+    emit compilationSucceeded();
+    startExecution();
+}
+
+void ExecutionController::cancelCompilation() {
+    if (compileCancelled_) {
+        compileCancelled_->store(true);
     }
+    // Its result is ignored; the worker stops within a poll interval
+    compileWatcher_ = nullptr;
 }
 
 void ExecutionController::startExecution() {
@@ -332,9 +342,7 @@ void ExecutionController::startExecution() {
 
     if (!tempDir_ || !tempDir_->isValid()) {
         updateStatus("Run Failed");
-        if (ui_.errorViewer) {
-            ui_.errorViewer->setPlainText("Temporary build directory is missing.");
-        }
+        setErrorText("Temporary build directory is missing.");
         updateOutputPanels(false, true);
         setState(State::Idle);
         cleanupTempDir();
@@ -349,9 +357,7 @@ void ExecutionController::startExecution() {
 
     if (runProgram_.isEmpty()) {
         updateStatus("Run Failed");
-        if (ui_.errorViewer) {
-            ui_.errorViewer->setPlainText("Execution command is not configured.");
-        }
+        setErrorText("Execution command is not configured.");
         updateOutputPanels(false, true);
         setState(State::Idle);
         cleanupTempDir();
@@ -359,7 +365,19 @@ void ExecutionController::startExecution() {
     }
 
     runProcess_->setWorkingDirectory(tempDir_->path());
+    const QString input = ui_.inputEditor ? ui_.inputEditor->toPlainText() : ui_.input;
+    QString inputFile;
+    {
+        Trace::Span span("stdin file");
+        inputFile = input.isEmpty() ? QString() : InputCache::shared().file(input.toUtf8());
+        // An empty path means a pipe again
+        runProcess_->setStandardInputFile(input.isEmpty() ? QProcess::nullDevice() : inputFile);
+        pipeInput_ = !input.isEmpty() && inputFile.isEmpty() ? input : QString();
+    }
+    runStartUs_ = Trace::now();
     runProcess_->start(runProgram_, runArgs_);
+    // The child holds its own descriptor now (or never will)
+    InputCache::shared().release(inputFile);
 }
 
 void ExecutionController::onRunFinished(int exitCode, QProcess::ExitStatus status) {
@@ -377,8 +395,12 @@ void ExecutionController::onRunFinished(int exitCode, QProcess::ExitStatus statu
         return;
     }
     lastExecutionTimeMs_ = runTimer_.elapsed();
-    const QString stdOut = QString::fromUtf8(runProcess_->readAllStandardOutput());
+    Trace::complete("run", runStartUs_);
+    const qint64 readStart = Trace::now();
+    const QByteArray stdOutBytes = runProcess_->readAllStandardOutput();
+    const QString stdOut = QString::fromUtf8(stdOutBytes);
     const QString stdErr = QString::fromUtf8(runProcess_->readAllStandardError());
+    Trace::complete("read output", readStart);
     QString effectiveErr = stdErr;
 
     if (status == QProcess::CrashExit) {
@@ -450,34 +472,49 @@ void ExecutionController::onRunFinished(int exitCode, QProcess::ExitStatus statu
     }
 
     // Update output viewers
-    if (ui_.outputViewer) {
-        ui_.outputViewer->setPlainText(stdOut);
-    }
-    if (ui_.errorViewer) {
-        ui_.errorViewer->setPlainText(effectiveErr);
-    }
+    setOutputText(stdOut);
+    setErrorText(effectiveErr);
+    finishedRun_ = {stdOut, stdErr, effectiveErr, exitCode};
 
     // Determine result status
-    QString resultStatus;
     if (status != QProcess::NormalExit || exitCode != 0) {
-        resultStatus = "Runtime Error";
-    } else {
-        const QString expected = ui_.expectedEditor ? ui_.expectedEditor->toPlainText() : QString();
-        if (CompilationUtils::normalizeText(stdOut) == CompilationUtils::normalizeText(expected)) {
-            resultStatus = "Accepted";
-        } else {
-            resultStatus = "Wrong Answer";
-        }
+        completeRun("Runtime Error");
+        return;
     }
-    
-    const bool showOutput = !stdOut.isEmpty() || resultStatus != "Accepted";
-    const bool showError = !effectiveErr.isEmpty();
+
+    // Judged like Run All and stress, on the bytes the child wrote
+    const QByteArray expected = (ui_.expectedEditor ? ui_.expectedEditor->toPlainText()
+                                                    : ui_.expectedOutput).toUtf8();
+    if (stdOutBytes.size() + expected.size() <= kInlineCompareBytes) {
+        const qint64 normalizeStart = Trace::now();
+        const bool accepted = CompilationUtils::sameOutput(stdOutBytes, expected);
+        Trace::complete("normalize", normalizeStart);
+        completeRun(accepted ? "Accepted" : "Wrong Answer");
+        return;
+    }
+
+    // Normalizing and comparing megabytes of output would stall the GUI
+    updateStatus("Checking...");
+    verdictPending_ = true;
+    verdictStartUs_ = Trace::now();
+    verdictWatcher_->setFuture(QtConcurrent::run([stdOutBytes, expected]() {
+        return CompilationUtils::sameOutput(stdOutBytes, expected);
+    }));
+}
+
+void ExecutionController::completeRun(const QString &resultStatus) {
+    Trace::Span span("ui update");
+    const FinishedRun run = std::move(finishedRun_);
+    finishedRun_ = FinishedRun();
+
+    const bool showOutput = !run.stdOut.isEmpty() || resultStatus != "Accepted";
+    const bool showError = !run.effectiveErr.isEmpty();
     updateOutputPanels(showOutput, showError);
 
     updateStatus(resultStatus);
     setState(State::Idle);
     cleanupTempDir();
-    emit executionFinished(stdOut, stdErr, exitCode);
+    emit executionFinished(run.stdOut, run.stdErr, run.exitCode);
 }
 
 void ExecutionController::onRunError(QProcess::ProcessError /*error*/) {
@@ -504,71 +541,88 @@ void ExecutionController::onRunError(QProcess::ProcessError /*error*/) {
     }
     updateStatus("Run Failed");
 
-    if (ui_.errorViewer) {
-        const QString errorText = runProcess_->errorString();
-        ui_.errorViewer->setPlainText(errorText);
-        updateOutputPanels(false, !errorText.isEmpty());
-    }
+    const QString errorText = runProcess_->errorString();
+    setErrorText(errorText);
+    updateOutputPanels(false, !errorText.isEmpty());
 
     setState(State::Idle);
     cleanupTempDir();
 }
 
 void ExecutionController::cleanupTempDir() {
+    // The batch's build outlives its runs; endBatch() releases it
+    if (batchBuilt_) {
+        return;
+    }
     tempDir_.reset();
+    artifact_ = CompileCache::Artifact();
 }
 
 void ExecutionController::updateStatus(const QString &status) {
+    QString display = status;
+    QColor color;
+    QString timeSuffix;
+
+    if (status == "Accepted") {
+        display = "AC";
+        color = statusAcColor_;
+    } else if (status == "Compile Error") {
+        display = "CE";
+        color = statusErrorColor_;
+    } else if (status == "Runtime Error") {
+        display = "RE";
+        color = statusErrorColor_;
+    } else if (status == "Time Limit Exceeded") {
+        display = "TLE";
+        color = statusErrorColor_;
+    } else if (status == "Wrong Answer") {
+        display = "WA";
+        color = statusErrorColor_;
+    }
+
+    if (lastExecutionTimeMs_ >= 0 &&
+        (status == "Accepted" ||
+         status == "Runtime Error" ||
+         status == "Time Limit Exceeded" ||
+         status == "Wrong Answer")) {
+        timeSuffix = QString(" \u2022 %1 ms").arg(lastExecutionTimeMs_);
+    }
+
+    QString style = "font-weight: 700;";
+    if (color.isValid()) {
+        style.prepend(QString("color: %1; ").arg(color.name()));
+    }
+    outcome_.status = display + timeSuffix;
+    outcome_.statusColor = color;
     if (ui_.statusLabel) {
-        QString display = status;
-        QString color;
-        QString timeSuffix;
-
-        if (status == "Accepted") {
-            display = "AC";
-            color = statusAcColor_.name();
-        } else if (status == "Compile Error") {
-            display = "CE";
-            color = statusErrorColor_.name();
-        } else if (status == "Runtime Error") {
-            display = "RE";
-            color = statusErrorColor_.name();
-        } else if (status == "Time Limit Exceeded") {
-            display = "TLE";
-            color = statusErrorColor_.name();
-        } else if (status == "Wrong Answer") {
-            display = "WA";
-            color = statusErrorColor_.name();
-        }
-
-        if (lastExecutionTimeMs_ >= 0 &&
-            (status == "Accepted" ||
-             status == "Runtime Error" ||
-             status == "Time Limit Exceeded" ||
-             status == "Wrong Answer")) {
-            timeSuffix = QString(" \u2022 %1 ms").arg(lastExecutionTimeMs_);
-        }
-
-        ui_.statusLabel->setText(display + timeSuffix);
-        QString style = "font-weight: 700;";
-        if (!color.isEmpty()) {
-            style.prepend(QString("color: %1; ").arg(color));
-        }
+        ui_.statusLabel->setText(outcome_.status);
         ui_.statusLabel->setStyleSheet(style);
     }
 }
 
 void ExecutionController::clearOutputs() {
+    setOutputText(QString());
+    setErrorText(QString());
+    updateOutputPanels(false, false);
+}
+
+void ExecutionController::setOutputText(const QString &text) {
+    outcome_.output = text;
     if (ui_.outputViewer) {
-        ui_.outputViewer->clear();
+        ui_.outputViewer->setOutputText(text);
     }
+}
+
+void ExecutionController::setErrorText(const QString &text) {
+    outcome_.error = text;
     if (ui_.errorViewer) {
-        ui_.errorViewer->clear();
+        ui_.errorViewer->setOutputText(text);
     }
-    updateOutputPanels(false, false);
 }
 
 void ExecutionController::updateOutputPanels(bool showOutput, bool showError) {
+    outcome_.showOutput = showOutput;
+    outcome_.showError = showError;
     if (!ui_.outputSplitter || !ui_.outputBlock || !ui_.errorBlock) {
         return;
     }
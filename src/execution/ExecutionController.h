@@ -1,6 +1,7 @@
 #pragma once
 
 #include "execution/CompilationConfig.h"
+#include "execution/CompileCache.h"
 
 #include <QObject>
 #include <QProcess>
@@ -9,8 +10,10 @@
 #include <QColor>
 #include <QString>
 #include <QStringList>
+#include <atomic>
 #include <memory>
 
+class AutoResizingTextEdit;
 class QLabel;
 class QPlainTextEdit;
 class QPushButton;
@@ -18,6 +21,8 @@ class QSplitter;
 class QsciScintilla;
 class QWidget;
 class QTimer;
+template <typename T>
+class QFutureWatcher;
 
 class ExecutionController : public QObject {
     Q_OBJECT
@@ -34,13 +39,27 @@ public:
         QsciScintilla *codeEditor = nullptr;
         QPlainTextEdit *inputEditor = nullptr;
         QPlainTextEdit *expectedEditor = nullptr;
-        QPlainTextEdit *outputViewer = nullptr;
-        QPlainTextEdit *errorViewer = nullptr;
+        AutoResizingTextEdit *outputViewer = nullptr;
+        AutoResizingTextEdit *errorViewer = nullptr;
         QLabel *statusLabel = nullptr;
         QSplitter *outputSplitter = nullptr;
         QWidget *outputBlock = nullptr;
         QWidget *errorBlock = nullptr;
         QPushButton *runButton = nullptr;
+        // Used instead of the editors when those are null (case has no widgets)
+        QString input;
+        QString expectedOutput;
+    };
+
+    // What the bound widgets were last told to show, kept so results can be
+    // stored for cases whose widgets do not exist
+    struct Outcome {
+        QString status;
+        QColor statusColor;  // invalid: default text color
+        QString output;
+        QString error;
+        bool showOutput = false;
+        bool showError = false;
     };
 
     explicit ExecutionController(QObject *parent = nullptr);
@@ -49,10 +68,17 @@ public:
     void bind(const UiBindings &bindings);
     void runWithBindings(const UiBindings &bindings);
     void stop();
+    // Between these, the first successful build is kept and every later
+    // run reuses it, so a sequential Run All compiles once
+    void beginBatch();
+    void endBatch();
     void setIconTintColor(const QColor &color);
     
     void setConfig(const CompilationConfig &cfg) { config_ = cfg; }
     const CompilationConfig &config() const { return config_; }
+    // Where solutions are built; shared with Run All and stress so a build
+    // made by any of them (or by SpeculativeCompiler) is reused
+    void setCompileCache(std::shared_ptr<CompileCache> cache) { compileCache_ = std::move(cache); }
 
     void setTimeoutMs(int ms) { timeoutMs_ = ms; }
     void setStatusColors(const QColor &ac, const QColor &err) {
@@ -62,6 +88,7 @@ public:
     
     State state() const { return state_; }
     qint64 lastExecutionTimeMs() const { return lastExecutionTimeMs_; }
+    const Outcome &lastOutcome() const { return outcome_; }
 
 signals:
     void stateChanged(State newState);
@@ -70,7 +97,6 @@ signals:
     void executionFinished(const QString &output, const QString &error, int exitCode);
 
 private slots:
-    void onCompilationFinished(int exitCode, QProcess::ExitStatus status);
     void onRunFinished(int exitCode, QProcess::ExitStatus status);
     void onRunError(QProcess::ProcessError error);
 
@@ -78,19 +104,31 @@ private:
     void setState(State newState);
     void updateRunButtonForState(State newState);
     void startCompilation();
+    void finishCompilation(const CompileCache::Artifact &artifact);
+    void cancelCompilation();
     void startExecution();
     void cleanupTempDir();
     void updateStatus(const QString &status);
     void updateOutputPanels(bool showOutput, bool showError);
     void clearOutputs();
+    void setOutputText(const QString &text);
+    void setErrorText(const QString &text);
+    void completeRun(const QString &resultStatus);
 
     UiBindings ui_;
+    Outcome outcome_;
     CompilationConfig config_;
+    std::shared_ptr<CompileCache> compileCache_;
     State state_ = State::Idle;
-    QProcess *compilerProcess_;
+    QFutureWatcher<CompileCache::Artifact> *compileWatcher_ = nullptr;
+    std::shared_ptr<std::atomic<bool>> compileCancelled_;
+    CompileCache::Artifact artifact_;  // leased while runs use it
     QProcess *runProcess_;
-    std::unique_ptr<QTemporaryDir> tempDir_;
+    QString pipeInput_;  // written on start when no input file (InputCache) was made
+    std::unique_ptr<QTemporaryDir> tempDir_;  // working directory of the run
     bool stopRequested_ = false;
+    bool batchActive_ = false;
+    bool batchBuilt_ = false;  // artifact_ is the batch's build
     QElapsedTimer runTimer_;
     qint64 lastExecutionTimeMs_ = -1;
     QTimer *timeoutTimer_ = nullptr;
@@ -99,6 +137,25 @@ private:
     QColor iconColor_ = QColor("#d4d4d4");
     QString runProgram_;
     QStringList runArgs_;
+    qint64 runPid_ = 0;  // registered with ProcessRegistry while running
     QColor statusAcColor_{"#2e7d32"};
     QColor statusErrorColor_{"#c42b1c"};
+
+    // Start of the in-flight stages on the trace clock, -1 when not traced
+    qint64 compileStartUs_ = -1;
+    qint64 runStartUs_ = -1;
+    qint64 verdictStartUs_ = -1;
+    QString compileDetail_;
+
+    // Finished run waiting for its verdict; large outputs are compared
+    // against the expected output on a worker thread
+    struct FinishedRun {
+        QString stdOut;
+        QString stdErr;
+        QString effectiveErr;
+        int exitCode = 0;
+    };
+    FinishedRun finishedRun_;
+    QFutureWatcher<bool> *verdictWatcher_ = nullptr;
+    bool verdictPending_ = false;
 };
@@ -0,0 +1,206 @@
+#include "execution/HarnessRunner.h"
+#include "execution/JvmRunner.h"
+#include "execution/ProcessRegistry.h"
+#include "execution/PythonRunner.h"
+
+#include <QElapsedTimer>
+#include <QProcess>
+#include <QtEndian>
+
+#include <algorithm>
+#include <csignal>
+#include <utility>
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr int kStartTimeoutMs = 10000;
+constexpr int kMaxFreshFailures = 2;
+constexpr quint32 kReplyMagic = 0x43464852;  // "CFHR"
+
+void appendBytes(QByteArray &buffer, const QByteArray &bytes) {
+    char length[4];
+    qToBigEndian<quint32>(static_cast<quint32>(bytes.size()), length);
+    buffer.append(length, 4);
+    buffer.append(bytes);
+}
+} // namespace
+
+HarnessRunner::HarnessRunner(QString label)
+    : label_(std::move(label)) {}
+
+HarnessRunner::~HarnessRunner() {
+    stop();
+}
+
+HarnessRunner *HarnessRunner::forArtifact(const CompilationConfig &config,
+                                          const CompileCache::Artifact &artifact,
+                                          QString &location,
+                                          QString &entry) {
+    if (!artifact.ok) {
+        return nullptr;
+    }
+    const QString language = CompilationUtils::normalizeLanguage(config.language);
+    location = artifact.workDir;
+    if (language == "Java" && config.javaPersistentJvm && !artifact.mainClass.isEmpty()) {
+        entry = artifact.mainClass;
+        return &JvmRunner::forThisThread(config);
+    }
+    if (language == "Python" && config.pythonForkServer && !artifact.args.isEmpty()) {
+        entry = artifact.args.last();
+        return &PythonRunner::forThisThread(config);
+    }
+    return nullptr;
+}
+
+bool HarnessRunner::accepts(const QString & /*location*/, QString & /*reason*/) {
+    return true;
+}
+
+bool HarnessRunner::start(QString &error) {
+    QString program;
+    QStringList args;
+    if (!command(extras_, program, args, error)) {
+        return false;
+    }
+
+    process_ = std::make_unique<QProcess>();
+#ifdef Q_OS_UNIX
+    process_->setChildProcessModifier([]() { ::setsid(); });
+#endif
+    process_->setStandardErrorFile(QProcess::nullDevice());
+    process_->start(program, args);
+    if (!process_->waitForStarted(kStartTimeoutMs)) {
+        error = process_->errorString();
+        process_.reset();
+        return false;
+    }
+    buffer_.clear();
+    requests_ = 0;
+    return true;
+}
+
+void HarnessRunner::stop() {
+    if (!process_) {
+        return;
+    }
+    // The group includes anything the harness forked
+#ifdef Q_OS_UNIX
+    const qint64 pid = process_->processId();
+    if (pid > 0) {
+        ::kill(-static_cast<pid_t>(pid), SIGKILL);
+    }
+#endif
+    process_->kill();
+    process_->waitForFinished(1000);
+    process_.reset();
+    buffer_.clear();
+}
+
+HarnessRunner::Result HarnessRunner::run(const QString &location,
+                                         const QString &entry,
+                                         const QByteArray &input,
+                                         int timeoutMs) {
+    if (location == skipLocation_) {
+        Result result;
+        result.error = QString("The %1 harness cannot run this solution").arg(label_);
+        return result;
+    }
+    QString reason;
+    if (!accepts(location, reason)) {
+        Result result;
+        result.error = reason;
+        return result;
+    }
+    for (int attempt = 0;; ++attempt) {
+        Result result;
+        if (!process_ && !start(result.error)) {
+            return result;
+        }
+        const bool fresh = requests_++ == 0;
+        const ProcessRegistry::ChildScope child(process_->processId(), label_);
+
+        QElapsedTimer timer;
+        timer.start();
+        auto remainingMs = [&timer, timeoutMs]() {
+            return timeoutMs > 0 ? std::max<qint64>(timeoutMs - timer.elapsed(), 0) : -1;
+        };
+
+        QByteArray request;
+        appendBytes(request, location.toUtf8());
+        appendBytes(request, entry.toUtf8());
+        appendBytes(request, input);
+        process_->write(request);
+
+        // Blocks until `size` reply bytes are buffered; false on timeout or
+        // when the harness is gone
+        auto fill = [this, &remainingMs, &result](qsizetype size) {
+            while (buffer_.size() < size) {
+                const qint64 remaining = remainingMs();
+                if (remaining == 0) {
+                    result.timedOut = true;
+                    return false;
+                }
+                if (!process_->waitForReadyRead(static_cast<int>(remaining))) {
+                    if (process_->state() == QProcess::Running) {
+                        continue;
+                    }
+                    return false;
+                }
+                buffer_.append(process_->readAllStandardOutput());
+            }
+            return true;
+        };
+        auto takeInt = [this]() {
+            const quint32 value = qFromBigEndian<quint32>(buffer_.constData());
+            buffer_.remove(0, 4);
+            return value;
+        };
+        auto takeBytes = [this, &fill, &takeInt](QByteArray &bytes) {
+            if (!fill(4)) {
+                return false;
+            }
+            const quint32 size = takeInt();
+            if (!fill(static_cast<qsizetype>(size))) {
+                return false;
+            }
+            bytes = buffer_.left(static_cast<qsizetype>(size));
+            buffer_.remove(0, static_cast<qsizetype>(size));
+            return true;
+        };
+
+        bool replied = fill(8) && takeInt() == kReplyMagic;
+        if (replied) {
+            result.exitCode = static_cast<qint32>(takeInt());
+            replied = takeBytes(result.stdOut) && takeBytes(result.stdErr);
+        }
+        result.timeMs = timer.elapsed();
+        if (replied) {
+            result.ok = true;
+            freshFailures_ = 0;
+            return result;
+        }
+        const bool running = process_->state() == QProcess::Running;
+        stop();
+        if (result.timedOut) {
+            result.ok = true;
+            result.stdOut.clear();
+            result.stdErr.clear();
+            return result;
+        }
+        // A harness that dies on its first request may not accept the extras
+        if (fresh && !running && extras_ && attempt == 0) {
+            extras_ = false;
+            continue;
+        }
+        // Dies every time (e.g. a runtime that cannot run the harness);
+        // stop paying for start-ups that never answer
+        if (fresh && ++freshFailures_ >= kMaxFreshFailures) {
+            skipLocation_ = location;
+        }
+        result.error = running ? QString("Unexpected output from the %1 harness").arg(label_)
+                               : QString("The %1 harness exited").arg(label_);
+        return result;
+    }
+}
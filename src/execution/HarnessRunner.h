@@ -0,0 +1,81 @@
+#pragma once
+
+#include "execution/CompilationConfig.h"
+#include "execution/CompileCache.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <memory>
+
+class QProcess;
+
+// A long-lived interpreter or VM that runs one test per request, so tests
+// skip the runtime's start-up. Subclasses say how to start the harness;
+// this class owns the process and the protocol.
+//
+// Request: location, entry point, stdin. Reply: a magic number, the exit
+// code, stdout and stderr. Each field is a big-endian 32-bit length (or
+// value) followed by the bytes.
+//
+// A test that exceeds its time limit kills the harness; the next run()
+// starts a new one. A harness that dies or answers garbage makes run()
+// return !Result::ok, and the caller runs the test the usual way; after a
+// few fresh harnesses in a row die on one solution it is no longer tried.
+//
+// Not thread-safe; QProcess must stay on the thread that created it, so
+// subclasses hand out one runner per thread.
+class HarnessRunner {
+public:
+    struct Result {
+        bool ok = false;  // false: run it the usual way instead
+        bool timedOut = false;
+        int exitCode = 0;
+        QByteArray stdOut;
+        QByteArray stdErr;
+        qint64 timeMs = 0;
+        QString error;  // why the harness gave up
+    };
+
+    virtual ~HarnessRunner();
+
+    HarnessRunner(const HarnessRunner &) = delete;
+    HarnessRunner &operator=(const HarnessRunner &) = delete;
+
+    Result run(const QString &location,
+               const QString &entry,
+               const QByteArray &input,
+               int timeoutMs);
+
+    // The calling thread's runner for `artifact` when `config` enables one
+    // for its language (JvmRunner, PythonRunner), else null; fills in the
+    // location and entry point run() takes
+    static HarnessRunner *forArtifact(const CompilationConfig &config,
+                                      const CompileCache::Artifact &artifact,
+                                      QString &location,
+                                      QString &entry);
+
+protected:
+    explicit HarnessRunner(QString label);
+
+    // How to start the harness, building it first if needed. `extras` are
+    // optional speed-ups the runtime may reject; after a fresh harness dies
+    // they are left out from then on.
+    virtual bool command(bool extras, QString &program, QStringList &args, QString &error) = 0;
+    // Whether the solution at `location` can run in the harness at all;
+    // run() returns !ok without sending one it cannot, with `reason` as the
+    // error
+    virtual bool accepts(const QString &location, QString &reason);
+
+private:
+    bool start(QString &error);
+    void stop();
+
+    QString label_;  // for the resource monitor and errors
+    std::unique_ptr<QProcess> process_;
+    QByteArray buffer_;  // reply bytes read so far
+    int requests_ = 0;   // sent to the current harness
+    bool extras_ = true;
+    int freshFailures_ = 0;  // new harnesses in a row that died without answering
+    QString skipLocation_;   // solution the harness gave up on
+};
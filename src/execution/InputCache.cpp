@@ -0,0 +1,136 @@
+#include "execution/InputCache.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+constexpr qint64 kDefaultMaxBytes = 256LL * 1024 * 1024;
+
+// A hit hands the file to another test, so the key must not collide
+QString contentKey(const QByteArray &input) {
+    return QString("%1-%2").arg(input.size()).arg(QString::fromLatin1(
+        QCryptographicHash::hash(input, QCryptographicHash::Sha256).toHex().left(40)));
+}
+} // namespace
+
+InputCache::InputCache(const QString &parentDirectory)
+    : dir_(std::make_unique<QTemporaryDir>(
+          QDir(parentDirectory).filePath("cfdojo-input-XXXXXX"))),
+      maxBytes_(kDefaultMaxBytes) {}
+
+QString InputCache::defaultParentDirectory() {
+#ifdef Q_OS_LINUX
+    const QFileInfo shm("/dev/shm");
+    if (shm.isDir() && shm.isWritable()) {
+        return shm.filePath();
+    }
+#endif
+    return QStandardPaths::writableLocation(QStandardPaths::TempLocation);
+}
+
+InputCache &InputCache::shared() {
+    static InputCache cache;
+    return cache;
+}
+
+qint64 InputCache::bytes() const {
+    QMutexLocker lock(&mutex_);
+    return totalBytes_;
+}
+
+QString InputCache::file(const QByteArray &input) {
+    if (!dir_->isValid()) {
+        return {};
+    }
+    const QString key = contentKey(input);
+    QMutexLocker lock(&mutex_);
+    auto it = entries_.find(key);
+    // Another thread is writing this input; wait rather than write it twice
+    while (it != entries_.end() && !it->second.written) {
+        written_.wait(&mutex_);
+        it = entries_.find(key);
+    }
+    if (it != entries_.end()) {
+        it->second.lastUsed = ++useClock_;
+        ++it->second.pending;
+        return it->second.path;
+    }
+
+    // Reserved (and pending, so never evicted) while it is written
+    Entry entry;
+    entry.path = dir_->filePath(key);
+    entry.bytes = input.size();
+    entry.lastUsed = ++useClock_;
+    entry.pending = 1;
+    const QString path = entry.path;
+    totalBytes_ += entry.bytes;
+    entries_.emplace(key, std::move(entry));
+    lock.unlock();
+
+    QSaveFile out(path);
+    const bool ok =
+        out.open(QIODevice::WriteOnly) && out.write(input) == input.size() && out.commit();
+
+    lock.relock();
+    it = entries_.find(key);
+    written_.wakeAll();
+    if (!ok) {
+        totalBytes_ -= it->second.bytes;
+        entries_.erase(it);
+        return {};
+    }
+    it->second.written = true;
+    evict();
+    return path;
+}
+
+void InputCache::release(const QString &path) {
+    if (path.isEmpty()) {
+        return;
+    }
+    QMutexLocker lock(&mutex_);
+    const auto it = entries_.find(QFileInfo(path).fileName());
+    if (it == entries_.end() || it->second.pending == 0) {
+        return;
+    }
+    --it->second.pending;
+    // Over budget only while files were pending
+    evict();
+}
+
+void InputCache::evict() {
+    if (totalBytes_ <= maxBytes_) {
+        return;
+    }
+    std::vector<std::map<QString, Entry>::iterator> byAge;
+    byAge.reserve(entries_.size());
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        byAge.push_back(it);
+    }
+    std::sort(byAge.begin(), byAge.end(), [](const auto &a, const auto &b) {
+        return a->second.lastUsed < b->second.lastUsed;
+    });
+    for (const auto &it : byAge) {
+        if (totalBytes_ <= maxBytes_) {
+            break;
+        }
+        // A child may be about to open it
+        if (it->second.pending > 0) {
+            continue;
+        }
+        // Children that already opened it keep reading it; where an open
+        // file cannot be removed (Windows) it stays until a later pass
+        if (!QFile::remove(it->second.path)) {
+            continue;
+        }
+        totalBytes_ -= it->second.bytes;
+        entries_.erase(it);
+    }
+}
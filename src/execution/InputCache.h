@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+#include <QTemporaryDir>
+#include <QWaitCondition>
+#include <map>
+#include <memory>
+
+// Test inputs written once as files and attached to children with
+// QProcess::setStandardInputFile, instead of being pushed through a pipe
+// on every run. The child gets a regular file as stdin, so it never waits
+// on the parent and fast readers may fstat() or mmap() it.
+//
+// Files are content-addressed (length and SHA-256), so every engine running
+// the same input shares one file. A file is written outside the cache's
+// lock, so a large input never holds up lookups of other tests; requests
+// for an input that is being written wait for it. On Linux they live in /dev/shm (memory, like a memfd,
+// but with a path QProcess can open). The directory belongs to this
+// process and is removed with the cache.
+//
+// The byte budget is enforced: past it the least recently used files are
+// dropped. The only files spared are those handed out by file() and not yet
+// release()d, i.e. whose child has not opened them yet, so the budget is
+// exceeded by at most the inputs of the children being started right now.
+// Children that already opened a dropped file keep reading it (Unix); a
+// later run of the same input writes it again.
+//
+// Thread-safe.
+class InputCache {
+public:
+    explicit InputCache(const QString &parentDirectory = defaultParentDirectory());
+
+    InputCache(const InputCache &) = delete;
+    InputCache &operator=(const InputCache &) = delete;
+
+    // /dev/shm when available, else the temp location
+    static QString defaultParentDirectory();
+
+    // The one every engine uses; lives until the process exits
+    static InputCache &shared();
+
+    // A file holding `input`, written on first use; empty when it cannot
+    // be written (callers then write the input themselves). It is kept
+    // until release(), which callers do once QProcess::start() returned:
+    // the child has its own descriptor by then.
+    QString file(const QByteArray &input);
+    void release(const QString &path);
+
+    void setMaxBytes(qint64 bytes) { maxBytes_ = bytes; }
+    qint64 bytes() const;
+
+private:
+    struct Entry {
+        QString path;
+        qint64 bytes = 0;
+        quint64 lastUsed = 0;  // useClock_ at the last file()
+        int pending = 0;  // handed out, not released yet
+        bool written = false;  // false while its first file() writes it
+    };
+
+    void evict();  // with mutex_ held
+
+    std::unique_ptr<QTemporaryDir> dir_;
+    qint64 maxBytes_;
+    mutable QMutex mutex_;
+    QWaitCondition written_;  // an entry was written, or given up on
+    std::map<QString, Entry> entries_;  // by content key
+    qint64 totalBytes_ = 0;
+    quint64 useClock_ = 0;
+};
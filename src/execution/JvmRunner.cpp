@@ -0,0 +1,190 @@
+#include "execution/JvmRunner.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QStandardPaths>
+
+namespace {
+// Reads requests on stdin and answers on stdout; see HarnessRunner
+constexpr const char *kHarnessSource = R"java(
+import java.io.*;
+import java.lang.reflect.*;
+import java.net.*;
+import java.nio.charset.StandardCharsets;
+import java.util.*;
+
+public class JvmRunner {
+    private static final int MAGIC = 0x43464852;
+
+    private static byte[] readBytes(DataInputStream in) throws IOException {
+        byte[] bytes = new byte[in.readInt()];
+        in.readFully(bytes);
+        return bytes;
+    }
+
+    private static void writeBytes(DataOutputStream out, byte[] bytes) throws IOException {
+        out.writeInt(bytes.length);
+        out.write(bytes);
+    }
+
+    public static void main(String[] args) throws Exception {
+        DataInputStream in = new DataInputStream(
+            new BufferedInputStream(new FileInputStream(FileDescriptor.in)));
+        DataOutputStream out = new DataOutputStream(
+            new BufferedOutputStream(new FileOutputStream(FileDescriptor.out)));
+        // Solutions see the platform classes only, never the harness
+        ClassLoader parent = ClassLoader.getSystemClassLoader().getParent();
+        for (;;) {
+            String classPath;
+            String mainClass;
+            byte[] input;
+            try {
+                classPath = new String(readBytes(in), StandardCharsets.UTF_8);
+                mainClass = new String(readBytes(in), StandardCharsets.UTF_8);
+                input = readBytes(in);
+            } catch (EOFException e) {
+                return;
+            }
+
+            ByteArrayOutputStream stdout = new ByteArrayOutputStream();
+            ByteArrayOutputStream stderr = new ByteArrayOutputStream();
+            PrintStream err = new PrintStream(stderr, true, "UTF-8");
+            System.setIn(new ByteArrayInputStream(input));
+            System.setOut(new PrintStream(stdout, false, "UTF-8"));
+            System.setErr(err);
+
+            Set<Thread> before = new HashSet<>(Thread.getAllStackTraces().keySet());
+            int exitCode = 0;
+            try (URLClassLoader loader = new URLClassLoader(
+                     new URL[] {new File(classPath).toURI().toURL()}, parent)) {
+                Method main = Class.forName(mainClass, true, loader)
+                                  .getMethod("main", String[].class);
+                main.invoke(null, (Object) new String[0]);
+                // Like the JVM, wait for threads main started (e.g. a big-stack
+                // thread for deep recursion)
+                for (Thread thread : Thread.getAllStackTraces().keySet()) {
+                    if (!before.contains(thread) && !thread.isDaemon()) {
+                        thread.join();
+                    }
+                }
+            } catch (InvocationTargetException e) {
+                err.print("Exception in thread \"main\" ");
+                e.getCause().printStackTrace(err);
+                exitCode = 1;
+            } catch (Throwable e) {
+                e.printStackTrace(err);
+                exitCode = 1;
+            }
+            System.out.flush();
+            err.flush();
+
+            out.writeInt(MAGIC);
+            out.writeInt(exitCode);
+            writeBytes(out, stdout.toByteArray());
+            writeBytes(out, stderr.toByteArray());
+            out.flush();
+        }
+    }
+}
+)java";
+
+// Shared by every runner; the harness is compiled once per JDK
+CompileCache &harnessCache() {
+    static CompileCache cache;
+    return cache;
+}
+
+// CDS archive for one harness build run by one JVM. Kept out of the compile
+// cache: its entries are read-only and keyed by content, and the archive is
+// written by the JVM whenever it goes stale.
+QString sharedArchivePath(const QByteArray &harnessKey,
+                          const QString &javaPath,
+                          const QStringList &javaArgs) {
+    const QDir dir(QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation))
+                       .filePath("cds"));
+    QDir().mkpath(dir.path());
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(harnessKey);
+    hash.addData(javaPath.toUtf8());
+    hash.addData(javaArgs.join(QChar('\0')).toUtf8());
+    return dir.filePath(QString::fromLatin1(hash.result().toHex().left(32)) + ".jsa");
+}
+
+// Names in a class file's constant pool that reach the process's stdin or
+// stdout around System.in/out, which only the harness may use
+bool usesOwnStreams(const QString &location) {
+    QDirIterator it(location, {QStringLiteral("*.class")}, QDir::Files,
+                    QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        QFile file(it.next());
+        if (!file.open(QIODevice::ReadOnly)) {
+            continue;
+        }
+        const QByteArray bytes = file.readAll();
+        if (bytes.contains("java/io/FileDescriptor") || bytes.contains("/dev/stdin") ||
+            bytes.contains("/dev/stdout") || bytes.contains("/proc/self/fd")) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QString javaPath(const CompilationConfig &config) {
+    return config.javaRunPath.trimmed().isEmpty() ? QStringLiteral("java")
+                                                  : config.javaRunPath.trimmed();
+}
+} // namespace
+
+JvmRunner::JvmRunner(const CompilationConfig &config)
+    : HarnessRunner("JVM"),
+      javaPath_(javaPath(config)),
+      javaArgs_(CompilationUtils::splitArgs(config.javaArgs)) {
+    harnessConfig_.language = "Java";
+    harnessConfig_.javaCompilerPath = config.javaCompilerPath;
+    harnessConfig_.javaRunPath = config.javaRunPath;
+    harnessConfig_.transcludeTemplate = false;
+}
+
+JvmRunner &JvmRunner::forThisThread(const CompilationConfig &config) {
+    thread_local std::unique_ptr<JvmRunner> runner;
+    if (!runner || runner->javaPath_ != javaPath(config) ||
+        runner->javaArgs_ != CompilationUtils::splitArgs(config.javaArgs) ||
+        runner->harnessConfig_.javaCompilerPath != config.javaCompilerPath) {
+        runner = std::make_unique<JvmRunner>(config);
+    }
+    return *runner;
+}
+
+bool JvmRunner::command(bool extras, QString &program, QStringList &args, QString &error) {
+    if (!harness_.ok) {
+        harness_ = harnessCache().get(QString::fromUtf8(kHarnessSource), harnessConfig_);
+        if (!harness_.ok) {
+            error = "Failed to build the JVM harness:\n" + harness_.error;
+            return false;
+        }
+    }
+    program = javaPath_;
+    args.clear();
+    if (extras) {
+        // CDS archive; JDK 19+ maintains it itself, older JDKs ignore the flags
+        args << "-XX:+IgnoreUnrecognizedVMOptions" << "-XX:+AutoCreateSharedArchive"
+             << "-XX:SharedArchiveFile=" +
+                    sharedArchivePath(harness_.key, javaPath_, javaArgs_);
+    }
+    args << javaArgs_ << "-cp" << harness_.workDir << harness_.mainClass;
+    return true;
+}
+
+bool JvmRunner::accepts(const QString &location, QString &reason) {
+    auto it = ownStreams_.find(location);
+    if (it == ownStreams_.end()) {
+        it = ownStreams_.emplace(location, usesOwnStreams(location)).first;
+    }
+    if (it->second) {
+        reason = "The solution uses the process's own streams";
+        return false;
+    }
+    return true;
+}
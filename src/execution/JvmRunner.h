@@ -0,0 +1,41 @@
+#pragma once
+
+#include "execution/CompilationConfig.h"
+#include "execution/CompileCache.h"
+#include "execution/HarnessRunner.h"
+
+#include <QString>
+#include <QStringList>
+#include <map>
+
+// Runs compiled Java solutions inside a long-lived JVM instead of starting
+// `java` for every test. The harness class loads each solution in a fresh
+// class loader (so statics start clean) and calls main with System.in/out/
+// err redirected to buffers; run() takes the classpath and the main class.
+// The harness JVM keeps a CDS archive under <cache location>/cds so even its
+// own cold start is quicker.
+//
+// Unlike a fresh JVM, System.exit ends the harness, which makes run()
+// return !ok. Solutions whose classes use the process's own streams
+// (FileDescriptor.in/out, /dev/stdin) would read the harness's requests or
+// corrupt its replies, so they are never sent to it: run() returns !ok and
+// they run in a fresh JVM.
+class JvmRunner : public HarnessRunner {
+public:
+    explicit JvmRunner(const CompilationConfig &config);
+
+    // The calling thread's runner, replaced when the Java settings change;
+    // it lives (and keeps its JVM) until the thread exits
+    static JvmRunner &forThisThread(const CompilationConfig &config);
+
+protected:
+    bool command(bool extras, QString &program, QStringList &args, QString &error) override;
+    bool accepts(const QString &location, QString &reason) override;
+
+private:
+    QString javaPath_;
+    QStringList javaArgs_;
+    CompilationConfig harnessConfig_;
+    CompileCache::Artifact harness_;  // leased while the runner lives
+    std::map<QString, bool> ownStreams_;  // by location: classes use the process's streams
+};
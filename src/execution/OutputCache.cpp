@@ -0,0 +1,123 @@
+#include "execution/OutputCache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+constexpr qint64 kDefaultMaxBytes = 256LL * 1024 * 1024;
+// Scanning the directory is not free, so evict() waits for this share of
+// the budget to be stored since its last pass
+constexpr qint64 kEvictEvery = 16;
+} // namespace
+
+OutputCache::OutputCache(const QString &directory)
+    : directory_(directory),
+      maxBytes_(kDefaultMaxBytes),
+      // The first store checks whatever earlier sessions left behind
+      storedSinceEvict_(kDefaultMaxBytes) {}
+
+QString OutputCache::defaultDirectory() {
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation))
+        .filePath("outputs");
+}
+
+QString OutputCache::path(const QByteArray &program, const QByteArray &input) const {
+    const QByteArray hash =
+        QCryptographicHash::hash(input, QCryptographicHash::Sha256).toHex().left(32);
+    return QDir(directory_).filePath(QString::fromLatin1(program + '/' + hash));
+}
+
+bool OutputCache::find(const QByteArray &program,
+                       const QByteArray &input,
+                       QByteArray &output) const {
+    if (program.isEmpty()) {
+        return false;
+    }
+    QFile file(path(program, input));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    output = file.readAll();
+    // The mtime is the entry's last use for eviction
+    file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    return true;
+}
+
+void OutputCache::store(const QByteArray &program,
+                        const QByteArray &input,
+                        const QByteArray &output) {
+    if (program.isEmpty()) {
+        return;
+    }
+    const QString target = path(program, input);
+    if (!QDir().mkpath(QFileInfo(target).path())) {
+        return;
+    }
+    QSaveFile file(target);
+    if (!file.open(QIODevice::WriteOnly) || file.write(output) != output.size() ||
+        !file.commit()) {
+        return;
+    }
+
+    const qint64 threshold = std::max<qint64>(maxBytes_ / kEvictEvery, 1);
+    const qint64 size = output.size() + 1;  // empty outputs still cost an inode
+    if (storedSinceEvict_.fetch_add(size) + size >= threshold &&
+        storedSinceEvict_.exchange(0) >= threshold) {
+        evict();
+    }
+}
+
+int OutputCache::evict() {
+    struct Entry {
+        QString path;
+        QDateTime lastUsed;
+        qint64 bytes = 0;
+    };
+    std::vector<Entry> entries;
+    qint64 total = 0;
+    QDirIterator it(directory_, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        const QFileInfo info = it.fileInfo();
+        Entry entry;
+        entry.path = info.filePath();
+        entry.lastUsed = info.lastModified();
+        entry.bytes = info.size();
+        total += entry.bytes;
+        entries.push_back(std::move(entry));
+    }
+    if (total <= maxBytes_) {
+        return 0;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+        return a.lastUsed < b.lastUsed;
+    });
+    int removed = 0;
+    for (const Entry &entry : entries) {
+        if (total <= maxBytes_) {
+            break;
+        }
+        // A reader that already opened it keeps its copy
+        if (!QFile::remove(entry.path)) {
+            continue;
+        }
+        total -= entry.bytes;
+        ++removed;
+    }
+    // Brutes with nothing left; rmdir leaves the ones still in use alone
+    const QFileInfoList dirs = QDir(directory_).entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QFileInfo &dir : dirs) {
+        QDir(directory_).rmdir(dir.fileName());
+    }
+    return removed;
+}
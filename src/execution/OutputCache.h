@@ -0,0 +1,47 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <atomic>
+
+// Brute force outputs kept on disk, keyed by the brute's compile cache key
+// and a hash of the input. Brutes are the slow side of a stress test, and
+// they are deterministic by assumption: rerunning a campaign with the same
+// seeds after fixing the solution, or filling in expected outputs for the
+// same tests again, reads the outputs back instead of recomputing them.
+//
+// Entries live in <directory>/<brute key>/<input hash>, written with
+// QSaveFile so readers never see half an output. Only runs that exited
+// cleanly are stored. A hit refreshes the entry's mtime; once the cache
+// outgrows its budget the least recently used outputs are removed.
+//
+// Thread-safe, and safe to share between processes.
+class OutputCache {
+public:
+    explicit OutputCache(const QString &directory = defaultDirectory());
+
+    OutputCache(const OutputCache &) = delete;
+    OutputCache &operator=(const OutputCache &) = delete;
+
+    // <cache location>/outputs
+    static QString defaultDirectory();
+
+    // `program` is CompileCache::Artifact::key
+    bool find(const QByteArray &program, const QByteArray &input, QByteArray &output) const;
+    void store(const QByteArray &program, const QByteArray &input, const QByteArray &output);
+
+    // Soft limit on the size of all outputs together
+    void setMaxBytes(qint64 bytes) { maxBytes_ = bytes; }
+    qint64 maxBytes() const { return maxBytes_; }
+
+    // Removes least recently used outputs until the cache fits its budget;
+    // returns how many were removed. Runs after every few stores.
+    int evict();
+
+private:
+    QString path(const QByteArray &program, const QByteArray &input) const;
+
+    QString directory_;
+    std::atomic<qint64> maxBytes_;
+    std::atomic<qint64> storedSinceEvict_{-1};  // -1: not scanned this session
+};
@@ -1,20 +1,28 @@
 #include "execution/ParallelExecutor.h"
 #include "execution/CompilationUtils.h"
+#include "execution/CompileCache.h"
+#include "execution/HarnessRunner.h"
+#include "execution/InputCache.h"
+#include "execution/ProcessRegistry.h"
+#include "execution/Trace.h"
+#include "file/TimingHistory.h"
 
-#include <QDir>
 #include <QElapsedTimer>
-#include <QFile>
 #include <QProcess>
 #include <QList>
 #include <QRegularExpression>
-#include <QStringConverter>
 #include <QTemporaryDir>
-#include <QTextStream>
 #include <QtConcurrent>
 #include <csignal>
 
+namespace {
+// Sanitized builds run several times slower than the optimized one
+constexpr int kDiagnosticTimeoutFactor = 3;
+} // namespace
+
 ParallelExecutor::ParallelExecutor(QObject *parent)
     : QObject(parent),
+      compileCache_(std::make_shared<CompileCache>()),
       watcher_(new QFutureWatcher<TestResult>(this)) {
     
     connect(watcher_, &QFutureWatcher<TestResult>::resultReadyAt,
@@ -35,6 +43,11 @@ ParallelExecutor::ParallelExecutor(QObject *parent)
         if (!cancelled_) {
             emit allTestsFinished(results_);
         }
+        Trace::complete("run all", runAllStartUs_);
+        // Tests skipped by cancel() never left the queue
+        ProcessRegistry::addQueued(-queuedTests_.exchange(0));
+        artifact_ = CompileCache::Artifact();
+        diagnosticBuild_ = QFuture<CompileCache::Artifact>();
         running_ = false;
     });
 }
@@ -58,6 +71,7 @@ void ParallelExecutor::runAll(const std::vector<TestInput> &tests) {
     
     running_ = true;
     cancelled_ = false;
+    runAllStartUs_ = Trace::now();
     
     emit compilationStarted();
     
@@ -79,8 +93,11 @@ void ParallelExecutor::runAll(const std::vector<TestInput> &tests) {
         const QStringList snapshotRunArgs = runArgs_;
         const QString snapshotTempPath = tempDir_ ? tempDir_->path() : QString();
         const int snapshotTimeoutMs = timeoutMs_;
+        const CompilationConfig snapshotConfig = config_;
+        const CompileCache::Artifact snapshotArtifact = artifact_;
+        const QFuture<CompileCache::Artifact> snapshotDiagnosticBuild = diagnosticBuild_;
 
-        QMetaObject::invokeMethod(this, [this, testsCopy, snapshotRunProgram, snapshotRunArgs, snapshotTempPath, snapshotTimeoutMs]() {
+        QMetaObject::invokeMethod(this, [this, testsCopy, snapshotRunProgram, snapshotRunArgs, snapshotTempPath, snapshotTimeoutMs, snapshotConfig, snapshotArtifact, snapshotDiagnosticBuild]() {
             emit compilationFinished(true, QString());
 
             // Run tests in parallel using QtConcurrent
@@ -88,15 +105,29 @@ void ParallelExecutor::runAll(const std::vector<TestInput> &tests) {
             expectedResults_ = static_cast<int>(testsCopy.size());
             results_.assign(static_cast<size_t>(expectedResults_), TestResult{});
 
+            queuedTests_ = expectedResults_;
+            ProcessRegistry::addQueued(expectedResults_);
             auto future = QtConcurrent::mapped(testList,
-                [this, snapshotRunProgram, snapshotRunArgs, snapshotTempPath, snapshotTimeoutMs](const TestInput &test) -> TestResult {
+                [this, snapshotRunProgram, snapshotRunArgs, snapshotTempPath, snapshotTimeoutMs, snapshotConfig, snapshotArtifact, snapshotDiagnosticBuild](const TestInput &test) -> TestResult {
+                    ProcessRegistry::WorkerScope worker;
+                    --queuedTests_;
                     if (cancelled_) {
                         TestResult r;
                         r.testIndex = test.testIndex;
                         r.error = "Cancelled";
                         return r;
                     }
-                    return runSingleTest(test, snapshotRunProgram, snapshotRunArgs, snapshotTempPath, snapshotTimeoutMs);
+                    TestResult result;
+                    if (!runSingleTestInHarness(test, snapshotConfig, snapshotArtifact,
+                                                snapshotTimeoutMs, result)) {
+                        result = runSingleTest(test, snapshotRunProgram, snapshotRunArgs, snapshotTempPath, snapshotTimeoutMs);
+                    }
+                    if (result.runtimeError && !cancelled_) {
+                        rerunWithDiagnostics(test, snapshotDiagnosticBuild, snapshotTempPath,
+                                             snapshotTimeoutMs, result);
+                    }
+                    result.inputKey = TimingHistory::hash(test.input);
+                    return result;
                 });
             watcher_->setFuture(future);
         }, Qt::QueuedConnection);
@@ -104,97 +135,49 @@ void ParallelExecutor::runAll(const std::vector<TestInput> &tests) {
 }
 
 bool ParallelExecutor::compile() {
-    // Create temp directory
+    Trace::Span span("prepare");
+
+    // Working directory of the tests
+    const qint64 tempDirStart = Trace::now();
     tempDir_ = std::make_unique<QTemporaryDir>();
+    Trace::complete("create temp dir", tempDirStart);
     if (!tempDir_->isValid()) {
         QMetaObject::invokeMethod(this, [this]() {
             emit compilationFinished(false, "Failed to create temporary directory");
         }, Qt::QueuedConnection);
         return false;
     }
-    
-    const QString tempPath = tempDir_->path();
-    const QString code = CompilationUtils::applyTransclusion(
-        config_.templateCode, sourceCode_, config_.transcludeTemplate);
-    const QString language = CompilationUtils::normalizeLanguage(config_.language);
-    const QString sourceExt = language == "Python" ? "py"
-                           : language == "Java"   ? "java"
-                                                   : "cpp";
-    const QString sourceBaseName =
-        language == "Java" ? CompilationUtils::detectJavaMainClass(code) : "solution";
-    const QString sourcePath =
-        QDir(tempPath).filePath(QString("%1.%2").arg(sourceBaseName, sourceExt));
-#ifdef Q_OS_WIN
-    executablePath_ = QDir(tempPath).filePath("solution.exe");
-#else
-    executablePath_ = QDir(tempPath).filePath("solution");
-#endif
 
     runProgram_.clear();
     runArgs_.clear();
 
-    QFile file(sourcePath);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QMetaObject::invokeMethod(this, [this]() {
-            emit compilationFinished(false, "Failed to write source file");
-        }, Qt::QueuedConnection);
-        return false;
+    // Only waited for when a test fails, so passing runs never pay for it
+    diagnosticBuild_ = QFuture<CompileCache::Artifact>();
+    if (CompilationUtils::normalizeLanguage(config_.language) == "C++" &&
+        !config_.cppDiagnosticFlags.trimmed().isEmpty()) {
+        CompilationConfig diagnosticConfig = config_;
+        diagnosticConfig.cppCompilerFlags = config_.cppDiagnosticFlags;
+        diagnosticBuild_ = QtConcurrent::run(&diagnosticPool_,
+            [cache = compileCache_, source = sourceCode_, diagnosticConfig]() {
+                return cache->get(source, diagnosticConfig);
+            });
     }
-    
-    QTextStream out(&file);
-    out.setEncoding(QStringConverter::Utf8);
-    out << code;
-    file.close();
-    
-    if (language == "Python") {
-#ifdef Q_OS_WIN
-        const QString defaultPython = "python";
-#else
-        const QString defaultPython = "python3";
-#endif
-        runProgram_ = config_.pythonPath.trimmed().isEmpty() ? defaultPython : config_.pythonPath.trimmed();
-        runArgs_ = CompilationUtils::splitArgs(config_.pythonArgs);
-        runArgs_ << sourcePath;
-        return true;
-    }
-
-    QProcess compiler;
-    compiler.setWorkingDirectory(tempPath);
 
-    if (language == "Java") {
-        const QString javacPath =
-            config_.javaCompilerPath.trimmed().isEmpty() ? "javac" : config_.javaCompilerPath.trimmed();
-        compiler.start(javacPath, {sourcePath});
-    } else {
-        QStringList args = CompilationUtils::splitArgs(config_.cppCompilerFlags);
-        args << sourcePath << "-o" << executablePath_;
-        const QString compilerPath =
-            config_.cppCompilerPath.trimmed().isEmpty() ? "g++" : config_.cppCompilerPath.trimmed();
-        compiler.start(compilerPath, args);
-    }
-    if (!compiler.waitForFinished(30000)) {
-        QMetaObject::invokeMethod(this, [this]() {
-            emit compilationFinished(false, "Compilation timed out");
-        }, Qt::QueuedConnection);
-        return false;
-    }
-    
-    if (compiler.exitCode() != 0) {
-        const QString error = QString::fromUtf8(compiler.readAllStandardError());
+    // Shared with Run and stress, so this is usually a lookup
+    const qint64 compileStart = Trace::now();
+    artifact_ = compileCache_->get(sourceCode_, config_);
+    Trace::complete("compile", compileStart,
+                    artifact_.cached ? QStringLiteral("cached")
+                                     : CompilationUtils::normalizeLanguage(config_.language));
+    if (!artifact_.ok) {
+        const QString error = artifact_.error;
         QMetaObject::invokeMethod(this, [this, error]() {
             emit compilationFinished(false, error);
         }, Qt::QueuedConnection);
         return false;
     }
-    
-    if (language == "Java") {
-        runProgram_ = config_.javaRunPath.trimmed().isEmpty() ? "java" : config_.javaRunPath.trimmed();
-        runArgs_ = CompilationUtils::splitArgs(config_.javaArgs);
-        runArgs_ << "-cp" << tempPath << sourceBaseName;
-    } else {
-        runProgram_ = executablePath_;
-    }
-
+    runProgram_ = artifact_.program;
+    runArgs_ = artifact_.args;
     return true;
 }
 
@@ -205,6 +188,8 @@ TestResult ParallelExecutor::runSingleTest(const TestInput &test,
                                            int timeoutMs) {
     TestResult result;
     result.testIndex = test.testIndex;
+    Trace::Span span("test", Trace::isEnabled()
+        ? QString("TC %1").arg(test.testIndex + 1) : QString());
     
     QElapsedTimer timer;
     timer.start();
@@ -215,22 +200,42 @@ TestResult ParallelExecutor::runSingleTest(const TestInput &test,
         return result;
     }
 
+    // Written once per distinct input; reruns attach the same file
+    qint64 stageStart = Trace::now();
+    const QString inputFile = InputCache::shared().file(test.input);
+    Trace::complete("stdin file", stageStart);
+
+    stageStart = Trace::now();
     QProcess process;
     process.setWorkingDirectory(workDir);
+    if (!inputFile.isEmpty()) {
+        process.setStandardInputFile(inputFile);
+    }
     process.start(program, args);
+    // The child holds its own descriptor now (or never will)
+    InputCache::shared().release(inputFile);
     
     if (!process.waitForStarted(1000)) {
         result.error = "Failed to start process";
         result.exitCode = -1;
         return result;
     }
+    Trace::complete("spawn", stageStart);
+    const ProcessRegistry::ChildScope child(process.processId(),
+                                            QString("TC %1").arg(test.testIndex + 1));
     
-    // Send input
-    process.write(test.input.toUtf8());
-    process.closeWriteChannel();
+    if (inputFile.isEmpty()) {
+        stageStart = Trace::now();
+        process.write(test.input);
+        process.closeWriteChannel();
+        Trace::complete("write stdin", stageStart);
+    }
     
     // Wait for completion with timeout
-    if (!process.waitForFinished(timeoutMs)) {
+    stageStart = Trace::now();
+    const bool finished = process.waitForFinished(timeoutMs);
+    Trace::complete("wait", stageStart);
+    if (!finished) {
         // Kill the entire process group to avoid orphans
 #ifdef Q_OS_UNIX
         const qint64 childPid = process.processId();
@@ -248,17 +253,88 @@ TestResult ParallelExecutor::runSingleTest(const TestInput &test,
     
     result.executionTimeMs = timer.elapsed();
     result.exitCode = process.exitCode();
-    result.output = QString::fromUtf8(process.readAllStandardOutput());
-    result.error = QString::fromUtf8(process.readAllStandardError());
+    result.runtimeError =
+        process.exitStatus() == QProcess::CrashExit || result.exitCode != 0;
+    stageStart = Trace::now();
+    result.output = process.readAllStandardOutput();
+    result.error = process.readAllStandardError();
+    Trace::complete("read output", stageStart);
     
     // Check if output matches expected
     if (result.exitCode == 0) {
-        result.passed = (CompilationUtils::normalizeText(result.output) == CompilationUtils::normalizeText(test.expectedOutput));
+        Trace::Span judgeSpan("normalize");
+        result.passed = CompilationUtils::sameOutput(result.output, test.expectedOutput);
     }
     
     return result;
 }
 
+bool ParallelExecutor::runSingleTestInHarness(const TestInput &test,
+                                              const CompilationConfig &config,
+                                              const CompileCache::Artifact &artifact,
+                                              int timeoutMs,
+                                              TestResult &result) {
+    QString location;
+    QString entry;
+    HarnessRunner *runner = HarnessRunner::forArtifact(config, artifact, location, entry);
+    if (!runner) {
+        return false;
+    }
+    Trace::Span span("test", Trace::isEnabled()
+        ? QString("TC %1 (warm)").arg(test.testIndex + 1) : QString());
+    const HarnessRunner::Result run =
+        runner->run(location, entry, test.input, timeoutMs);
+    if (!run.ok) {
+        return false;
+    }
+
+    result = TestResult();
+    result.testIndex = test.testIndex;
+    result.executionTimeMs = run.timeMs;
+    if (run.timedOut) {
+        result.error = "Time Limit Exceeded";
+        result.exitCode = -1;
+        return true;
+    }
+    result.exitCode = run.exitCode;
+    result.runtimeError = run.exitCode != 0;
+    result.output = run.stdOut;
+    result.error = run.stdErr;
+    if (result.exitCode == 0) {
+        Trace::Span judgeSpan("normalize");
+        result.passed = CompilationUtils::sameOutput(result.output, test.expectedOutput);
+    }
+    return true;
+}
+
+void ParallelExecutor::rerunWithDiagnostics(const TestInput &test,
+                                            QFuture<CompileCache::Artifact> build,
+                                            const QString &workDir,
+                                            int timeoutMs,
+                                            TestResult &result) {
+    // Only the program's own failures: a timeout would only time out again,
+    // slower, and a test that never started or was stopped says nothing
+    if (!build.isValid() || !result.runtimeError) {
+        return;
+    }
+    const CompileCache::Artifact diagnostic = build.result();
+    if (!diagnostic.ok) {
+        return;
+    }
+
+    Trace::Span span("diagnostic rerun", Trace::isEnabled()
+        ? QString("TC %1").arg(test.testIndex + 1) : QString());
+    const TestResult rerun = runSingleTest(test, diagnostic.program, diagnostic.args, workDir,
+                                           timeoutMs > 0 ? timeoutMs * kDiagnosticTimeoutFactor
+                                                         : timeoutMs);
+    result.sanitizerReport = CompilationUtils::sanitizerReport(QString::fromUtf8(rerun.error));
+    if (result.sanitizerReport.isEmpty() && rerun.passed) {
+        // Typical of undefined behaviour the sanitizers cannot see
+        result.sanitizerReport =
+            "No sanitizer findings, but the diagnostic build passes this test.";
+    }
+}
+
 void ParallelExecutor::cancel() {
     cancelled_ = true;
     if (watcher_ && watcher_->isRunning()) {
@@ -1,12 +1,15 @@
 #pragma once
 
 #include "execution/CompilationConfig.h"
+#include "execution/CompileCache.h"
 
+#include <QByteArray>
 #include <QObject>
 #include <QFuture>
 #include <QFutureWatcher>
 #include <QProcess>
 #include <QTemporaryDir>
+#include <QThreadPool>
 #include <QStringList>
 #include <atomic>
 #include <memory>
@@ -14,21 +17,32 @@
 
 class QsciScintilla;
 
-// Result of a single test case execution
+// Result of a single test case execution. Output stays the child's raw
+// UTF-8; decode it (QString::fromUtf8) only to display it.
 struct TestResult {
     int testIndex = -1;
-    QString output;
-    QString error;
+    QByteArray output;
+    QByteArray error;  // stderr, or why the test did not run
     int exitCode = -1;
     bool passed = false;
+    // The program ran and ended on its own with a non-zero exit or a crash;
+    // not set for timeouts, failures to start or cancelled tests
+    bool runtimeError = false;
     qint64 executionTimeMs = 0;
+    // Sanitizer output from rerunning a runtime error with the diagnostic
+    // build (CompilationConfig::cppDiagnosticFlags)
+    QString sanitizerReport;
+    // TimingHistory::hash of the input, taken on the worker so the GUI
+    // thread never hashes large inputs
+    quint64 inputKey = 0;
 };
 
-// Input for a single test case
+// Input for a single test case, as UTF-8; encode once when building the
+// list, and every run shares the bytes
 struct TestInput {
     int testIndex = -1;
-    QString input;
-    QString expectedOutput;
+    QByteArray input;
+    QByteArray expectedOutput;
 };
 
 class ParallelExecutor : public QObject {
@@ -44,6 +58,8 @@ public:
     // Set all compilation settings at once
     void setConfig(const CompilationConfig &cfg) { config_ = cfg; }
     const CompilationConfig &config() const { return config_; }
+    // Where the solution is built; shared with Run and stress
+    void setCompileCache(std::shared_ptr<CompileCache> cache) { compileCache_ = std::move(cache); }
 
     void setTimeout(int ms) { timeoutMs_ = ms; }
 
@@ -56,6 +72,27 @@ public:
     // Cancel execution
     void cancel();
 
+    // Run one compiled test and judge its output; blocking, thread-safe
+    static TestResult runSingleTest(const TestInput &test,
+                                    const QString &program,
+                                    const QStringList &args,
+                                    const QString &workDir,
+                                    int timeoutMs);
+    // Same in this thread's warm JVM or Python fork server when `config`
+    // enables one; false when runSingleTest() should run it instead
+    static bool runSingleTestInHarness(const TestInput &test,
+                                       const CompilationConfig &config,
+                                       const CompileCache::Artifact &artifact,
+                                       int timeoutMs,
+                                       TestResult &result);
+    // Reruns a runtime error with the diagnostic build, waiting for it to
+    // finish compiling, and fills in result.sanitizerReport
+    static void rerunWithDiagnostics(const TestInput &test,
+                                     QFuture<CompileCache::Artifact> build,
+                                     const QString &workDir,
+                                     int timeoutMs,
+                                     TestResult &result);
+
 signals:
     void compilationStarted();
     void compilationFinished(bool success, const QString &error);
@@ -64,25 +101,27 @@ signals:
 
 private:
     bool compile();
-    TestResult runSingleTest(const TestInput &test,
-                             const QString &program,
-                             const QStringList &args,
-                             const QString &workDir,
-                             int timeoutMs);
 
     CompilationConfig config_;
+    std::shared_ptr<CompileCache> compileCache_;
     QString sourceCode_;
     int timeoutMs_ = 5000;
     
-    std::unique_ptr<QTemporaryDir> tempDir_;
-    QString executablePath_;
+    std::unique_ptr<QTemporaryDir> tempDir_;  // working directory of the tests
+    CompileCache::Artifact artifact_;         // leased until the tests finish
+    // Compiled alongside artifact_ on its own pool, so a test waiting for it
+    // never starves the build of a thread
+    QThreadPool diagnosticPool_;
+    QFuture<CompileCache::Artifact> diagnosticBuild_;
     QString runProgram_;
     QStringList runArgs_;
     std::atomic<bool> running_{false};
     std::atomic<bool> cancelled_{false};
+    std::atomic<int> queuedTests_{0};
 
     QFutureWatcher<TestResult> *watcher_ = nullptr;
     QFuture<void> compileFuture_;
     std::vector<TestResult> results_;
     int expectedResults_ = 0;
+    qint64 runAllStartUs_ = -1;  // Trace clock
 };
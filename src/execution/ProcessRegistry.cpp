@@ -0,0 +1,90 @@
+#include "execution/ProcessRegistry.h"
+
+#include <QElapsedTimer>
+#include <QMutex>
+
+#include <algorithm>
+#include <atomic>
+
+namespace {
+
+struct Entry {
+    qint64 pid = 0;
+    QString label;
+    qint64 startedMs = 0;
+};
+
+struct Registry {
+    Registry() { clock.start(); }
+
+    QMutex mutex;
+    QElapsedTimer clock;
+    std::vector<Entry> children;
+    quint64 finished = 0;
+};
+
+std::atomic<int> gBusyWorkers{0};
+std::atomic<int> gQueuedJobs{0};
+
+Registry &registry() {
+    static Registry instance;
+    return instance;
+}
+
+} // namespace
+
+namespace ProcessRegistry {
+
+void addChild(qint64 pid, const QString &label) {
+    if (pid <= 0) {
+        return;
+    }
+    Registry &r = registry();
+    QMutexLocker lock(&r.mutex);
+    r.children.push_back({pid, label, r.clock.elapsed()});
+}
+
+void removeChild(qint64 pid) {
+    if (pid <= 0) {
+        return;
+    }
+    Registry &r = registry();
+    QMutexLocker lock(&r.mutex);
+    const auto it = std::find_if(r.children.begin(), r.children.end(),
+                                 [pid](const Entry &entry) { return entry.pid == pid; });
+    if (it != r.children.end()) {
+        r.children.erase(it);
+        ++r.finished;
+    }
+}
+
+void addQueued(int count) {
+    gQueuedJobs.fetch_add(count, std::memory_order_relaxed);
+}
+
+Snapshot snapshot() {
+    Snapshot result;
+    result.busyWorkers = gBusyWorkers.load(std::memory_order_relaxed);
+    result.queuedJobs = std::max(gQueuedJobs.load(std::memory_order_relaxed), 0);
+
+    Registry &r = registry();
+    QMutexLocker lock(&r.mutex);
+    const qint64 now = r.clock.elapsed();
+    result.children.reserve(r.children.size());
+    for (const Entry &entry : r.children) {
+        result.children.push_back({entry.pid, entry.label, now - entry.startedMs});
+    }
+    result.finishedChildren = r.finished;
+    return result;
+}
+
+WorkerScope::WorkerScope() {
+    gQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    gBusyWorkers.fetch_add(1, std::memory_order_relaxed);
+}
+
+WorkerScope::~WorkerScope() {
+    gBusyWorkers.fetch_sub(1, std::memory_order_relaxed);
+}
+
+} // namespace ProcessRegistry
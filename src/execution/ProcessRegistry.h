@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QString>
+#include <vector>
+
+// Process-wide bookkeeping of what the runners are doing right now, read by
+// the resource monitor: the child processes that are alive, how many worker
+// threads are busy with a job, and how many jobs are still queued. All
+// functions are thread-safe; registering a child is one short mutex hold.
+namespace ProcessRegistry {
+
+struct Child {
+    qint64 pid = 0;
+    QString label;
+    qint64 elapsedMs = 0;
+};
+
+struct Snapshot {
+    std::vector<Child> children;
+    int busyWorkers = 0;
+    int queuedJobs = 0;
+    quint64 finishedChildren = 0;  // since startup
+};
+
+void addChild(qint64 pid, const QString &label);
+void removeChild(qint64 pid);
+
+// Jobs handed to a pool but not yet picked up; pass a negative count when
+// they are taken or dropped
+void addQueued(int count);
+
+Snapshot snapshot();
+
+// Registers a started child for the enclosing scope
+class ChildScope {
+public:
+    ChildScope(qint64 pid, const QString &label) : pid_(pid) { addChild(pid, label); }
+    ~ChildScope() { removeChild(pid_); }
+
+    ChildScope(const ChildScope &) = delete;
+    ChildScope &operator=(const ChildScope &) = delete;
+
+private:
+    qint64 pid_;
+};
+
+// Counts the calling thread as busy (and takes its job off the queue) for
+// the enclosing scope
+class WorkerScope {
+public:
+    WorkerScope();
+    ~WorkerScope();
+
+    WorkerScope(const WorkerScope &) = delete;
+    WorkerScope &operator=(const WorkerScope &) = delete;
+};
+
+} // namespace ProcessRegistry
@@ -0,0 +1,211 @@
+#include "execution/PythonRunner.h"
+
+namespace {
+// Reads requests on stdin and answers on stdout; see HarnessRunner
+constexpr const char *kHarnessSource = R"python(
+import ast
+import importlib
+import os
+import selectors
+import struct
+import sys
+import tempfile
+import traceback
+import types
+
+MAGIC = 0x43464852
+codes = {}
+
+# Standard-library modules the server imports ahead of the children: these
+# have no side effects a test could see. Anything else (the solution's own
+# modules, third-party packages) is imported by each child as usual.
+PRELOAD = frozenset((
+    "array", "bisect", "cmath", "collections", "copy", "dataclasses", "datetime",
+    "decimal", "enum", "fractions", "functools", "heapq", "io", "itertools",
+    "math", "numbers", "operator", "os", "queue", "random", "re", "statistics",
+    "string", "struct", "sys", "threading", "time", "types", "typing",
+))
+
+
+def read_exact(stream, size):
+    data = stream.read(size)
+    if len(data) < size:
+        raise EOFError
+    return data
+
+
+def read_field(stream):
+    (size,) = struct.unpack(">I", read_exact(stream, 4))
+    return read_exact(stream, size)
+
+
+def write_field(stream, data):
+    stream.write(struct.pack(">I", len(data)))
+    stream.write(data)
+
+
+def prepare(path):
+    code = codes.get(path)
+    if code is None:
+        with open(path, "rb") as f:
+            source = f.read()
+        code = compile(source, path, "exec", dont_inherit=True)
+        # Children inherit whatever the server has imported
+        for node in ast.parse(source).body:
+            if isinstance(node, ast.Import):
+                names = [alias.name for alias in node.names]
+            elif isinstance(node, ast.ImportFrom) and node.level == 0 and node.module:
+                names = [node.module]
+            else:
+                continue
+            for name in names:
+                if name.partition(".")[0] not in PRELOAD:
+                    continue
+                try:
+                    importlib.import_module(name)
+                except BaseException:
+                    pass
+        codes[path] = code
+    return code
+
+
+def child(path, stdin_fd, out_fd, err_fd):
+    os.dup2(stdin_fd, 0)
+    os.dup2(out_fd, 1)
+    os.dup2(err_fd, 2)
+    sys.stdin = open(0, "r", closefd=False)
+    sys.stdout = open(1, "w", closefd=False)
+    sys.stderr = open(2, "w", closefd=False)
+    status = 0
+    try:
+        code = prepare(path)
+        module = types.ModuleType("__main__")
+        module.__file__ = path
+        sys.modules["__main__"] = module
+        sys.argv = [path]
+        sys.path[0] = os.path.dirname(path)
+        exec(code, module.__dict__)
+    except SystemExit as e:
+        if isinstance(e.code, int):
+            status = e.code
+        elif e.code is not None:
+            print(e.code, file=sys.stderr)
+            status = 1
+    except BaseException:
+        # Without the harness's frames, as the interpreter would print it
+        kind, value, tb = sys.exc_info()
+        traceback.print_exception(
+            kind, value, None if isinstance(value, SyntaxError) else tb.tb_next)
+        status = 1
+    for stream in (sys.stdout, sys.stderr):
+        try:
+            stream.flush()
+        except BaseException:
+            pass
+    os._exit(status & 0xFF)
+
+
+def serve(path, data):
+    with tempfile.TemporaryFile() as stdin_file:
+        stdin_file.write(data)
+        stdin_file.flush()
+        stdin_file.seek(0)
+        out_r, out_w = os.pipe()
+        err_r, err_w = os.pipe()
+        pid = os.fork()
+        if pid == 0:
+            os.close(out_r)
+            os.close(err_r)
+            child(path, stdin_file.fileno(), out_w, err_w)
+        os.close(out_w)
+        os.close(err_w)
+
+        chunks = {out_r: [], err_r: []}
+        with selectors.DefaultSelector() as selector:
+            for fd in chunks:
+                selector.register(fd, selectors.EVENT_READ)
+            remaining = len(chunks)
+            while remaining:
+                for key, _ in selector.select():
+                    chunk = os.read(key.fd, 65536)
+                    if chunk:
+                        chunks[key.fd].append(chunk)
+                    else:
+                        selector.unregister(key.fd)
+                        os.close(key.fd)
+                        remaining -= 1
+        _, status = os.waitpid(pid, 0)
+
+    exit_code = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -os.WTERMSIG(status)
+    return exit_code, b"".join(chunks[out_r]), b"".join(chunks[err_r])
+
+
+def main():
+    requests = sys.stdin.buffer
+    replies = sys.stdout.buffer
+    while True:
+        try:
+            read_field(requests)  # entry directory; the path says it all
+            path = read_field(requests).decode("utf-8")
+            data = read_field(requests)
+        except EOFError:
+            return
+        try:
+            prepare(path)
+        except BaseException:
+            pass  # the child reports it
+        exit_code, out, err = serve(path, data)
+        replies.write(struct.pack(">Ii", MAGIC, exit_code))
+        write_field(replies, out)
+        write_field(replies, err)
+        replies.flush()
+
+
+main()
+)python";
+
+// Shared by every runner; the harness is published once per interpreter
+CompileCache &harnessCache() {
+    static CompileCache cache;
+    return cache;
+}
+} // namespace
+
+PythonRunner::PythonRunner(const CompilationConfig &config)
+    : HarnessRunner("Python") {
+    harnessConfig_.language = "Python";
+    harnessConfig_.pythonPath = config.pythonPath;
+    harnessConfig_.pythonArgs = config.pythonArgs;
+    harnessConfig_.transcludeTemplate = false;
+}
+
+PythonRunner &PythonRunner::forThisThread(const CompilationConfig &config) {
+    thread_local std::unique_ptr<PythonRunner> runner;
+    if (!runner || runner->harnessConfig_.pythonPath != config.pythonPath ||
+        runner->harnessConfig_.pythonArgs != config.pythonArgs) {
+        runner = std::make_unique<PythonRunner>(config);
+    }
+    return *runner;
+}
+
+bool PythonRunner::command(bool /*extras*/, QString &program, QStringList &args, QString &error) {
+#ifdef Q_OS_WIN
+    Q_UNUSED(program);
+    Q_UNUSED(args);
+    error = "The Python fork server needs fork()";
+    return false;
+#else
+    if (!harness_.ok) {
+        harness_ = harnessCache().get(QString::fromUtf8(kHarnessSource), harnessConfig_);
+        if (!harness_.ok) {
+            error = "Failed to prepare the Python fork server:\n" + harness_.error;
+            return false;
+        }
+    }
+    // The solution's run arguments (e.g. -O) apply to the server and so to
+    // every child it forks
+    program = harness_.program;
+    args = harness_.args;
+    return true;
+#endif
+}
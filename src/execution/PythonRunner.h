@@ -0,0 +1,34 @@
+#pragma once
+
+#include "execution/CompilationConfig.h"
+#include "execution/CompileCache.h"
+#include "execution/HarnessRunner.h"
+
+#include <QString>
+#include <QStringList>
+
+// Runs Python solutions from a fork server instead of starting the
+// interpreter for every test. The server compiles each solution to
+// bytecode once and imports those of its top-level imports that are on a
+// short allowlist of side-effect-free standard modules (math, collections,
+// ...), then forks a child per test with fresh stdin/stdout/stderr; the
+// child starts with those modules already loaded and imports the rest
+// itself, so module-level code runs once per test as usual. run() takes
+// the entry directory and the script path.
+//
+// Needs fork(), so on Windows run() always returns !ok.
+class PythonRunner : public HarnessRunner {
+public:
+    explicit PythonRunner(const CompilationConfig &config);
+
+    // The calling thread's runner, replaced when the Python settings
+    // change; it lives (and keeps its server) until the thread exits
+    static PythonRunner &forThisThread(const CompilationConfig &config);
+
+protected:
+    bool command(bool extras, QString &program, QStringList &args, QString &error) override;
+
+private:
+    CompilationConfig harnessConfig_;
+    CompileCache::Artifact harness_;  // leased while the runner lives
+};
@@ -0,0 +1,112 @@
+#include "execution/ResourceSampler.h"
+
+#include <QFile>
+#include <QList>
+#include <QThread>
+
+#include <algorithm>
+#include <utility>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef Q_OS_LINUX
+QByteArray readProcFile(qint64 pid, const char *name) {
+    QFile file(QString("/proc/%1/%2").arg(pid).arg(QLatin1String(name)));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+// utime + stime in clock ticks; -1 when the process is gone
+qint64 cpuTicks(qint64 pid) {
+    const QByteArray stat = readProcFile(pid, "stat");
+    // The command name is parenthesized and may contain spaces
+    const int close = stat.lastIndexOf(')');
+    if (close < 0) {
+        return -1;
+    }
+    const QList<QByteArray> fields = stat.mid(close + 2).split(' ');
+    // fields[0] is field 3 (state); utime and stime are fields 14 and 15
+    if (fields.size() < 13) {
+        return -1;
+    }
+    return fields.at(11).toLongLong() + fields.at(12).toLongLong();
+}
+
+qint64 residentBytes(qint64 pid) {
+    const QList<QByteArray> fields = readProcFile(pid, "statm").split(' ');
+    if (fields.size() < 2) {
+        return -1;
+    }
+    return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+}
+#endif
+
+} // namespace
+
+ResourceSampler::ResourceSampler() {
+    clock_.start();
+}
+
+ResourceSampler::Sample ResourceSampler::sample() {
+    const ProcessRegistry::Snapshot snapshot = ProcessRegistry::snapshot();
+    const qint64 now = clock_.elapsed();
+
+    Sample result;
+    result.busyWorkers = snapshot.busyWorkers;
+    result.workerCapacity = std::max(QThread::idealThreadCount(), 1);
+    result.queuedJobs = snapshot.queuedJobs;
+
+    if (lastSampleMs_ >= 0 && now > lastSampleMs_) {
+        const double rate = static_cast<double>(snapshot.finishedChildren - lastFinished_) *
+                             1000.0 / static_cast<double>(now - lastSampleMs_);
+        // Smooth over a few samples so bursts of short tests read steadily
+        throughput_ = 0.5 * throughput_ + 0.5 * rate;
+    }
+    lastFinished_ = snapshot.finishedChildren;
+    lastSampleMs_ = now;
+    result.childrenPerSecond = throughput_;
+
+    QHash<qint64, CpuTime> current;
+#ifdef Q_OS_LINUX
+    result.procAvailable = true;
+    const double ticksPerMs = static_cast<double>(sysconf(_SC_CLK_TCK)) / 1000.0;
+#endif
+    for (const ProcessRegistry::Child &entry : snapshot.children) {
+        Child child;
+        child.pid = entry.pid;
+        child.label = entry.label;
+        child.elapsedMs = entry.elapsedMs;
+#ifdef Q_OS_LINUX
+        const qint64 ticks = cpuTicks(entry.pid);
+        if (ticks >= 0) {
+            // First sight of a child: average over its whole life so far
+            const auto it = previous_.constFind(entry.pid);
+            const CpuTime before = it != previous_.constEnd()
+                ? *it : CpuTime{0, now - entry.elapsedMs};
+            const qint64 wallMs = now - before.wallMs;
+            if (wallMs > 0 && ticksPerMs > 0.0) {
+                child.cpuPercent = 100.0 * static_cast<double>(ticks - before.ticks) /
+                                   (ticksPerMs * static_cast<double>(wallMs));
+                child.cpuPercent = std::max(child.cpuPercent, 0.0);
+                result.cpuPercent += child.cpuPercent;
+            }
+            current.insert(entry.pid, {ticks, now});
+            child.rssBytes = residentBytes(entry.pid);
+            result.rssBytes += std::max<qint64>(child.rssBytes, 0);
+        }
+#endif
+        result.children.push_back(child);
+    }
+    // Dropping children that exited also forgets pids the OS may reuse
+    previous_ = std::move(current);
+
+    std::sort(result.children.begin(), result.children.end(),
+              [](const Child &a, const Child &b) { return a.elapsedMs > b.elapsedMs; });
+    return result;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "execution/ProcessRegistry.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+#include <vector>
+
+// Turns successive ProcessRegistry snapshots into per-child CPU and memory
+// figures read from /proc. CPU% is the child's CPU time since the previous
+// sample (or since it started) over the wall time in between, so 100%
+// means one core busy. On systems without /proc the CPU and RSS fields
+// are -1.
+class ResourceSampler {
+public:
+    struct Child {
+        qint64 pid = 0;
+        QString label;
+        qint64 elapsedMs = 0;
+        double cpuPercent = -1.0;
+        qint64 rssBytes = -1;
+    };
+
+    struct Sample {
+        std::vector<Child> children;
+        double cpuPercent = 0.0;    // sum over children
+        qint64 rssBytes = 0;        // sum over children
+        int busyWorkers = 0;
+        int workerCapacity = 1;     // ideal thread count
+        int queuedJobs = 0;
+        double childrenPerSecond = 0.0;
+        bool procAvailable = false;
+    };
+
+    ResourceSampler();
+
+    Sample sample();
+
+private:
+    struct CpuTime {
+        qint64 ticks = 0;
+        qint64 wallMs = 0;
+    };
+
+    QElapsedTimer clock_;
+    QHash<qint64, CpuTime> previous_;
+    quint64 lastFinished_ = 0;
+    qint64 lastSampleMs_ = -1;
+    double throughput_ = 0.0;
+};
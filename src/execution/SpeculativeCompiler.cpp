@@ -0,0 +1,104 @@
+#include "execution/SpeculativeCompiler.h"
+#include "execution/CompilationUtils.h"
+#include "execution/Trace.h"
+
+#include <QFutureWatcher>
+#include <QTimer>
+#include <QtConcurrent>
+
+#include <utility>
+
+namespace {
+// Long enough that a build does not start mid-word, short enough to be done
+// by the time the user reaches for Run
+constexpr int kDebounceMs = 700;
+} // namespace
+
+SpeculativeCompiler::SpeculativeCompiler(std::shared_ptr<CompileCache> cache,
+                                         SourceProvider provider,
+                                         QObject *parent)
+    : QObject(parent),
+      cache_(std::move(cache)),
+      provider_(std::move(provider)),
+      debounce_(new QTimer(this)),
+      watcher_(new QFutureWatcher<CompileCache::Artifact>(this)) {
+    debounce_->setSingleShot(true);
+    debounce_->setInterval(kDebounceMs);
+    connect(debounce_, &QTimer::timeout, this, &SpeculativeCompiler::startBuild);
+
+    connect(watcher_, &QFutureWatcher<CompileCache::Artifact>::finished, this, [this]() {
+        // Failed builds are not published; Run reports the errors as usual
+        if (!watcher_->result().ok) {
+            lastKey_.clear();
+        }
+    });
+}
+
+SpeculativeCompiler::~SpeculativeCompiler() {
+    cancel();
+    watcher_->waitForFinished();
+}
+
+void SpeculativeCompiler::setEnabled(bool enabled) {
+    enabled_ = enabled;
+    if (!enabled_) {
+        cancel();
+    }
+}
+
+void SpeculativeCompiler::sourceChanged() {
+    if (!enabled_) {
+        return;
+    }
+    // Whatever is building now no longer matches the editor
+    if (watcher_->isRunning()) {
+        cancelled_->store(true);
+        lastKey_.clear();
+    }
+    debounce_->start();
+}
+
+void SpeculativeCompiler::cancel() {
+    debounce_->stop();
+    if (cancelled_) {
+        cancelled_->store(true);
+    }
+    lastKey_.clear();
+}
+
+void SpeculativeCompiler::startBuild() {
+    QString source;
+    CompilationConfig config;
+    if (!enabled_ || !provider_ || !provider_(source, config) || source.trimmed().isEmpty()) {
+        return;
+    }
+    // Python runs from source; there is nothing to get ahead of
+    if (CompilationUtils::normalizeLanguage(config.language) == "Python") {
+        return;
+    }
+    const QByteArray key = CompileCache::key(
+        CompilationUtils::applyTransclusion(config.templateCode, source,
+                                            config.transcludeTemplate),
+        config);
+    if (key == lastKey_) {
+        return;
+    }
+    if (watcher_->isRunning()) {
+        // Still winding down; try again once it has given up
+        cancelled_->store(true);
+        debounce_->start();
+        return;
+    }
+
+    lastKey_ = key;
+    cancelled_ = std::make_shared<std::atomic<bool>>(false);
+    const std::shared_ptr<CompileCache> cache = cache_;
+    const std::shared_ptr<std::atomic<bool>> cancelled = cancelled_;
+    watcher_->setFuture(QtConcurrent::run([cache, cancelled, source, config]() {
+        Trace::Span span("speculative compile");
+        CompileCache::BuildOptions options;
+        options.lowPriority = true;
+        options.cancelled = cancelled.get();
+        return cache->get(source, config, options);
+    }));
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "execution/CompilationConfig.h"
+#include "execution/CompileCache.h"
+
+#include <QObject>
+#include <QString>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+class QTimer;
+template <typename T>
+class QFutureWatcher;
+
+// Builds the solution into the compile cache while the user is still
+// editing, so Run usually finds a ready binary. Each edit restarts a short
+// debounce; when it expires the current source is compiled on a worker
+// thread at low priority. A new edit cancels a build that is still running.
+class SpeculativeCompiler : public QObject {
+    Q_OBJECT
+
+public:
+    // Fills in what to build; returns false when there is nothing to build
+    // (e.g. the editor shows the brute force, not the solution)
+    using SourceProvider = std::function<bool(QString &source, CompilationConfig &config)>;
+
+    SpeculativeCompiler(std::shared_ptr<CompileCache> cache,
+                        SourceProvider provider,
+                        QObject *parent = nullptr);
+    ~SpeculativeCompiler() override;
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled_; }
+
+    // Call on every edit
+    void sourceChanged();
+    void cancel();
+
+private:
+    void startBuild();
+
+    std::shared_ptr<CompileCache> cache_;
+    SourceProvider provider_;
+    QTimer *debounce_ = nullptr;
+    QFutureWatcher<CompileCache::Artifact> *watcher_ = nullptr;
+    std::shared_ptr<std::atomic<bool>> cancelled_;
+    QByteArray lastKey_;  // last source handed to the cache
+    bool enabled_ = false;
+};
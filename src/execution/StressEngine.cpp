@@ -0,0 +1,391 @@
+#include "execution/StressEngine.h"
+#include "execution/CompilationUtils.h"
+#include "execution/Complexity.h"
+#include "execution/HarnessRunner.h"
+#include "execution/ProcessRegistry.h"
+#include "execution/Trace.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <utility>
+
+struct StressEngine::Round {
+    int index = -1;
+    Result::Status status = Result::Status::Passed;
+    QString error;
+    QByteArray stderrOutput;
+    QByteArray input;  // generator output, fed as is to brute and solution
+    QByteArray expected;
+    QByteArray actual;
+    qint64 solutionTime = -1;
+};
+
+StressEngine::StressEngine(Config config)
+    : config_(std::move(config)),
+      cache_(config_.cache ? config_.cache : std::make_shared<CompileCache>()),
+      outputs_(config_.outputs ? config_.outputs : std::make_shared<OutputCache>()) {}
+
+StressEngine::Result StressEngine::run() {
+    Result result;
+    Trace::Span span("stress");
+    QElapsedTimer clock;
+    clock.start();
+
+    std::vector<double> inputSizes;
+    std::vector<double> solutionTimes;
+    auto finish = [&]() {
+        result.elapsedMs = clock.elapsed();
+        result.complexity = Complexity::suspectedLabel(inputSizes, solutionTimes);
+        return result;
+    };
+
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+        result.status = Result::Status::Error;
+        result.error = "Failed to create temporary directory for stress testing.";
+        return finish();
+    }
+    tempPath_ = tempDir.path();
+
+    // Prepare all three sources
+    const struct {
+        const QString &code;
+        QString label;
+        Binary &binary;
+    } sources[] = {
+        {config_.generator, "Generator", generator_},
+        {config_.brute, "Brute", brute_},
+        {config_.solution, "Solution", solution_},
+    };
+    for (const auto &source : sources) {
+        QString error;
+        if (!prepare(source.code, source.label, source.binary, error)) {
+            result.status = Result::Status::Error;
+            result.error = QString("%1 error:\n%2").arg(source.label, error);
+            return finish();
+        }
+    }
+
+    const int jobs = std::max(config_.jobs, 1);
+    const bool timed = config_.durationMs > 0;
+    // Several rounds per worker keep the pool busy between batches
+    const int batchSize = jobs == 1 ? 1 : jobs * 2;
+    QThreadPool pool;
+    pool.setMaxThreadCount(jobs);
+
+    int next = 0;
+    while (!cancelled_) {
+        if (timed ? clock.elapsed() >= config_.durationMs : next >= config_.count) {
+            break;
+        }
+        const int size = timed ? batchSize : std::min(batchSize, config_.count - next);
+        QVector<int> indices;
+        indices.reserve(size);
+        for (int i = 0; i < size; ++i) {
+            indices.push_back(next + i);
+        }
+        next += size;
+        ProcessRegistry::addQueued(size);
+
+        QVector<Round> rounds;
+        if (jobs == 1) {
+            rounds.push_back(runRound(indices.front()));
+        } else {
+            rounds = QtConcurrent::blockingMapped(&pool, indices, [this](int index) {
+                return runRound(index);
+            });
+        }
+
+        // Rounds come back in order, so the first failure is the earliest one
+        for (const Round &round : rounds) {
+            if (!round.input.isNull()) {
+                inputSizes.push_back(static_cast<double>(round.input.size()));
+                solutionTimes.push_back(round.solutionTime > 0
+                    ? static_cast<double>(round.solutionTime) : 0.0);
+            }
+            if (round.status == Result::Status::Passed) {
+                ++result.totalCount;
+                continue;
+            }
+            if (round.status == Result::Status::Cancelled) {
+                break;
+            }
+            result.status = round.status;
+            result.failedIndex = round.index;
+            result.error = round.error;
+            result.stderrOutput = QString::fromUtf8(round.stderrOutput);
+            result.input = QString::fromUtf8(round.input);
+            result.expected = QString::fromUtf8(round.expected);
+            result.actual = QString::fromUtf8(round.actual);
+            return finish();
+        }
+
+        if (config_.onProgress) {
+            config_.onProgress(result.totalCount, clock.elapsed());
+        }
+    }
+
+    if (cancelled_) {
+        result.status = Result::Status::Cancelled;
+    }
+    return finish();
+}
+
+StressEngine::Round StressEngine::runRound(int index) const {
+    ProcessRegistry::WorkerScope worker;
+    Round round;
+    round.index = index;
+    Trace::Span span("stress round", Trace::isEnabled()
+        ? QString("#%1").arg(index + 1) : QString());
+    if (cancelled_) {
+        round.status = Result::Status::Cancelled;
+        return round;
+    }
+
+    // Each round gets its own working directory for files the programs write
+    const QString caseDir = QDir(tempPath_).filePath(QString("case_%1").arg(index + 1));
+    QDir().mkpath(caseDir);
+
+    QString runError;
+    QByteArray generatorErr;
+    qint64 stageStart = Trace::now();
+    const bool generated = runProcess(generator_, {QString::number(index + 1)}, QByteArray(),
+                                      caseDir, &round.input, &generatorErr, nullptr, &runError);
+    Trace::complete("generator", stageStart);
+    if (!generated) {
+        round.status = Result::Status::Error;
+        round.error = QString("Generator failed on test #%1:\n%2").arg(index + 1).arg(runError);
+        round.stderrOutput = generatorErr;
+        round.input = QByteArray();
+        QDir(caseDir).removeRecursively();
+        return round;
+    }
+
+    QByteArray bruteOut;
+    QByteArray bruteErr;
+    bool bruteCached = false;
+    stageStart = Trace::now();
+    const bool bruteRan =
+        bruteOutput(round.input, caseDir, &bruteOut, &bruteErr, &bruteCached, &runError);
+    Trace::complete("brute", stageStart, bruteCached ? QStringLiteral("cached") : QString());
+    if (!bruteRan) {
+        round.status = Result::Status::Error;
+        round.error = QString("Brute failed on test #%1:\n%2").arg(index + 1).arg(runError);
+        round.stderrOutput = bruteErr;
+        QDir(caseDir).removeRecursively();
+        return round;
+    }
+
+    QByteArray solutionOut;
+    QByteArray solutionErr;
+    stageStart = Trace::now();
+    const bool solutionRan = runProcess(solution_, {}, round.input, caseDir, &solutionOut,
+                                        &solutionErr, &round.solutionTime, &runError);
+    Trace::complete("solution", stageStart);
+    if (!solutionRan) {
+        round.status = Result::Status::SolutionFailed;
+        round.error = QString("Solution failed on test #%1:\n%2").arg(index + 1).arg(runError);
+        round.stderrOutput = solutionErr;
+        QDir(caseDir).removeRecursively();
+        return round;
+    }
+    QDir(caseDir).removeRecursively();
+
+    Trace::Span compareSpan("normalize");
+    if (!CompilationUtils::sameOutput(solutionOut, bruteOut)) {
+        round.status = Result::Status::WrongAnswer;
+        round.expected = bruteOut;
+        round.actual = solutionOut;
+        round.stderrOutput = !solutionErr.isEmpty() ? solutionErr : bruteErr;
+    }
+    return round;
+}
+
+QVector<StressEngine::Reference> StressEngine::runBrute(const QVector<QByteArray> &inputs,
+                                                        QString *error) {
+    Trace::Span span("brute outputs");
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+        if (error) {
+            *error = "Failed to create temporary directory for the brute.";
+        }
+        return {};
+    }
+    tempPath_ = tempDir.path();
+    QString prepareError;
+    if (!prepare(config_.brute, "Brute", brute_, prepareError)) {
+        if (error) {
+            *error = QString("Brute error:\n%1").arg(prepareError);
+        }
+        return {};
+    }
+
+    QVector<int> indices;
+    indices.reserve(inputs.size());
+    for (int i = 0; i < inputs.size(); ++i) {
+        indices.push_back(i);
+    }
+    const int jobs = std::max(config_.jobs, 1);
+    QThreadPool pool;
+    pool.setMaxThreadCount(jobs);
+    ProcessRegistry::addQueued(static_cast<int>(indices.size()));
+    return QtConcurrent::blockingMapped(&pool, indices, [this, &inputs](int index) {
+        ProcessRegistry::WorkerScope worker;
+        Reference reference;
+        if (cancelled_) {
+            reference.error = "Cancelled";
+            return reference;
+        }
+        const QString caseDir = QDir(tempPath_).filePath(QString("brute_%1").arg(index + 1));
+        QDir().mkpath(caseDir);
+        QByteArray stdErr;
+        QString runError;
+        reference.ok = bruteOutput(inputs[index], caseDir, &reference.output, &stdErr,
+                                   &reference.cached, &runError);
+        if (!reference.ok) {
+            reference.error = runError;
+            if (!stdErr.isEmpty()) {
+                reference.error += '\n' + QString::fromUtf8(stdErr);
+            }
+        }
+        QDir(caseDir).removeRecursively();
+        return reference;
+    });
+}
+
+bool StressEngine::bruteOutput(const QByteArray &input,
+                               const QString &workDir,
+                               QByteArray *stdOut,
+                               QByteArray *stdErr,
+                               bool *cached,
+                               QString *error) const {
+    *cached = outputs_->find(brute_.artifact.key, input, *stdOut);
+    if (*cached) {
+        return true;
+    }
+    if (!runProcess(brute_, {}, input, workDir, stdOut, stdErr, nullptr, error)) {
+        return false;
+    }
+    outputs_->store(brute_.artifact.key, input, *stdOut);
+    return true;
+}
+
+// Generator, brute and solution come from the shared compile cache, so a
+// stress run after Run All (or a second stress run) compiles nothing.
+// Python is "built" by publishing its source; Java runs via java -cp.
+bool StressEngine::prepare(const QString &rawCode,
+                           const QString &label,
+                           Binary &binary,
+                           QString &error) const {
+    Trace::Span span("compile", label);
+    CompilationConfig config = config_.compilation;
+    if (CompilationUtils::normalizeLanguage(config.language) == "C++" &&
+        config.cppCompilerFlags.trimmed().isEmpty()) {
+        config.cppCompilerFlags = "-O2 -std=c++17";
+    }
+    binary.label = label;
+    binary.artifact = cache_->get(rawCode, config);
+    if (!binary.artifact.ok) {
+        error = binary.artifact.error;
+        return false;
+    }
+    binary.program = binary.artifact.program;
+    binary.args = binary.artifact.args;
+    return true;
+}
+
+bool StressEngine::runProcess(const Binary &binary,
+                              const QStringList &extraArgs,
+                              const QByteArray &input,
+                              const QString &workDir,
+                              QByteArray *stdOut,
+                              QByteArray *stdErr,
+                              qint64 *timeMs,
+                              QString *error) const {
+    // Java and Python rounds reuse a warm runtime when enabled; whatever it
+    // cannot run (including anything that takes arguments) falls through
+    QString location;
+    QString entry;
+    HarnessRunner *runner = extraArgs.isEmpty()
+        ? HarnessRunner::forArtifact(config_.compilation, binary.artifact, location, entry)
+        : nullptr;
+    if (runner) {
+        const HarnessRunner::Result run =
+            runner->run(location, entry, input, config_.timeoutMs);
+        if (run.ok) {
+            if (run.timedOut) {
+                if (error) {
+                    *error = QString("Time Limit Exceeded: %1").arg(binary.program);
+                }
+                return false;
+            }
+            if (timeMs) {
+                *timeMs = run.timeMs;
+            }
+            if (stdOut) {
+                *stdOut = run.stdOut;
+            }
+            if (stdErr) {
+                *stdErr = run.stdErr;
+            }
+            if (run.exitCode != 0) {
+                if (error) {
+                    *error = QString("Runtime Error: %1").arg(binary.program);
+                }
+                return false;
+            }
+            return true;
+        }
+    }
+
+    QProcess process;
+    process.setWorkingDirectory(workDir);
+    QElapsedTimer timer;
+    timer.start();
+    process.start(binary.program, binary.args + extraArgs);
+    if (!process.waitForStarted(1000)) {
+        if (error) {
+            *error = QString("Failed to start %1").arg(binary.program);
+        }
+        return false;
+    }
+    const ProcessRegistry::ChildScope child(process.processId(), binary.label);
+    if (!input.isEmpty()) {
+        process.write(input);
+    }
+    process.closeWriteChannel();
+
+    if (!process.waitForFinished(config_.timeoutMs)) {
+        process.kill();
+        process.waitForFinished(1000);
+        if (error) {
+            *error = QString("Time Limit Exceeded: %1").arg(binary.program);
+        }
+        return false;
+    }
+
+    if (timeMs) {
+        *timeMs = timer.elapsed();
+    }
+    if (stdOut) {
+        *stdOut = process.readAllStandardOutput();
+    }
+    if (stdErr) {
+        *stdErr = process.readAllStandardError();
+    }
+
+    if (process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0) {
+        if (error) {
+            *error = QString("Runtime Error: %1").arg(binary.program);
+        }
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "execution/CompilationConfig.h"
+#include "execution/CompileCache.h"
+#include "execution/OutputCache.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+// Stress testing without any UI: compiles generator, brute and solution,
+// then runs rounds of generate -> brute -> solution and compares outputs
+// until a mismatch, a failure, the round/time budget or cancel().
+// run() blocks; call it from a worker thread (or a headless main).
+//
+// The generator gets its 1-based round number as argv[1] to seed from, so
+// a rerun sees the same inputs and the brute's answers come from the
+// output cache instead of being recomputed.
+class StressEngine {
+public:
+    struct Config {
+        QString solution;
+        QString brute;
+        QString generator;
+        CompilationConfig compilation;
+        int timeoutMs = 5000;  // per process
+        int count = 100;       // rounds; ignored when durationMs > 0
+        qint64 durationMs = 0; // > 0: start rounds until this much time has passed
+        int jobs = 1;          // rounds run at once
+        // Shared with Run and Run All; null: the default cache directory
+        std::shared_ptr<CompileCache> cache;
+        // Brute outputs by brute and input; null: the default cache directory
+        std::shared_ptr<OutputCache> outputs;
+        // Called on the run() thread after each batch of rounds
+        std::function<void(int rounds, qint64 elapsedMs)> onProgress;
+    };
+
+    struct Result {
+        enum class Status { Passed, WrongAnswer, SolutionFailed, Error, Cancelled };
+
+        Status status = Status::Passed;
+        int failedIndex = -1;  // 0-based round
+        int totalCount = 0;    // rounds completed
+        qint64 elapsedMs = 0;
+        QString input;
+        QString expected;  // brute output
+        QString actual;    // solution output
+        QString error;
+        QString stderrOutput;
+        QString complexity;
+
+        bool passed() const { return status == Status::Passed; }
+    };
+
+    // A brute output per input, for filling in expected outputs
+    struct Reference {
+        bool ok = false;
+        bool cached = false;  // read from the output cache
+        QByteArray output;
+        QString error;
+    };
+
+    explicit StressEngine(Config config);
+
+    Result run();
+    // Compiles only the brute and runs it over `inputs`, config.jobs at a
+    // time, in input order. Empty with `error` set when the brute does
+    // not compile.
+    QVector<Reference> runBrute(const QVector<QByteArray> &inputs, QString *error);
+    // Thread-safe; run() returns after the rounds in flight
+    void cancel() { cancelled_ = true; }
+
+private:
+    struct Binary {
+        QString label;  // Generator, Brute or Solution
+        QString program;
+        QStringList args;
+        CompileCache::Artifact artifact;  // leased for the engine's lifetime
+    };
+    struct Round;
+
+    bool prepare(const QString &code, const QString &label, Binary &binary,
+                 QString &error) const;
+    // Output stays UTF-8 bytes; only a failing round is decoded, for Result.
+    // `extraArgs` follow the binary's own arguments.
+    bool runProcess(const Binary &binary, const QStringList &extraArgs,
+                    const QByteArray &input, const QString &workDir,
+                    QByteArray *stdOut, QByteArray *stdErr, qint64 *timeMs,
+                    QString *error) const;
+    // The brute's output from the output cache, or from running it (and
+    // then stored when it succeeded)
+    bool bruteOutput(const QByteArray &input, const QString &workDir, QByteArray *stdOut,
+                     QByteArray *stdErr, bool *cached, QString *error) const;
+    Round runRound(int index) const;
+
+    Config config_;
+    std::shared_ptr<CompileCache> cache_;
+    std::shared_ptr<OutputCache> outputs_;
+    QString tempPath_;
+    Binary generator_;
+    Binary brute_;
+    Binary solution_;
+    std::atomic<bool> cancelled_{false};
+};
@@ -0,0 +1,175 @@
+#include "execution/Trace.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QStringList>
+#include <QThread>
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace {
+// Roughly 100 MB of events; later spans are counted but dropped
+constexpr size_t kMaxEvents = 1000000;
+
+struct Event {
+    const char *name = nullptr;
+    qint64 startUs = 0;
+    qint64 durationUs = 0;
+    int thread = 0;
+    QString detail;
+};
+
+struct Recorder {
+    Recorder() { clock.start(); }
+
+    QMutex mutex;
+    QElapsedTimer clock;
+    std::vector<Event> events;
+    QStringList threadNames;  // thread id - 1
+    qint64 dropped = 0;
+};
+
+std::atomic<bool> gEnabled{false};
+
+Recorder &recorder() {
+    static Recorder instance;
+    return instance;
+}
+
+// Small stable ids read better in the viewer than native thread handles
+int threadId() {
+    thread_local int id = 0;
+    if (id == 0) {
+        const QCoreApplication *app = QCoreApplication::instance();
+        const bool main = app && QThread::currentThread() == app->thread();
+        Recorder &r = recorder();
+        QMutexLocker lock(&r.mutex);
+        r.threadNames << (main ? QString("main") : QString("worker %1").arg(r.threadNames.size()));
+        id = static_cast<int>(r.threadNames.size());
+    }
+    return id;
+}
+} // namespace
+
+namespace Trace {
+
+void setEnabled(bool enabled) {
+    recorder();  // start the clock before the first span
+    gEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool isEnabled() {
+    return gEnabled.load(std::memory_order_relaxed);
+}
+
+void clear() {
+    Recorder &r = recorder();
+    QMutexLocker lock(&r.mutex);
+    r.events.clear();
+    r.dropped = 0;
+}
+
+int eventCount() {
+    Recorder &r = recorder();
+    QMutexLocker lock(&r.mutex);
+    return static_cast<int>(r.events.size());
+}
+
+qint64 now() {
+    if (!isEnabled()) {
+        return -1;
+    }
+    return recorder().clock.nsecsElapsed() / 1000;
+}
+
+void complete(const char *name, qint64 startUs, const QString &detail) {
+    if (startUs < 0 || !isEnabled()) {
+        return;
+    }
+    Event event;
+    event.name = name;
+    event.startUs = startUs;
+    event.durationUs = std::max<qint64>(now() - startUs, 0);
+    event.thread = threadId();
+    event.detail = detail;
+
+    Recorder &r = recorder();
+    QMutexLocker lock(&r.mutex);
+    if (r.events.size() >= kMaxEvents) {
+        ++r.dropped;
+        return;
+    }
+    r.events.push_back(std::move(event));
+}
+
+QByteArray toJson() {
+    Recorder &r = recorder();
+    QMutexLocker lock(&r.mutex);
+    const qint64 pid = QCoreApplication::applicationPid();
+
+    QJsonArray events;
+    auto metadata = [&events, pid](const char *kind, int thread, const QString &name) {
+        QJsonObject event;
+        event["name"] = kind;
+        event["ph"] = "M";
+        event["pid"] = pid;
+        event["tid"] = thread;
+        event["args"] = QJsonObject{{"name", name}};
+        events.append(event);
+    };
+    metadata("process_name", 0, "CF Dojo");
+    for (int i = 0; i < r.threadNames.size(); ++i) {
+        metadata("thread_name", i + 1, r.threadNames.at(i));
+    }
+
+    for (const Event &span : r.events) {
+        QJsonObject event;
+        event["name"] = span.name;
+        event["cat"] = "cfdojo";
+        event["ph"] = "X";
+        event["ts"] = span.startUs;
+        event["dur"] = span.durationUs;
+        event["pid"] = pid;
+        event["tid"] = span.thread;
+        if (!span.detail.isEmpty()) {
+            event["args"] = QJsonObject{{"detail", span.detail}};
+        }
+        events.append(event);
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = events;
+    root["displayTimeUnit"] = "ms";
+    if (r.dropped > 0) {
+        root["droppedEvents"] = r.dropped;
+    }
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+bool save(const QString &path, QString *error) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+    const QByteArray json = toJson();
+    if (file.write(json) != json.size()) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+    return true;
+}
+
+} // namespace Trace
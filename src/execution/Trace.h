@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+// Span recorder for the compile/run pipeline, exported in the Chrome trace
+// event format (open in chrome://tracing or ui.perfetto.dev). Recording is
+// off by default; while off every call costs one atomic load. Spans may be
+// recorded from any thread.
+namespace Trace {
+
+void setEnabled(bool enabled);
+bool isEnabled();
+void clear();
+int eventCount();
+
+// Microseconds on the trace clock, or -1 while recording is off
+qint64 now();
+
+// Records a span that began at `startUs` (from now()) and ends now; does
+// nothing when startUs < 0. `name` must outlive the trace (a literal).
+void complete(const char *name, qint64 startUs, const QString &detail = QString());
+
+// Records the enclosing scope as a span
+class Span {
+public:
+    explicit Span(const char *name, const QString &detail = QString())
+        : name_(name), detail_(detail), startUs_(now()) {}
+    ~Span() { complete(name_, startUs_, detail_); }
+
+    Span(const Span &) = delete;
+    Span &operator=(const Span &) = delete;
+
+    void setDetail(const QString &detail) { detail_ = detail; }
+
+private:
+    const char *name_;
+    QString detail_;
+    qint64 startUs_;
+};
+
+QByteArray toJson();
+bool save(const QString &path, QString *error = nullptr);
+
+} // namespace Trace
@@ -0,0 +1,262 @@
+#include "file/AutosaveJournal.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QRandomGenerator>
+#include <QSaveFile>
+
+#include <algorithm>
+
+namespace {
+constexpr char kJournalMagic[4] = {'C', 'F', 'J', 'L'};
+constexpr quint16 kJournalVersion = 1;
+constexpr qint64 kHeaderSize = 4 + 2 + 8;
+constexpr qint64 kMinCompactBytes = 64 * 1024;
+constexpr quint32 kMaxRecordBytes = 256 * 1024 * 1024;
+
+QByteArray encodeHeader(quint64 stamp) {
+    QByteArray header;
+    QDataStream stream(&header, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.writeRawData(kJournalMagic, 4);
+    stream << kJournalVersion << stamp;
+    return header;
+}
+} // namespace
+
+AutosaveJournal::AutosaveJournal(const QString &cpackPath, const QString &journalPath)
+    : cpackPath_(cpackPath),
+      journalPath_(journalPath) {}
+
+bool AutosaveJournal::write(const CpackFileHandler &state) {
+    if (!hasBase_) {
+        return compact(state);
+    }
+
+    QByteArray records;
+    const QStringList names = state.fileNames();
+    for (const QString &name : names) {
+        const QByteArray next = state.getFile(name);
+        const QByteArray prev = base_.getFile(name);
+        if (base_.hasFile(name) && prev == next) {
+            continue;
+        }
+
+        // Trim the common prefix and suffix; what is left is the edit
+        const qsizetype limit = std::min(prev.size(), next.size());
+        qsizetype prefix = 0;
+        while (prefix < limit && prev.at(prefix) == next.at(prefix)) {
+            ++prefix;
+        }
+        qsizetype suffix = 0;
+        while (suffix < limit - prefix &&
+               prev.at(prev.size() - 1 - suffix) == next.at(next.size() - 1 - suffix)) {
+            ++suffix;
+        }
+
+        records += encodeRecord(Op::Patch,
+                                name,
+                                static_cast<quint32>(prefix),
+                                static_cast<quint32>(prev.size() - prefix - suffix),
+                                next.mid(prefix, next.size() - prefix - suffix),
+                                next);
+    }
+    for (const QString &name : base_.fileNames()) {
+        if (!state.hasFile(name)) {
+            records += encodeRecord(Op::Remove, name, 0, 0, {}, {});
+        }
+    }
+
+    if (records.isEmpty()) {
+        return true;
+    }
+    if (journalBytes_ + records.size() > std::max(kMinCompactBytes, baseBytes_)) {
+        return compact(state);
+    }
+    if (!appendRecords(records)) {
+        // The journal tail is now unknown; start over on the next write
+        hasBase_ = false;
+        return false;
+    }
+    base_ = state;
+    return true;
+}
+
+bool AutosaveJournal::compact(const CpackFileHandler &state) {
+    quint64 stamp = 0;
+    while (stamp == 0) {
+        stamp = QRandomGenerator::global()->generate64();
+    }
+
+    // Archive first: if we crash before the journal is reset, the old journal
+    // carries a stale stamp and is ignored on recovery.
+    CpackFileHandler archive = state;
+    archive.addFile(kBaseStampFile, QByteArray::number(stamp));
+    if (!archive.save(cpackPath_)) {
+        errorString_ = archive.errorString();
+        hasBase_ = false;
+        return false;
+    }
+
+    QSaveFile journal(journalPath_);
+    if (!journal.open(QIODevice::WriteOnly)) {
+        errorString_ = journal.errorString();
+        hasBase_ = false;
+        return false;
+    }
+    journal.write(encodeHeader(stamp));
+    if (!journal.commit()) {
+        errorString_ = journal.errorString();
+        hasBase_ = false;
+        return false;
+    }
+
+    base_ = state;
+    hasBase_ = true;
+    stamp_ = stamp;
+    baseBytes_ = QFileInfo(cpackPath_).size();
+    journalBytes_ = kHeaderSize;
+    return true;
+}
+
+void AutosaveJournal::reset() {
+    base_.clear();
+    hasBase_ = false;
+    stamp_ = 0;
+    baseBytes_ = 0;
+    journalBytes_ = 0;
+}
+
+QByteArray AutosaveJournal::encodeRecord(Op op,
+                                         const QString &name,
+                                         quint32 offset,
+                                         quint32 removed,
+                                         const QByteArray &inserted,
+                                         const QByteArray &result) {
+    const QByteArray nameBytes = name.toUtf8();
+
+    QByteArray payload;
+    {
+        QDataStream stream(&payload, QIODevice::WriteOnly);
+        stream.setByteOrder(QDataStream::LittleEndian);
+        stream << static_cast<quint8>(op);
+        stream << quint16(nameBytes.size());
+        stream.writeRawData(nameBytes.constData(), static_cast<int>(nameBytes.size()));
+        stream << offset << removed << quint32(inserted.size());
+        stream.writeRawData(inserted.constData(), static_cast<int>(inserted.size()));
+        stream << CpackFileHandler::calculateCrc32(result);
+    }
+
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream << quint32(payload.size()) << CpackFileHandler::calculateCrc32(payload);
+    stream.writeRawData(payload.constData(), static_cast<int>(payload.size()));
+    return record;
+}
+
+bool AutosaveJournal::appendRecords(const QByteArray &records) {
+    QFile journal(journalPath_);
+    if (!journal.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        errorString_ = journal.errorString();
+        return false;
+    }
+    if (journal.write(records) != records.size() || !journal.flush()) {
+        errorString_ = journal.errorString();
+        return false;
+    }
+    journalBytes_ += records.size();
+    return true;
+}
+
+bool AutosaveJournal::recover(const QString &cpackPath,
+                              const QString &journalPath,
+                              CpackFileHandler &out,
+                              QString *error) {
+    CpackFileHandler archive;
+    if (!archive.load(cpackPath)) {
+        if (error) {
+            *error = archive.errorString();
+        }
+        return false;
+    }
+    out = archive;
+
+    const quint64 stamp = archive.getFile(kBaseStampFile).toULongLong();
+    QFile journal(journalPath);
+    if (stamp == 0 || !journal.open(QIODevice::ReadOnly)) {
+        return true;
+    }
+
+    QDataStream in(&journal);
+    in.setByteOrder(QDataStream::LittleEndian);
+    char magic[4] = {};
+    quint16 version = 0;
+    quint64 journalStamp = 0;
+    in.readRawData(magic, 4);
+    in >> version >> journalStamp;
+    if (in.status() != QDataStream::Ok ||
+        !std::equal(magic, magic + 4, kJournalMagic) ||
+        version != kJournalVersion ||
+        journalStamp != stamp) {
+        return true;
+    }
+
+    while (!journal.atEnd()) {
+        quint32 length = 0;
+        quint32 crc = 0;
+        in >> length >> crc;
+        if (in.status() != QDataStream::Ok || length > kMaxRecordBytes) {
+            break;
+        }
+        const QByteArray payload = journal.read(length);
+        if (static_cast<quint32>(payload.size()) != length ||
+            CpackFileHandler::calculateCrc32(payload) != crc) {
+            break;  // torn tail
+        }
+
+        QDataStream record(payload);
+        record.setByteOrder(QDataStream::LittleEndian);
+        quint8 op = 0;
+        quint16 nameLength = 0;
+        record >> op >> nameLength;
+        QByteArray nameBytes(nameLength, Qt::Uninitialized);
+        record.readRawData(nameBytes.data(), nameLength);
+        quint32 offset = 0;
+        quint32 removed = 0;
+        quint32 insertedLength = 0;
+        record >> offset >> removed >> insertedLength;
+        if (record.status() != QDataStream::Ok || insertedLength > length) {
+            break;
+        }
+        QByteArray inserted(static_cast<qsizetype>(insertedLength), Qt::Uninitialized);
+        record.readRawData(inserted.data(), static_cast<int>(insertedLength));
+        quint32 resultCrc = 0;
+        record >> resultCrc;
+        if (record.status() != QDataStream::Ok) {
+            break;
+        }
+
+        const QString name = QString::fromUtf8(nameBytes);
+        if (op == static_cast<quint8>(Op::Remove)) {
+            out.removeFile(name);
+            continue;
+        }
+        if (op != static_cast<quint8>(Op::Patch)) {
+            break;
+        }
+
+        QByteArray entry = out.getFile(name);
+        if (static_cast<qint64>(offset) + removed > entry.size()) {
+            break;
+        }
+        entry.replace(offset, removed, inserted);
+        if (CpackFileHandler::calculateCrc32(entry) != resultCrc) {
+            break;
+        }
+        out.addFile(name, entry);
+    }
+    return true;
+}
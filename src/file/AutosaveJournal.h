@@ -0,0 +1,71 @@
+#pragma once
+
+#include "file/CpackFileHandler.h"
+
+#include <QByteArray>
+#include <QString>
+
+// Incremental autosave storage: a compacted .cpack plus an append-only journal.
+//
+// Each write() diffs every archive entry against the last persisted state and
+// appends one record per changed entry (common prefix/suffix trimmed, so a
+// single keystroke costs a few dozen bytes). Once the journal outgrows the
+// compacted archive it is folded back into a fresh .cpack.
+//
+// Journal layout (little endian):
+//   header:  "CFJL" magic, quint16 version, quint64 base stamp
+//   record:  quint32 payload length, quint32 payload CRC-32, payload
+//   payload: quint8 op, quint16 name length, name (UTF-8),
+//            quint32 offset, quint32 removed length, quint32 inserted length,
+//            inserted bytes, quint32 CRC-32 of the patched entry
+//
+// The base stamp is also stored in the archive as "journal.base", so a journal
+// is never replayed onto an archive it was not written against. Replay stops
+// at the first torn or corrupt record (a crash mid-append).
+class AutosaveJournal {
+public:
+    AutosaveJournal(const QString &cpackPath, const QString &journalPath);
+
+    // Persist `state`, appending deltas or compacting as needed
+    bool write(const CpackFileHandler &state);
+
+    // Rewrite the archive from `state` and start an empty journal
+    bool compact(const CpackFileHandler &state);
+
+    // Forget the in-memory base; the next write() compacts
+    void reset();
+
+    QString errorString() const { return errorString_; }
+
+    // Rebuild the latest state from archive + journal. Returns false if no
+    // usable archive exists; a missing or mismatched journal is not an error.
+    static bool recover(const QString &cpackPath,
+                        const QString &journalPath,
+                        CpackFileHandler &out,
+                        QString *error = nullptr);
+
+    static constexpr const char *kBaseStampFile = "journal.base";
+
+private:
+    enum class Op : quint8 {
+        Patch = 0,
+        Remove = 1,
+    };
+
+    static QByteArray encodeRecord(Op op,
+                                   const QString &name,
+                                   quint32 offset,
+                                   quint32 removed,
+                                   const QByteArray &inserted,
+                                   const QByteArray &result);
+    bool appendRecords(const QByteArray &records);
+
+    QString cpackPath_;
+    QString journalPath_;
+    CpackFileHandler base_;
+    bool hasBase_ = false;
+    quint64 stamp_ = 0;
+    qint64 baseBytes_ = 0;
+    qint64 journalBytes_ = 0;
+    QString errorString_;
+};
@@ -0,0 +1,107 @@
+#include "file/AutosaveWriter.h"
+#include "file/AutosaveJournal.h"
+#include "file/CpackFileHandler.h"
+
+#include <QFile>
+#include <QFutureWatcher>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QtConcurrent>
+
+AutosaveWriter::AutosaveWriter(const QString &cpackPath,
+                               const QString &journalPath,
+                               const QString &metaPath,
+                               QObject *parent)
+    : QObject(parent),
+      cpackPath_(cpackPath),
+      journalPath_(journalPath),
+      metaPath_(metaPath),
+      journal_(std::make_unique<AutosaveJournal>(cpackPath, journalPath)),
+      watcher_(new QFutureWatcher<bool>(this)) {
+    connect(watcher_, &QFutureWatcher<bool>::finished, this, [this]() {
+        const bool ok = watcher_->result();
+        if (clearAfterWrite_) {
+            // The snapshot that just landed is stale (document was saved or
+            // discarded meanwhile).
+            clearAfterWrite_ = false;
+            removeFiles();
+        }
+        emit written(ok);
+        startNext();
+    });
+}
+
+AutosaveWriter::~AutosaveWriter() {
+    pending_.reset();
+    waitForIdle();
+    if (clearAfterWrite_) {
+        removeFiles();
+    }
+}
+
+void AutosaveWriter::request(const ProjectSnapshot &snapshot, const QJsonObject &meta) {
+    pending_ = Job{snapshot, meta, false};
+    if (!isBusy()) {
+        startNext();
+    }
+}
+
+void AutosaveWriter::clear() {
+    pending_.reset();
+    if (isBusy()) {
+        clearAfterWrite_ = true;
+    }
+    resetJournal_ = true;
+    removeFiles();
+}
+
+void AutosaveWriter::waitForIdle() {
+    if (watcher_) {
+        watcher_->waitForFinished();
+    }
+}
+
+bool AutosaveWriter::isBusy() const {
+    return watcher_ && watcher_->isRunning();
+}
+
+void AutosaveWriter::startNext() {
+    if (!pending_) {
+        return;
+    }
+    Job job = std::move(*pending_);
+    pending_.reset();
+    job.resetJournal = resetJournal_;
+    resetJournal_ = false;
+
+    AutosaveJournal *journal = journal_.get();
+    const QString metaPath = metaPath_;
+    watcher_->setFuture(QtConcurrent::run([job = std::move(job), journal, metaPath]() {
+        return writeJob(job, *journal, metaPath);
+    }));
+}
+
+void AutosaveWriter::removeFiles() const {
+    QFile::remove(cpackPath_);
+    QFile::remove(journalPath_);
+    QFile::remove(metaPath_);
+}
+
+bool AutosaveWriter::writeJob(const Job &job, AutosaveJournal &journal, const QString &metaPath) {
+    if (job.resetJournal) {
+        journal.reset();
+    }
+
+    CpackFileHandler handler;
+    job.snapshot.writeTo(handler);
+    if (!journal.write(handler)) {
+        return false;
+    }
+
+    QSaveFile metaFile(metaPath);
+    if (!metaFile.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    metaFile.write(QJsonDocument(job.meta).toJson(QJsonDocument::Indented));
+    return metaFile.commit();
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "file/ProjectSnapshot.h"
+
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+#include <memory>
+#include <optional>
+
+template <typename T>
+class QFutureWatcher;
+class AutosaveJournal;
+
+// Writes autosave snapshots on a worker thread.
+//
+// The GUI thread only captures a ProjectSnapshot (cheap, implicitly shared
+// strings) and hands it over. Diffing, CRC computation and disk I/O run in
+// QtConcurrent; each write appends deltas to an AutosaveJournal, which
+// compacts itself into the .cpack when it grows too large. At most one write is in flight; a
+// request that arrives while busy replaces any queued snapshot, so a burst of
+// requests collapses into a single follow-up write of the newest state.
+class AutosaveWriter : public QObject {
+    Q_OBJECT
+
+public:
+    AutosaveWriter(const QString &cpackPath,
+                   const QString &journalPath,
+                   const QString &metaPath,
+                   QObject *parent = nullptr);
+    ~AutosaveWriter() override;
+
+    void request(const ProjectSnapshot &snapshot, const QJsonObject &meta);
+
+    // Drop queued work and delete the autosave files. A write that is
+    // already running is discarded as soon as it lands.
+    void clear();
+
+    // Block until the in-flight write (if any) has finished.
+    void waitForIdle();
+
+    bool isBusy() const;
+
+signals:
+    void written(bool success);
+
+private:
+    struct Job {
+        ProjectSnapshot snapshot;
+        QJsonObject meta;
+        bool resetJournal = false;
+    };
+
+    void startNext();
+    void removeFiles() const;
+    static bool writeJob(const Job &job, AutosaveJournal &journal, const QString &metaPath);
+
+    QString cpackPath_;
+    QString journalPath_;
+    QString metaPath_;
+    // Only touched by the (single) in-flight job
+    std::unique_ptr<AutosaveJournal> journal_;
+    QFutureWatcher<bool> *watcher_ = nullptr;
+    std::optional<Job> pending_;
+    bool clearAfterWrite_ = false;
+    bool resetJournal_ = true;
+};
@@ -6,6 +6,7 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QRegularExpression>
+#include <QSaveFile>
 
 namespace {
 constexpr quint32 kLocalFileSignature = 0x04034b50;
@@ -125,27 +126,74 @@ QString CpackFileHandler::createManifest() const {
 }
 
 void CpackFileHandler::addFile(const QString &name, const QByteArray &content) {
+    lazyEntries_.remove(name);
     files_[name] = content;
 }
 
 QByteArray CpackFileHandler::getFile(const QString &name) const {
+    errorString_.clear();
+    const auto lazy = lazyEntries_.constFind(name);
+    if (lazy != lazyEntries_.constEnd()) {
+        return readLazyEntry(name, lazy.value());
+    }
     return files_.value(name);
 }
 
+void CpackFileHandler::removeFile(const QString &name) {
+    files_.remove(name);
+    lazyEntries_.remove(name);
+}
+
 bool CpackFileHandler::hasFile(const QString &name) const {
-    return files_.contains(name);
+    return files_.contains(name) || lazyEntries_.contains(name);
 }
 
 QStringList CpackFileHandler::fileNames() const {
-    return files_.keys();
+    QStringList names = files_.keys();
+    names.append(lazyEntries_.keys());
+    names.sort();
+    return names;
 }
 
 void CpackFileHandler::clear() {
     files_.clear();
+    lazyEntries_.clear();
+    sourcePath_.clear();
+}
+
+QByteArray CpackFileHandler::readLazyEntry(const QString &name, const LazyEntry &entry) const {
+    QFile file(sourcePath_);
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(entry.offset)) {
+        errorString_ = file.errorString();
+        return QByteArray();
+    }
+    const QByteArray content = file.read(entry.size);
+    if (static_cast<quint32>(content.size()) != entry.size) {
+        errorString_ = QString("Truncated archive (incomplete data for '%1')").arg(name);
+        return QByteArray();
+    }
+    if (calculateCrc32(content) != entry.crc) {
+        errorString_ = QString("CRC-32 mismatch for '%1'").arg(name);
+        return QByteArray();
+    }
+    return content;
 }
 
 bool CpackFileHandler::save(const QString &path) const {
-    QFile file(path);
+    // Pull lazily indexed entries into memory first; `path` may be the very
+    // archive they live in.
+    QMap<QString, QByteArray> entries = files_;
+    for (auto it = lazyEntries_.constBegin(); it != lazyEntries_.constEnd(); ++it) {
+        const QByteArray content = readLazyEntry(it.key(), it.value());
+        if (content.size() != static_cast<qsizetype>(it.value().size)) {
+            return false;
+        }
+        entries.insert(it.key(), content);
+    }
+
+    // QSaveFile writes to a temporary next to `path` and renames on commit(),
+    // so a crash mid-write never leaves a truncated archive behind.
+    QSaveFile file(path);
     if (!file.open(QIODevice::WriteOnly)) {
         errorString_ = file.errorString();
         return false;
@@ -212,7 +260,7 @@ bool CpackFileHandler::save(const QString &path) const {
     }
 
     // Write local file headers and data
-    for (auto it = files_.constBegin(); it != files_.constEnd(); ++it) {
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
         const QString &name = it.key();
         const QByteArray &content = it.value();
         const QByteArray nameBytes = name.toUtf8();
@@ -284,18 +332,22 @@ bool CpackFileHandler::save(const QString &path) const {
     stream << quint16(0);  // comment length
     if (!streamOk()) return false;
 
-    file.close();
-    return file.error() == QFileDevice::NoError;
+    if (!file.commit()) {
+        errorString_ = file.errorString();
+        return false;
+    }
+    return true;
 }
 
-bool CpackFileHandler::load(const QString &path) {
+bool CpackFileHandler::load(const QString &path, const QString &lazyPrefix) {
     QFile file(path);
     if (!file.open(QIODevice::ReadOnly)) {
         errorString_ = file.errorString();
         return false;
     }
 
-    files_.clear();
+    clear();
+    sourcePath_ = path;
     QDataStream stream(&file);
     stream.setByteOrder(QDataStream::LittleEndian);
 
@@ -339,6 +391,23 @@ bool CpackFileHandler::load(const QString &path) {
                 return false;
             }
 
+            const QString entryName = QString::fromUtf8(fileName);
+            if (!lazyPrefix.isEmpty() && entryName.startsWith(lazyPrefix)) {
+                const QString safeName = sanitizeFilename(entryName);
+                if (safeName.isEmpty()) {
+                    errorString_ = QString("Invalid filename in archive: %1").arg(entryName);
+                    return false;
+                }
+                const qint64 offset = file.pos();
+                if (offset + compressedSize > file.size()) {
+                    errorString_ = "Truncated archive (incomplete file data)";
+                    return false;
+                }
+                file.seek(offset + compressedSize);
+                lazyEntries_[safeName] = LazyEntry{offset, compressedSize, crc};
+                continue;
+            }
+
             QByteArray content = file.read(compressedSize);
             if (static_cast<quint32>(content.size()) != compressedSize) {
                 errorString_ = "Truncated archive (incomplete file data)";
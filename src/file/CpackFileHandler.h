@@ -22,9 +22,14 @@ public:
     // Add a file to the archive (call before save)
     void addFile(const QString &name, const QByteArray &content);
     
-    // Get a file from the archive (call after load)
+    // Get a file from the archive (call after load). Lazily indexed entries
+    // are read from disk on each call; an empty array is returned, and
+    // errorString() says why, if the read or its CRC check fails.
     QByteArray getFile(const QString &name) const;
     
+    // Remove a file from the archive (no-op if absent)
+    void removeFile(const QString &name);
+
     // Check if a file exists in the archive
     bool hasFile(const QString &name) const;
     
@@ -37,19 +42,31 @@ public:
     // Save archive to disk
     bool save(const QString &path) const;
     
-    // Load archive from disk
-    bool load(const QString &path);
+    // Load archive from disk. Entries whose name starts with `lazyPrefix`
+    // are only indexed; their content stays on disk until requested.
+    bool load(const QString &path, const QString &lazyPrefix = QString());
     
     // Error message from last operation
     QString errorString() const { return errorString_; }
 
+    // Standard ZIP CRC-32 (also used to checksum autosave journal records)
+    static quint32 calculateCrc32(const QByteArray &data);
+
 private:
     static constexpr int kManifestVersion = 1;
     static constexpr const char *kManifestFile = "manifest.json";
-    
-    static quint32 calculateCrc32(const QByteArray &data);
+
     QString createManifest() const;
 
+    struct LazyEntry {
+        qint64 offset = 0;
+        quint32 size = 0;
+        quint32 crc = 0;
+    };
+    QByteArray readLazyEntry(const QString &name, const LazyEntry &entry) const;
+
     QMap<QString, QByteArray> files_;
+    QMap<QString, LazyEntry> lazyEntries_;
+    QString sourcePath_;
     mutable QString errorString_;
 };
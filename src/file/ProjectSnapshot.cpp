@@ -0,0 +1,45 @@
+#include "file/ProjectSnapshot.h"
+#include "file/CpackFileHandler.h"
+#include "file/TestStore.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+
+QByteArray ProjectSnapshot::testcasesJson() const {
+    QJsonArray testsArray;
+    for (const auto &test : tests) {
+        QJsonObject testObj;
+        testObj["input"] = test.input;
+        testObj["output"] = test.expectedOutput;
+        testsArray.append(testObj);
+    }
+
+    QJsonObject testsDoc;
+    testsDoc["tests"] = testsArray;
+    testsDoc["timeout"] = timeoutSec;
+    return QJsonDocument(testsDoc).toJson(QJsonDocument::Indented);
+}
+
+void ProjectSnapshot::writeTo(CpackFileHandler &handler) const {
+    handler.addFile("solution.cpp", solution.toUtf8());
+    handler.addFile("brute.cpp", brute.toUtf8());
+    handler.addFile("generator.cpp", generator.toUtf8());
+    handler.addFile("template.cpp", templateCode.toUtf8());
+
+    if (problemEdited) {
+        handler.addFile("problem.json", problemRaw.toUtf8());
+    } else if (!problem.isEmpty()) {
+        QJsonDocument problemDoc(problem);
+        handler.addFile("problem.json", problemDoc.toJson(QJsonDocument::Indented));
+    }
+
+    if (testcasesEdited) {
+        handler.addFile("testcases.json", testcasesRaw.toUtf8());
+    } else if (!tests.empty()) {
+        if (binaryTests) {
+            TestStore::write(handler, tests, timeoutSec);
+        } else {
+            handler.addFile("testcases.json", testcasesJson());
+        }
+    }
+}
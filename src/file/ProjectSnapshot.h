@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+#include <vector>
+
+class CpackFileHandler;
+
+struct TestCase {
+    QString input;
+    QString expectedOutput;
+};
+
+// Value copy of everything that ends up inside a .cpack.
+// QString and QJsonObject are implicitly shared, so taking a snapshot on the
+// GUI thread only bumps reference counts; serializing it (JSON, CRC, disk I/O)
+// can then happen on any thread without touching widgets.
+struct ProjectSnapshot {
+    QString solution;
+    QString brute;
+    QString generator;
+    QString templateCode;
+    QJsonObject problem;
+    QString problemRaw;
+    bool problemEdited = false;
+    QString testcasesRaw;
+    bool testcasesEdited = false;
+    std::vector<TestCase> tests;
+    int timeoutSec = 5;
+    // Write tests through TestStore instead of testcases.json
+    bool binaryTests = false;
+
+    // testcases.json contents built from `tests` (ignores testcasesRaw)
+    QByteArray testcasesJson() const;
+
+    // Add all archive entries to the handler (call before handler.save)
+    void writeTo(CpackFileHandler &handler) const;
+};
@@ -0,0 +1,163 @@
+#include "file/TestStore.h"
+#include "file/CpackFileHandler.h"
+
+#include <QDataStream>
+#include <QIODevice>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+
+namespace {
+constexpr char kIndexMagic[4] = {'C', 'F', 'T', 'S'};
+constexpr quint16 kIndexVersion = 1;
+constexpr quint32 kMaxTests = 1000000;
+} // namespace
+
+bool TestStore::hasStore(const CpackFileHandler &handler) {
+    return handler.hasFile(kIndexFile);
+}
+
+void TestStore::write(CpackFileHandler &handler,
+                      const std::vector<TestCase> &tests,
+                      int timeoutSec) {
+    QByteArray index;
+    QDataStream stream(&index, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.writeRawData(kIndexMagic, 4);
+    stream << kIndexVersion << quint32(timeoutSec) << quint32(tests.size());
+
+    std::vector<QByteArray> outputs;
+    outputs.reserve(tests.size());
+    for (size_t i = 0; i < tests.size(); ++i) {
+        const QByteArray input = tests[i].input.toUtf8();
+        stream << quint32(input.size());
+        handler.addFile(entryName(static_cast<int>(i), ".in"), input);
+        outputs.push_back(tests[i].expectedOutput.toUtf8());
+    }
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        stream << quint32(outputs[i].size());
+        handler.addFile(entryName(static_cast<int>(i), ".out"), outputs[i]);
+    }
+
+    handler.addFile(kIndexFile, index);
+}
+
+bool TestStore::readIndex(const CpackFileHandler &handler, Index &index) {
+    const QByteArray bytes = handler.getFile(kIndexFile);
+    QDataStream stream(bytes);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    char magic[4] = {};
+    quint16 version = 0;
+    quint32 timeout = 0;
+    quint32 count = 0;
+    stream.readRawData(magic, 4);
+    stream >> version >> timeout >> count;
+    if (stream.status() != QDataStream::Ok ||
+        !std::equal(magic, magic + 4, kIndexMagic) ||
+        version != kIndexVersion ||
+        count > kMaxTests) {
+        return false;
+    }
+
+    index.timeoutSec = static_cast<int>(timeout);
+    index.inputSizes.assign(count, 0);
+    index.outputSizes.assign(count, 0);
+    for (quint32 &size : index.inputSizes) {
+        stream >> size;
+    }
+    for (quint32 &size : index.outputSizes) {
+        stream >> size;
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+QByteArray TestStore::readInput(const CpackFileHandler &handler, int test) {
+    return handler.getFile(entryName(test, ".in"));
+}
+
+QByteArray TestStore::readOutput(const CpackFileHandler &handler, int test) {
+    return handler.getFile(entryName(test, ".out"));
+}
+
+bool TestStore::readTests(const CpackFileHandler &handler,
+                          std::vector<TestCase> &tests,
+                          int &timeoutSec,
+                          QString *error) {
+    tests.clear();
+    auto fail = [&tests, error](const QString &message) {
+        tests.clear();
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+
+    if (hasStore(handler)) {
+        Index index;
+        if (!readIndex(handler, index)) {
+            return fail(QString("Invalid '%1'").arg(QLatin1String(kIndexFile)));
+        }
+        // An unreadable entry comes back empty, so the index sizes are what
+        // tell a damaged test from an empty one
+        auto read = [&handler](const QString &name, quint32 size, QByteArray &bytes,
+                               QString &message) {
+            if (!handler.hasFile(name)) {
+                message = QString("Missing '%1'").arg(name);
+                return false;
+            }
+            bytes = handler.getFile(name);
+            if (static_cast<quint32>(bytes.size()) != size) {
+                message = !handler.errorString().isEmpty()
+                    ? handler.errorString()
+                    : QString("Size of '%1' does not match the test index").arg(name);
+                return false;
+            }
+            return true;
+        };
+        tests.reserve(static_cast<size_t>(index.count()));
+        for (int i = 0; i < index.count(); ++i) {
+            const size_t row = static_cast<size_t>(i);
+            QByteArray input;
+            QByteArray output;
+            QString message;
+            if (!read(entryName(i, ".in"), index.inputSizes[row], input, message) ||
+                !read(entryName(i, ".out"), index.outputSizes[row], output, message)) {
+                return fail(message);
+            }
+            tests.push_back({QString::fromUtf8(input), QString::fromUtf8(output)});
+        }
+        timeoutSec = index.timeoutSec;
+        return true;
+    }
+
+    if (!handler.hasFile("testcases.json")) {
+        return true;
+    }
+    QJsonParseError parseError;
+    const QJsonDocument testsDoc =
+        QJsonDocument::fromJson(handler.getFile("testcases.json"), &parseError);
+    if (parseError.error != QJsonParseError::NoError || !testsDoc.isObject()) {
+        return fail(QString("Invalid 'testcases.json': %1").arg(parseError.errorString()));
+    }
+    const QJsonObject testsObj = testsDoc.object();
+    if (testsObj.contains("timeout")) {
+        timeoutSec = testsObj["timeout"].toInt(5);
+    }
+    const QJsonArray testsArray = testsObj["tests"].toArray();
+    tests.reserve(static_cast<size_t>(testsArray.size()));
+    for (const QJsonValue &testVal : testsArray) {
+        const QJsonObject test = testVal.toObject();
+        tests.push_back({test["input"].toString(), test["output"].toString()});
+    }
+    return true;
+}
+
+QString TestStore::entryName(int test, const char *suffix) {
+    return QString("%1%2%3")
+        .arg(QLatin1String(kPrefix))
+        .arg(test, 6, 10, QChar('0'))
+        .arg(QLatin1String(suffix));
+}
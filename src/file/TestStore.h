@@ -0,0 +1,60 @@
+#pragma once
+
+#include "file/ProjectSnapshot.h"
+
+#include <QByteArray>
+#include <QString>
+#include <vector>
+
+class CpackFileHandler;
+
+// Binary test-case storage inside a .cpack (alternative to testcases.json).
+//
+//   tests/index.bin   - "CFTS" magic, quint16 version, quint32 timeout,
+//                       quint32 count, then two columns of count x quint32:
+//                       input sizes, output sizes (little endian)
+//   tests/000000.in   - raw input bytes of test 0 (no JSON escaping)
+//   tests/000000.out  - raw expected output of test 0
+//
+// Entries are plain STORE members, so with CpackFileHandler::load(path,
+// TestStore::kPrefix) each test is only read from disk when requested.
+// Nothing uses that yet: every open path goes through readTests(), which
+// reads them all, and runners take their input from the loaded tests, not
+// from the archive. What the store saves is the JSON escaping and parsing.
+class TestStore {
+public:
+    struct Index {
+        int timeoutSec = 5;
+        std::vector<quint32> inputSizes;
+        std::vector<quint32> outputSizes;
+
+        int count() const { return static_cast<int>(inputSizes.size()); }
+    };
+
+    static constexpr const char *kPrefix = "tests/";
+    static constexpr const char *kIndexFile = "tests/index.bin";
+
+    static bool hasStore(const CpackFileHandler &handler);
+
+    // Add index + per-test entries to the handler
+    static void write(CpackFileHandler &handler,
+                      const std::vector<TestCase> &tests,
+                      int timeoutSec);
+
+    static bool readIndex(const CpackFileHandler &handler, Index &index);
+    static QByteArray readInput(const CpackFileHandler &handler, int test);
+    static QByteArray readOutput(const CpackFileHandler &handler, int test);
+
+    // Read all tests from the binary store, or from testcases.json when the
+    // archive has no store; an archive with neither has no tests. Every test
+    // is read (and CRC-checked) here, so this costs the archive's total test
+    // size. Returns false with `error` set if either is invalid, or if any
+    // entry is missing, fails its check or differs in size from the index.
+    static bool readTests(const CpackFileHandler &handler,
+                          std::vector<TestCase> &tests,
+                          int &timeoutSec,
+                          QString *error = nullptr);
+
+private:
+    static QString entryName(int test, const char *suffix);
+};
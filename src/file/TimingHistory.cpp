@@ -0,0 +1,274 @@
+#include "file/TimingHistory.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+
+namespace {
+constexpr char kMagic[4] = {'C', 'F', 'T', 'H'};
+constexpr quint16 kVersion = 1;
+constexpr qint64 kHeaderSize = 4 + 2;
+constexpr qint64 kRecordSize = 8 + 8 + 8 + 8 + 4;
+constexpr qint64 kMinCompactRecords = 4096;
+// Runs of one solution that feed its median
+constexpr size_t kMedianRuns = 5;
+
+QByteArray encodeHeader() {
+    QByteArray header;
+    QDataStream stream(&header, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.writeRawData(kMagic, 4);
+    stream << kVersion;
+    return header;
+}
+
+void encodeRecord(QDataStream &stream, quint64 problem, quint64 test,
+                  const TimingHistory::Sample &sample) {
+    stream << problem << test << sample.solution << sample.stamp << sample.timeMs;
+}
+
+// Median of the last kMedianRuns samples in [first, last)
+qint64 median(std::vector<TimingHistory::Sample>::const_iterator first,
+              std::vector<TimingHistory::Sample>::const_iterator last) {
+    if (last - first > static_cast<std::ptrdiff_t>(kMedianRuns)) {
+        first = last - static_cast<std::ptrdiff_t>(kMedianRuns);
+    }
+    std::vector<quint32> times;
+    for (auto it = first; it != last; ++it) {
+        times.push_back(it->timeMs);
+    }
+    if (times.empty()) {
+        return -1;
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+} // namespace
+
+QString TimingHistory::Trend::text() const {
+    if (timesMs.empty()) {
+        return QString();
+    }
+    QString result = QString("%1 %2 ms").arg(sparkline(timesMs)).arg(currentMs);
+    if (baselineMs >= 0) {
+        const qint64 percent = baselineMs > 0
+            ? (currentMs - baselineMs) * 100 / baselineMs
+            : 0;
+        result += QString(" \u2022 %1%2% vs %3 ms")
+                      .arg(percent >= 0 ? QString("+") : QString())
+                      .arg(percent)
+                      .arg(baselineMs);
+    }
+    return result;
+}
+
+TimingHistory::TimingHistory(const QString &path)
+    : path_(path) {}
+
+TimingHistory::~TimingHistory() {
+    flush();
+}
+
+QString TimingHistory::defaultPath() {
+    QString base = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    if (base.isEmpty()) {
+        base = QDir::homePath() + "/.cfdojo";
+    }
+    return QDir(base).filePath("timing.bin");
+}
+
+quint64 TimingHistory::hash(const QByteArray &data) {
+    const QByteArray digest = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+    quint64 value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value = (value << 8) | static_cast<quint8>(digest.at(i));
+    }
+    return value;
+}
+
+QString TimingHistory::sparkline(const std::vector<quint32> &values) {
+    if (values.empty()) {
+        return QString();
+    }
+    const auto [low, high] = std::minmax_element(values.begin(), values.end());
+    const quint32 range = *high - *low;
+    QString line;
+    line.reserve(static_cast<int>(values.size()));
+    for (quint32 value : values) {
+        // Eight block heights, U+2581 to U+2588; a flat history sits mid-height
+        const int level = range == 0 ? 3 : static_cast<int>((value - *low) * 7 / range);
+        line += QChar(0x2581 + level);
+    }
+    return line;
+}
+
+void TimingHistory::record(quint64 problem, quint64 test, quint64 solution, qint64 timeMs) {
+    if (timeMs < 0) {
+        return;
+    }
+    ensureLoaded();
+    Sample sample;
+    sample.solution = solution;
+    sample.stamp = QDateTime::currentSecsSinceEpoch();
+    sample.timeMs = static_cast<quint32>(std::min<qint64>(timeMs, 0xffffffff));
+    append({problem, test}, sample);
+
+    QDataStream stream(&pending_, QIODevice::WriteOnly | QIODevice::Append);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    encodeRecord(stream, problem, test, sample);
+}
+
+TimingHistory::Trend TimingHistory::trend(quint64 problem, quint64 test) {
+    ensureLoaded();
+    Trend result;
+    const auto found = samples_.find({problem, test});
+    if (found == samples_.end() || found->second.empty()) {
+        return result;
+    }
+    const std::vector<Sample> &samples = found->second;
+
+    const size_t shown = std::min<size_t>(samples.size(), kSparklineSamples);
+    for (auto it = samples.end() - static_cast<std::ptrdiff_t>(shown); it != samples.end(); ++it) {
+        result.timesMs.push_back(it->timeMs);
+    }
+
+    // The current solution's runs are the newest block; the block before it
+    // belongs to the solution it replaced
+    auto currentBegin = samples.end();
+    while (currentBegin != samples.begin() &&
+           (currentBegin - 1)->solution == samples.back().solution) {
+        --currentBegin;
+    }
+    result.currentMs = median(currentBegin, samples.end());
+    if (currentBegin != samples.begin()) {
+        auto previousBegin = currentBegin;
+        const quint64 previous = (currentBegin - 1)->solution;
+        while (previousBegin != samples.begin() && (previousBegin - 1)->solution == previous) {
+            --previousBegin;
+        }
+        result.baselineMs = median(previousBegin, currentBegin);
+        result.regressed = result.currentMs >= result.baselineMs * kRegressionRatio &&
+                           result.currentMs - result.baselineMs >= kRegressionMinMs;
+    }
+    return result;
+}
+
+bool TimingHistory::flush() {
+    if (pending_.isEmpty()) {
+        return true;
+    }
+    const qint64 pendingRecords = pending_.size() / kRecordSize;
+    if (diskRecords_ < 0 ||
+        diskRecords_ + pendingRecords > std::max(kMinCompactRecords, 2 * liveRecords_)) {
+        return compact();
+    }
+
+    QDir().mkpath(QFileInfo(path_).absolutePath());
+    QFile file(path_);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        errorString_ = file.errorString();
+        return false;
+    }
+    if (file.size() == 0) {
+        file.write(encodeHeader());
+    }
+    if (file.write(pending_) != pending_.size()) {
+        errorString_ = file.errorString();
+        // The tail is torn; the next flush rewrites the file
+        diskRecords_ = -1;
+        return false;
+    }
+    diskRecords_ += pendingRecords;
+    pending_.clear();
+    return true;
+}
+
+void TimingHistory::ensureLoaded() {
+    if (loaded_) {
+        return;
+    }
+    loaded_ = true;
+
+    QFile file(path_);
+    if (!file.exists()) {
+        return;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        errorString_ = file.errorString();
+        return;
+    }
+    const QByteArray bytes = file.readAll();
+    QDataStream stream(bytes);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    char magic[4] = {};
+    quint16 version = 0;
+    stream.readRawData(magic, 4);
+    stream >> version;
+    if (stream.status() != QDataStream::Ok ||
+        !std::equal(magic, magic + 4, kMagic) ||
+        version != kVersion) {
+        // Unknown or damaged file: start over
+        diskRecords_ = -1;
+        return;
+    }
+
+    const qint64 count = (bytes.size() - kHeaderSize) / kRecordSize;
+    for (qint64 i = 0; i < count; ++i) {
+        quint64 problem = 0;
+        quint64 test = 0;
+        Sample sample;
+        stream >> problem >> test >> sample.solution >> sample.stamp >> sample.timeMs;
+        append({problem, test}, sample);
+    }
+    diskRecords_ = count;
+    if ((bytes.size() - kHeaderSize) % kRecordSize != 0) {
+        // A crash mid-append; appending after it would misalign every record
+        diskRecords_ = -1;
+    }
+}
+
+void TimingHistory::append(const Key &key, const Sample &sample) {
+    std::vector<Sample> &samples = samples_[key];
+    samples.push_back(sample);
+    ++liveRecords_;
+    if (samples.size() > static_cast<size_t>(kMaxSamples)) {
+        samples.erase(samples.begin());
+        --liveRecords_;
+    }
+}
+
+bool TimingHistory::compact() {
+    QByteArray records;
+    records.reserve(static_cast<int>(kHeaderSize + liveRecords_ * kRecordSize));
+    records += encodeHeader();
+    QDataStream stream(&records, QIODevice::WriteOnly | QIODevice::Append);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    for (const auto &[key, samples] : samples_) {
+        for (const Sample &sample : samples) {
+            encodeRecord(stream, key.first, key.second, sample);
+        }
+    }
+
+    QDir().mkpath(QFileInfo(path_).absolutePath());
+    QSaveFile file(path_);
+    if (!file.open(QIODevice::WriteOnly)) {
+        errorString_ = file.errorString();
+        return false;
+    }
+    file.write(records);
+    if (!file.commit()) {
+        errorString_ = file.errorString();
+        return false;
+    }
+    diskRecords_ = liveRecords_;
+    pending_.clear();
+    return true;
+}
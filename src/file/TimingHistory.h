@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <map>
+#include <utility>
+#include <vector>
+
+// Local history of test run times, keyed by problem, test and solution
+// hashes, so the test panel can show a trend per test and flag a test that
+// got notably slower after the solution changed.
+//
+// File layout (little endian), append-only:
+//   header: "CFTH" magic, quint16 version
+//   record: quint64 problem, quint64 test, quint64 solution,
+//           qint64 unix seconds, quint32 time in ms
+//
+// Only the newest kMaxSamples runs per test are kept in memory; the file is
+// rewritten once it holds well over that many dead records. Records are
+// buffered by record() and written by flush().
+class TimingHistory {
+public:
+    struct Sample {
+        quint64 solution = 0;
+        qint64 stamp = 0;
+        quint32 timeMs = 0;
+    };
+
+    struct Trend {
+        std::vector<quint32> timesMs;  // oldest first, for the sparkline
+        qint64 currentMs = -1;         // median of the current solution's runs
+        qint64 baselineMs = -1;        // median of the previous solution's runs
+        bool regressed = false;
+
+        bool isEmpty() const { return timesMs.empty(); }
+        // "▂▃▇ 24 ms • +60% vs 15 ms"
+        QString text() const;
+    };
+
+    static constexpr int kMaxSamples = 32;
+    static constexpr int kSparklineSamples = 16;
+    // Slower by both this factor and kRegressionMinMs counts as a regression
+    static constexpr double kRegressionRatio = 1.25;
+    static constexpr qint64 kRegressionMinMs = 5;
+
+    explicit TimingHistory(const QString &path = defaultPath());
+    ~TimingHistory();
+
+    // <app data>/timing.bin
+    static QString defaultPath();
+
+    // Stable 64-bit content hash (the first bytes of a SHA-1)
+    static quint64 hash(const QByteArray &data);
+    static QString sparkline(const std::vector<quint32> &values);
+
+    void record(quint64 problem, quint64 test, quint64 solution, qint64 timeMs);
+    Trend trend(quint64 problem, quint64 test);
+    // Append buffered records (compacting the file when it is mostly stale)
+    bool flush();
+
+    QString errorString() const { return errorString_; }
+
+private:
+    using Key = std::pair<quint64, quint64>;
+
+    void ensureLoaded();
+    void append(const Key &key, const Sample &sample);
+    bool compact();
+
+    QString path_;
+    bool loaded_ = false;
+    std::map<Key, std::vector<Sample>> samples_;
+    QByteArray pending_;
+    qint64 liveRecords_ = 0;
+    qint64 diskRecords_ = 0;
+    QString errorString_;
+};
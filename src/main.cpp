@@ -3,6 +3,7 @@
 #include <QIcon>
 #include <QPlainTextEdit>
 #include "app/MainWindow.h"
+#include "cli/CommandLine.h"
 #include "Version.h"
 
 #include <csignal>
@@ -34,6 +35,15 @@ int main(int argc, char *argv[]) {
     std::signal(SIGPIPE, SIG_IGN);
 #endif
 
+    // Headless modes never touch widgets; skip the GUI startup entirely
+    if (CommandLine::isHeadless(argc, argv)) {
+        QCoreApplication app(argc, argv);
+        app.setOrganizationName("CF Dojo");
+        app.setApplicationName("CF Dojo");
+        app.setApplicationVersion(CFDojo::kVersion);
+        return CommandLine::run();
+    }
+
     QApplication app(argc, argv);
 
     // Disable mnemonic underlines on buttons/labels.
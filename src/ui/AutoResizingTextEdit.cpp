@@ -1,6 +1,12 @@
 #include "ui/AutoResizingTextEdit.h"
+#include "ui/OutputPreview.h"
 
+#include <QAction>
+#include <QClipboard>
+#include <QContextMenuEvent>
 #include <QFontMetrics>
+#include <QGuiApplication>
+#include <QMenu>
 #include <QResizeEvent>
 #include <QTextDocument>
 #include <algorithm>
@@ -41,6 +47,88 @@ void AutoResizingTextEdit::refreshHeight() {
     adjustHeight();
 }
 
+void AutoResizingTextEdit::setOutputText(const QString &text) {
+    if (!OutputPreview::isLarge(text)) {
+        fullOutput_.clear();
+        outputLineStarts_.clear();
+        outputPreview_ = false;
+        setPlainText(text);
+        return;
+    }
+    // Same (shared) text again, e.g. the view refreshing its editor
+    if (outputPreview_ && text.constData() == fullOutput_.constData() &&
+        text.size() == fullOutput_.size()) {
+        return;
+    }
+
+    fullOutput_ = text;
+    outputLineStarts_.clear();
+    outputPage_ = -1;
+    outputPreview_ = true;
+    setPlainText(OutputPreview::headTail(fullOutput_));
+}
+
+QString AutoResizingTextEdit::fullText() const {
+    return outputPreview_ ? fullOutput_ : toPlainText();
+}
+
+void AutoResizingTextEdit::showOutputPage(int firstLine) {
+    if (!outputPreview_) {
+        return;
+    }
+    if (firstLine < 0) {
+        outputPage_ = -1;
+        setPlainText(OutputPreview::headTail(fullOutput_));
+        return;
+    }
+    if (outputLineStarts_.empty()) {
+        outputLineStarts_ = OutputPreview::lineStarts(fullOutput_);
+    }
+    const int lastStart = static_cast<int>(outputLineStarts_.size()) - 1;
+    outputPage_ = std::clamp(firstLine, 0, std::max(lastStart, 0));
+    setPlainText(OutputPreview::page(fullOutput_, outputLineStarts_, outputPage_));
+}
+
+void AutoResizingTextEdit::contextMenuEvent(QContextMenuEvent *event) {
+    if (!outputPreview_) {
+        QPlainTextEdit::contextMenuEvent(event);
+        return;
+    }
+
+    QMenu *menu = createStandardContextMenu(event->pos());
+    menu->addSeparator();
+
+    const int pageLines = OutputPreview::kPageLines;
+    const int totalLines = static_cast<int>(OutputPreview::lineCount(fullOutput_));
+    QAction *previewAction = menu->addAction("Show Head and Tail");
+    previewAction->setEnabled(outputPage_ >= 0);
+    QAction *firstAction = menu->addAction("First Page");
+    QAction *prevAction = menu->addAction("Previous Page");
+    prevAction->setEnabled(outputPage_ > 0);
+    QAction *nextAction = menu->addAction("Next Page");
+    nextAction->setEnabled(outputPage_ + pageLines < totalLines);
+    QAction *lastAction = menu->addAction("Last Page");
+    menu->addSeparator();
+    QAction *copyAction = menu->addAction("Copy Full Output");
+
+    QAction *chosen = menu->exec(event->globalPos());
+    delete menu;
+
+    if (chosen == previewAction) {
+        showOutputPage(-1);
+    } else if (chosen == firstAction) {
+        showOutputPage(0);
+    } else if (chosen == prevAction) {
+        showOutputPage(std::max(outputPage_ - pageLines, 0));
+    } else if (chosen == nextAction) {
+        showOutputPage(outputPage_ < 0 ? 0 : outputPage_ + pageLines);
+    } else if (chosen == lastAction) {
+        showOutputPage(std::max(totalLines - pageLines, 0));
+    } else if (chosen == copyAction) {
+        QGuiApplication::clipboard()->setText(fullOutput_);
+    }
+}
+
 void AutoResizingTextEdit::changeEvent(QEvent *event) {
     QPlainTextEdit::changeEvent(event);
     if (event->type() == QEvent::FontChange) {
@@ -3,6 +3,7 @@
 #include <QPlainTextEdit>
 #include <QSize>
 #include <QString>
+#include <vector>
 
 class AutoResizingTextEdit : public QPlainTextEdit {
     Q_OBJECT
@@ -19,8 +20,15 @@ public:
 
     void refreshHeight();
 
+    // Show program output. Large text (see OutputPreview) is kept here and
+    // shown as a head/tail preview; the context menu pages through it.
+    void setOutputText(const QString &text);
+    // Full text given to setOutputText, or the document text
+    QString fullText() const;
+
 protected:
     void changeEvent(QEvent *event) override;
+    void contextMenuEvent(QContextMenuEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
     QSize sizeHint() const override;
     QSize minimumSizeHint() const override;
@@ -33,9 +41,16 @@ private:
     int targetLineCount() const;
     void updateElidedPlaceholder();
     QString elideWithDots(const QString &text, int maxWidth) const;
+    void showOutputPage(int firstLine);
 
     int minLines_ = 1;
     int maxLines_ = 0;  // 0 means no auto-resize
     QString fullPlaceholder_;
     bool placeholderVisible_ = true;
+
+    // Large output shown as a preview
+    QString fullOutput_;
+    std::vector<qsizetype> outputLineStarts_;  // built on first paging
+    int outputPage_ = -1;  // first line of the shown page, -1: head/tail
+    bool outputPreview_ = false;
 };
@@ -0,0 +1,115 @@
+#include "ui/DiffRenderer.h"
+
+#include <QPlainTextEdit>
+#include <QTextCharFormat>
+#include <QTextCursor>
+#include <QTimer>
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+constexpr size_t kLinesPerChunk = 200;
+
+QColor tint(QColor color, int alpha) {
+    color.setAlpha(alpha);
+    return color;
+}
+} // namespace
+
+DiffRenderer::DiffRenderer(QObject *parent)
+    : QObject(parent),
+      timer_(new QTimer(this)) {
+    timer_->setInterval(0);
+    connect(timer_, &QTimer::timeout, this, &DiffRenderer::renderChunk);
+}
+
+void DiffRenderer::setColors(const ThemeColors &colors) {
+    colors_ = colors;
+}
+
+void DiffRenderer::render(QPlainTextEdit *view, std::shared_ptr<const DiffEngine::Report> report) {
+    clear();
+    if (!view || !report) {
+        return;
+    }
+    view_ = view;
+    report_ = std::move(report);
+    nextLine_ = 0;
+    renderChunk();
+}
+
+void DiffRenderer::clear() {
+    timer_->stop();
+    if (view_) {
+        view_->clear();
+    }
+    view_.clear();
+    report_.reset();
+    nextLine_ = 0;
+}
+
+void DiffRenderer::renderChunk() {
+    if (!view_ || !report_) {
+        timer_->stop();
+        return;
+    }
+
+    QTextCharFormat plain;
+    plain.setForeground(colors_.text);
+    QTextCharFormat note = plain;
+    note.setForeground(colors_.comment);
+    note.setFontItalic(true);
+    QTextCharFormat removed = plain;
+    removed.setBackground(tint(colors_.statusError, 60));
+    QTextCharFormat removedChange = plain;
+    removedChange.setBackground(tint(colors_.statusError, 150));
+    QTextCharFormat added = plain;
+    added.setBackground(tint(colors_.statusAc, 60));
+    QTextCharFormat addedChange = plain;
+    addedChange.setBackground(tint(colors_.statusAc, 150));
+
+    const std::vector<DiffEngine::Line> &lines = report_->lines;
+    const size_t end = std::min(lines.size(), nextLine_ + kLinesPerChunk);
+
+    QTextCursor cursor(view_->document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.beginEditBlock();
+    for (size_t i = nextLine_; i < end; ++i) {
+        const DiffEngine::Line &line = lines[i];
+        if (i > 0) {
+            cursor.insertBlock();
+        }
+        switch (line.kind) {
+        case DiffEngine::Line::Kind::Skipped:
+            cursor.insertText(line.text, note);
+            break;
+        case DiffEngine::Line::Kind::Context:
+            cursor.insertText(QStringLiteral("  ") + line.text, plain);
+            break;
+        case DiffEngine::Line::Kind::Removed:
+        case DiffEngine::Line::Kind::Added: {
+            const bool isAdded = line.kind == DiffEngine::Line::Kind::Added;
+            const QTextCharFormat &base = isAdded ? added : removed;
+            const QTextCharFormat &change = isAdded ? addedChange : removedChange;
+            cursor.insertText(isAdded ? QStringLiteral("+ ") : QStringLiteral("- "), base);
+            if (line.changeStart < 0) {
+                cursor.insertText(line.text, base);
+                break;
+            }
+            cursor.insertText(line.text.left(line.changeStart), base);
+            cursor.insertText(line.text.mid(line.changeStart, line.changeLength), change);
+            cursor.insertText(line.text.mid(line.changeStart + line.changeLength), base);
+            break;
+        }
+        }
+    }
+    cursor.endEditBlock();
+    nextLine_ = end;
+
+    if (nextLine_ >= lines.size()) {
+        timer_->stop();
+    } else if (!timer_->isActive()) {
+        timer_->start();
+    }
+}
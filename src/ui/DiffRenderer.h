@@ -0,0 +1,37 @@
+#pragma once
+
+#include "execution/DiffEngine.h"
+#include "theme/ThemeManager.h"
+
+#include <QObject>
+#include <QPointer>
+#include <memory>
+
+class QPlainTextEdit;
+class QTimer;
+
+// Writes a DiffEngine report into a text view a chunk of lines per event
+// loop pass, so a long diff does not freeze the window while it is laid out.
+class DiffRenderer : public QObject {
+    Q_OBJECT
+
+public:
+    explicit DiffRenderer(QObject *parent = nullptr);
+
+    void setColors(const ThemeColors &colors);
+
+    // Replaces the view's text with report; a render in progress is dropped
+    void render(QPlainTextEdit *view, std::shared_ptr<const DiffEngine::Report> report);
+    void clear();
+
+    const DiffEngine::Report *current() const { return report_.get(); }
+
+private:
+    void renderChunk();
+
+    QTimer *timer_ = nullptr;
+    QPointer<QPlainTextEdit> view_;
+    std::shared_ptr<const DiffEngine::Report> report_;
+    size_t nextLine_ = 0;
+    ThemeColors colors_;
+};
@@ -0,0 +1,129 @@
+#include "ui/OutputPreview.h"
+
+#include <QStringView>
+
+#include <algorithm>
+
+namespace {
+
+// Append the lines of chunk, cutting overly long ones
+void appendClipped(QString &out, QStringView chunk) {
+    qsizetype pos = 0;
+    while (pos <= chunk.size()) {
+        qsizetype end = chunk.indexOf(QLatin1Char('\n'), pos);
+        if (end < 0) {
+            end = chunk.size();
+        }
+        const QStringView line = chunk.mid(pos, end - pos);
+        if (line.size() > OutputPreview::kMaxLineChars) {
+            out += line.left(OutputPreview::kMaxLineChars);
+            out += QString(" \u2026 [%L1 more characters]")
+                .arg(line.size() - OutputPreview::kMaxLineChars);
+        } else {
+            out += line;
+        }
+        if (end >= chunk.size()) {
+            break;
+        }
+        out += QLatin1Char('\n');
+        pos = end + 1;
+    }
+}
+
+} // namespace
+
+namespace OutputPreview {
+
+bool isLarge(const QString &text) {
+    if (text.size() > kMaxDirectChars) {
+        return true;
+    }
+    return QStringView(text).count(QLatin1Char('\n')) > kMaxDirectLines;
+}
+
+qsizetype lineCount(const QString &text) {
+    if (text.isEmpty()) {
+        return 0;
+    }
+    const qsizetype newlines = QStringView(text).count(QLatin1Char('\n'));
+    return text.endsWith(QLatin1Char('\n')) ? newlines : newlines + 1;
+}
+
+QString headTail(const QString &text) {
+    const QStringView view(text);
+
+    // End of the head: just past the kHeadLines-th newline
+    qsizetype headEnd = 0;
+    for (int line = 0; line < kHeadLines && headEnd < view.size(); ++line) {
+        const qsizetype newline = view.indexOf(QLatin1Char('\n'), headEnd);
+        headEnd = newline < 0 ? view.size() : newline + 1;
+    }
+
+    // Start of the tail, ignoring a trailing newline
+    qsizetype body = view.size();
+    if (body > 0 && view.at(body - 1) == QLatin1Char('\n')) {
+        --body;
+    }
+    qsizetype tailStart = body;
+    for (int line = 0; line < kTailLines && tailStart > 0; ++line) {
+        // tailStart is a line start (or the end); skip the newline before it
+        const qsizetype searchFrom = line == 0 ? tailStart - 1 : tailStart - 2;
+        const qsizetype newline =
+            searchFrom < 0 ? -1 : view.lastIndexOf(QLatin1Char('\n'), searchFrom);
+        tailStart = newline + 1;
+    }
+
+    QString out;
+    if (tailStart <= headEnd) {
+        appendClipped(out, view);
+        return out;
+    }
+
+    const QStringView head = view.left(headEnd);
+    const QStringView tail = view.mid(tailStart, body - tailStart);
+    const qsizetype headLines = head.count(QLatin1Char('\n'));
+    const qsizetype tailLines = tail.count(QLatin1Char('\n')) + 1;
+    const qsizetype hidden = lineCount(text) - headLines - tailLines;
+
+    appendClipped(out, head);
+    if (!out.endsWith(QLatin1Char('\n'))) {
+        out += QLatin1Char('\n');
+    }
+    out += QString("\u2026 %L1 lines not shown (right-click to page through the output) \u2026\n")
+        .arg(std::max<qsizetype>(hidden, 0));
+    appendClipped(out, tail);
+    return out;
+}
+
+std::vector<qsizetype> lineStarts(const QString &text) {
+    std::vector<qsizetype> starts;
+    starts.reserve(static_cast<size_t>(std::max<qsizetype>(lineCount(text), 1)));
+    starts.push_back(0);
+    const QStringView view(text);
+    qsizetype pos = view.indexOf(QLatin1Char('\n'));
+    while (pos >= 0 && pos + 1 < view.size()) {
+        starts.push_back(pos + 1);
+        pos = view.indexOf(QLatin1Char('\n'), pos + 1);
+    }
+    return starts;
+}
+
+QString page(const QString &text, const std::vector<qsizetype> &starts, int firstLine) {
+    const int total = static_cast<int>(starts.size());
+    firstLine = std::clamp(firstLine, 0, std::max(total - 1, 0));
+    const int lastLine = std::min(firstLine + kPageLines, total);
+
+    const qsizetype from = total > 0 ? starts[static_cast<size_t>(firstLine)] : 0;
+    qsizetype to = text.size();
+    if (lastLine < total) {
+        to = starts[static_cast<size_t>(lastLine)] - 1;
+    } else if (to > from && text.at(to - 1) == QLatin1Char('\n')) {
+        --to;
+    }
+
+    QString out = QString("[lines %L1\u2013%L2 of %L3]\n").arg(firstLine + 1).arg(lastLine).arg(total);
+    appendClipped(out, QStringView(text).mid(from, std::max<qsizetype>(to - from, 0)));
+    return out;
+}
+
+} // namespace OutputPreview
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QString>
+#include <vector>
+
+// Helpers for showing very large program output. QPlainTextEdit lays out
+// every line it is given, so big outputs are shown as a head/tail preview or
+// one page at a time while the full text stays with the caller.
+namespace OutputPreview {
+
+// Output up to this size is shown as is
+constexpr qsizetype kMaxDirectChars = 256 * 1024;
+constexpr qsizetype kMaxDirectLines = 2000;
+
+constexpr int kHeadLines = 200;
+constexpr int kTailLines = 50;
+constexpr int kPageLines = 1000;
+// Longer lines are cut for display; one huge line stalls layout as well
+constexpr int kMaxLineChars = 2000;
+
+bool isLarge(const QString &text);
+
+qsizetype lineCount(const QString &text);
+
+// First kHeadLines and last kTailLines lines with a marker in between
+QString headTail(const QString &text);
+
+// Start offset of every line in text
+std::vector<qsizetype> lineStarts(const QString &text);
+
+// kPageLines lines starting at firstLine, preceded by a position marker
+QString page(const QString &text, const std::vector<qsizetype> &starts, int firstLine);
+
+} // namespace OutputPreview
@@ -0,0 +1,140 @@
+#include "ui/ResourceMonitorPanel.h"
+
+#include <QGridLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QTimer>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+namespace {
+constexpr int kSampleIntervalMs = 500;
+
+QString formatBytes(qint64 bytes) {
+    if (bytes < 0) {
+        return "n/a";
+    }
+    if (bytes < 1024 * 1024) {
+        return QString("%1 KB").arg(bytes / 1024);
+    }
+    return QString("%1 MB").arg(static_cast<double>(bytes) / (1024.0 * 1024.0), 0, 'f', 1);
+}
+
+QString formatCpu(double percent) {
+    return percent < 0.0 ? QString("n/a") : QString("%1%").arg(percent, 0, 'f', 0);
+}
+
+QString formatElapsed(qint64 ms) {
+    return ms < 10000 ? QString("%1 ms").arg(ms)
+                      : QString("%1 s").arg(static_cast<double>(ms) / 1000.0, 0, 'f', 1);
+}
+} // namespace
+
+ResourceMonitorPanel::ResourceMonitorPanel(QWidget *parent)
+    : QWidget(parent),
+      timer_(new QTimer(this)) {
+    setObjectName("ResourceMonitorPanel");
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+
+    auto *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 12, 0, 0);
+    layout->setSpacing(12);
+
+    auto *titleRow = new QWidget(this);
+    auto *titleLayout = new QHBoxLayout(titleRow);
+    titleLayout->setContentsMargins(12, 0, 12, 0);
+    titleLayout->setSpacing(0);
+    auto *titleLabel = new QLabel("Resource monitor", titleRow);
+    titleLabel->setObjectName("PanelTitle");
+    titleLayout->addWidget(titleLabel);
+    layout->addWidget(titleRow);
+
+    auto *summary = new QWidget(this);
+    auto *summaryLayout = new QGridLayout(summary);
+    summaryLayout->setContentsMargins(12, 0, 12, 0);
+    summaryLayout->setHorizontalSpacing(12);
+    summaryLayout->setVerticalSpacing(4);
+    auto addRow = [summary, summaryLayout](int row, const QString &name) {
+        summaryLayout->addWidget(new QLabel(name, summary), row, 0);
+        auto *value = new QLabel(summary);
+        value->setObjectName("ResourceMonitorValue");
+        summaryLayout->addWidget(value, row, 1);
+        return value;
+    };
+    workersLabel_ = addRow(0, "Workers");
+    queueLabel_ = addRow(1, "Queued");
+    throughputLabel_ = addRow(2, "Throughput");
+    totalsLabel_ = addRow(3, "Children");
+    summaryLayout->setColumnStretch(1, 1);
+    layout->addWidget(summary);
+
+    tree_ = new QTreeWidget(this);
+    tree_->setObjectName("ResourceMonitorTree");
+    tree_->setColumnCount(5);
+    tree_->setHeaderLabels({"Process", "PID", "CPU", "RSS", "Elapsed"});
+    tree_->setRootIsDecorated(false);
+    tree_->setIndentation(0);
+    tree_->setSelectionMode(QAbstractItemView::NoSelection);
+    tree_->setFocusPolicy(Qt::NoFocus);
+    tree_->setUniformRowHeights(true);
+    tree_->header()->setStretchLastSection(false);
+    tree_->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    for (int column = 1; column < tree_->columnCount(); ++column) {
+        tree_->header()->setSectionResizeMode(column, QHeaderView::ResizeToContents);
+    }
+    layout->addWidget(tree_, 1);
+
+    timer_->setInterval(kSampleIntervalMs);
+    connect(timer_, &QTimer::timeout, this, &ResourceMonitorPanel::refresh);
+    refresh();
+}
+
+void ResourceMonitorPanel::showEvent(QShowEvent *event) {
+    QWidget::showEvent(event);
+    refresh();
+    timer_->start();
+}
+
+void ResourceMonitorPanel::hideEvent(QHideEvent *event) {
+    QWidget::hideEvent(event);
+    timer_->stop();
+}
+
+void ResourceMonitorPanel::refresh() {
+    const ResourceSampler::Sample sample = sampler_.sample();
+
+    const int utilization = sample.busyWorkers * 100 / sample.workerCapacity;
+    workersLabel_->setText(QString("%1 busy of %2 cores (%3%)")
+                               .arg(sample.busyWorkers)
+                               .arg(sample.workerCapacity)
+                               .arg(utilization));
+    queueLabel_->setText(QString::number(sample.queuedJobs));
+    throughputLabel_->setText(
+        QString("%1 processes/s").arg(sample.childrenPerSecond, 0, 'f', 1));
+    totalsLabel_->setText(sample.procAvailable
+        ? QString("%1 running \u2022 CPU %2 \u2022 RSS %3")
+              .arg(static_cast<int>(sample.children.size()))
+              .arg(formatCpu(sample.cpuPercent), formatBytes(sample.rssBytes))
+        : QString("%1 running \u2022 CPU/RSS need /proc")
+              .arg(static_cast<int>(sample.children.size())));
+
+    // Children live for milliseconds, so rows are rebuilt rather than tracked
+    tree_->setUpdatesEnabled(false);
+    tree_->clear();
+    QList<QTreeWidgetItem *> items;
+    items.reserve(static_cast<int>(sample.children.size()));
+    for (const ResourceSampler::Child &child : sample.children) {
+        auto *item = new QTreeWidgetItem({child.label,
+                                          QString::number(child.pid),
+                                          formatCpu(child.cpuPercent),
+                                          formatBytes(child.rssBytes),
+                                          formatElapsed(child.elapsedMs)});
+        for (int column = 1; column < 5; ++column) {
+            item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+        }
+        items << item;
+    }
+    tree_->addTopLevelItems(items);
+    tree_->setUpdatesEnabled(true);
+}
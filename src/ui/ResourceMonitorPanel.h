@@ -0,0 +1,35 @@
+#pragma once
+
+#include "execution/ResourceSampler.h"
+
+#include <QWidget>
+
+class QLabel;
+class QTimer;
+class QTreeWidget;
+
+// Side panel showing the children of Run All, single runs and stress tests
+// as they execute: CPU%, resident memory and elapsed time per child, plus
+// throughput, queue depth and worker utilization. Samples twice a second,
+// and only while the panel is visible.
+class ResourceMonitorPanel : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit ResourceMonitorPanel(QWidget *parent = nullptr);
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private:
+    void refresh();
+
+    ResourceSampler sampler_;
+    QTimer *timer_ = nullptr;
+    QLabel *workersLabel_ = nullptr;
+    QLabel *queueLabel_ = nullptr;
+    QLabel *throughputLabel_ = nullptr;
+    QLabel *totalsLabel_ = nullptr;
+    QTreeWidget *tree_ = nullptr;
+};
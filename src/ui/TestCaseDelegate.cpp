@@ -0,0 +1,363 @@
+#include "ui/TestCaseDelegate.h"
+#include "ui/AutoResizingTextEdit.h"
+#include "ui/DiffRenderer.h"
+#include "ui/TestCaseModel.h"
+
+#include <QEvent>
+#include <QFontDatabase>
+#include <QFontMetrics>
+#include <QLabel>
+#include <QPainter>
+#include <QSplitter>
+#include <QStyle>
+#include <QStringView>
+#include <QTimer>
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+constexpr int kCardMarginH = 12;
+constexpr int kCardMarginV = 6;
+constexpr int kCardPadding = 8;
+constexpr int kLineSpacing = 4;
+// Only this much of a test is looked at for its one-line preview
+constexpr qsizetype kPreviewChars = 256;
+
+QString previewText(const QString &text) {
+    if (text.isEmpty()) {
+        return QStringLiteral("(empty)");
+    }
+    const QStringView head = QStringView(text).left(kPreviewChars);
+    const qsizetype newline = head.indexOf(QLatin1Char('\n'));
+    QString line = (newline >= 0 ? head.left(newline) : head).toString();
+    line.remove(QLatin1Char('\r'));
+    line.replace(QLatin1Char('\t'), QLatin1Char(' '));
+
+    const bool truncated = newline >= 0 ? newline + 1 < text.size()
+                                        : text.size() > kPreviewChars;
+    if (truncated) {
+        line += QStringLiteral(" \u2026");
+    }
+    return line;
+}
+} // namespace
+
+TestCaseDelegate::TestCaseDelegate(EditorFactory factory, QObject *parent)
+    : QStyledItemDelegate(parent),
+      factory_(std::move(factory)),
+      previewFont_(QFontDatabase::systemFont(QFontDatabase::FixedFont)),
+      diffRenderer_(new DiffRenderer(this)) {}
+
+void TestCaseDelegate::setColors(const ThemeColors &colors) {
+    colors_ = colors;
+    diffRenderer_->setColors(colors);
+}
+
+int TestCaseDelegate::previewLineCount(const QModelIndex &index) const {
+    int lines = 2;  // input, expected
+    if (index.data(TestCaseModel::ShowOutputRole).toBool()) {
+        ++lines;
+    }
+    if (index.data(TestCaseModel::ShowErrorRole).toBool()) {
+        ++lines;
+    }
+    if (!index.data(TestCaseModel::MismatchRole).toString().isEmpty()) {
+        ++lines;
+    }
+    if (!index.data(TestCaseModel::TrendRole).toString().isEmpty()) {
+        ++lines;
+    }
+    return lines;
+}
+
+void TestCaseDelegate::paint(QPainter *painter,
+                             const QStyleOptionViewItem &option,
+                             const QModelIndex &index) const {
+    painter->save();
+
+    const QRect card = option.rect.adjusted(kCardMarginH, kCardMarginV,
+                                            -kCardMarginH, -kCardMarginV);
+    const bool selected = option.state.testFlag(QStyle::State_Selected);
+    painter->setPen(selected ? colors_.text : colors_.edge);
+    painter->setBrush(Qt::NoBrush);
+    painter->drawRect(card.adjusted(0, 0, -1, -1));
+
+    // The focused case is covered by its editor
+    if (openIndex_.isValid() && openIndex_ == index) {
+        painter->restore();
+        return;
+    }
+
+    const QRect content = card.adjusted(kCardPadding, kCardPadding,
+                                        -kCardPadding, -kCardPadding);
+
+    QFont titleFont = option.font;
+    titleFont.setBold(true);
+    const QFontMetrics titleMetrics(titleFont);
+    const QString title = index.data(Qt::DisplayRole).toString();
+    const QString status = index.data(TestCaseModel::StatusRole).toString();
+    const QColor statusColor = index.data(TestCaseModel::StatusColorRole).value<QColor>();
+
+    painter->setFont(titleFont);
+    painter->setPen(colors_.text);
+    QRect titleRect(content.left(), content.top(), content.width(), titleMetrics.height());
+    painter->drawText(titleRect, Qt::AlignLeft | Qt::AlignVCenter, title);
+    titleRect.setLeft(titleRect.left() + titleMetrics.horizontalAdvance(title) + kCardPadding);
+    painter->setPen(statusColor.isValid() ? statusColor : colors_.text);
+    painter->drawText(titleRect, Qt::AlignLeft | Qt::AlignVCenter,
+                      titleMetrics.elidedText(status, Qt::ElideRight, titleRect.width()));
+
+    const QFontMetrics previewMetrics(previewFont_);
+    const int labelWidth = previewMetrics.horizontalAdvance(QStringLiteral("diff "));
+    int y = content.top() + titleMetrics.height() + kLineSpacing;
+    auto drawLine = [&](const QString &label, const QString &text,
+                        const QColor &color = QColor()) {
+        const QRect lineRect(content.left(), y, content.width(), previewMetrics.height());
+        painter->setFont(previewFont_);
+        painter->setPen(colors_.comment);
+        painter->drawText(lineRect, Qt::AlignLeft | Qt::AlignVCenter, label);
+        painter->setPen(color.isValid() ? color : colors_.text);
+        const QRect textRect = lineRect.adjusted(labelWidth, 0, 0, 0);
+        painter->drawText(textRect, Qt::AlignLeft | Qt::AlignVCenter,
+                          previewMetrics.elidedText(text, Qt::ElideRight, textRect.width()));
+        y += previewMetrics.height() + kLineSpacing;
+    };
+    auto drawPreview = [&](const QString &label, int role) {
+        drawLine(label, previewText(index.data(role).toString()));
+    };
+
+    drawPreview(QStringLiteral("in"), TestCaseModel::InputRole);
+    drawPreview(QStringLiteral("ans"), TestCaseModel::ExpectedRole);
+    if (index.data(TestCaseModel::ShowOutputRole).toBool()) {
+        drawPreview(QStringLiteral("out"), TestCaseModel::OutputRole);
+    }
+    if (index.data(TestCaseModel::ShowErrorRole).toBool()) {
+        drawPreview(QStringLiteral("err"), TestCaseModel::ErrorRole);
+    }
+    const QString mismatch = index.data(TestCaseModel::MismatchRole).toString();
+    if (!mismatch.isEmpty()) {
+        drawLine(QStringLiteral("diff"), "first mismatch at " + mismatch);
+    }
+    const QString trend = index.data(TestCaseModel::TrendRole).toString();
+    if (!trend.isEmpty()) {
+        const bool regressed = index.data(TestCaseModel::TrendRegressedRole).toBool();
+        drawLine(QStringLiteral("time"), trend, regressed ? colors_.statusError : QColor());
+    }
+
+    painter->restore();
+}
+
+QSize TestCaseDelegate::sizeHint(const QStyleOptionViewItem &option,
+                                 const QModelIndex &index) const {
+    const int chrome = 2 * kCardMarginV + 2 * kCardPadding;
+    if (openWidgets_.panel && openIndex_.isValid() && openIndex_ == index) {
+        return QSize(1, openWidgets_.panel->sizeHint().height() + chrome);
+    }
+
+    QFont titleFont = option.font;
+    titleFont.setBold(true);
+    const int titleHeight = QFontMetrics(titleFont).height();
+    const int lineHeight = QFontMetrics(previewFont_).height() + kLineSpacing;
+    return QSize(1, titleHeight + kLineSpacing + previewLineCount(index) * lineHeight + chrome);
+}
+
+QWidget *TestCaseDelegate::createEditor(QWidget *parent,
+                                        const QStyleOptionViewItem & /*option*/,
+                                        const QModelIndex &index) const {
+    QWidget *panel = nullptr;
+    if (!idleEditors_.empty()) {
+        panel = idleEditors_.back();
+        idleEditors_.pop_back();
+        if (panel->parentWidget() != parent) {
+            panel->setParent(parent);
+        }
+    } else {
+        const TestPanelBuilder::CaseWidgets widgets = factory_ ? factory_(parent)
+                                                               : TestPanelBuilder::CaseWidgets();
+        if (!widgets.panel) {
+            return nullptr;
+        }
+        editors_.push_back(widgets);
+        panel = widgets.panel;
+    }
+
+    openWidgets_ = *widgetsFor(panel);
+    openIndex_ = index;
+    openInputsLoaded_ = false;
+    openHeight_ = -1;
+
+    // The row still has its preview height; resize it once the editor is laid out
+    auto *self = const_cast<TestCaseDelegate *>(this);
+    QTimer::singleShot(0, self, [self]() { self->refreshOpenHeight(); });
+    return panel;
+}
+
+void TestCaseDelegate::destroyEditor(QWidget *editor, const QModelIndex & /*index*/) const {
+    if (!widgetsFor(editor)) {
+        QStyledItemDelegate::destroyEditor(editor, QModelIndex());
+        return;
+    }
+    editor->hide();
+    idleEditors_.push_back(editor);
+    if (openWidgets_.panel == editor) {
+        diffRenderer_->clear();
+        openWidgets_ = TestPanelBuilder::CaseWidgets();
+        openIndex_ = QPersistentModelIndex();
+        openHeight_ = -1;
+    }
+}
+
+void TestCaseDelegate::setEditorData(QWidget *editor, const QModelIndex &index) const {
+    const TestPanelBuilder::CaseWidgets *widgets = widgetsFor(editor);
+    if (!widgets) {
+        return;
+    }
+
+    if (widgets->titleLabel) {
+        widgets->titleLabel->setText(index.data(Qt::DisplayRole).toString());
+    }
+    // Inputs are loaded once per open; afterwards the editor is the source of truth
+    if (editor == openWidgets_.panel && !openInputsLoaded_) {
+        if (widgets->inputEditor) {
+            widgets->inputEditor->setPlainText(index.data(TestCaseModel::InputRole).toString());
+        }
+        if (widgets->expectedEditor) {
+            widgets->expectedEditor->setPlainText(
+                index.data(TestCaseModel::ExpectedRole).toString());
+        }
+        openInputsLoaded_ = true;
+    }
+
+    if (widgets->statusLabel) {
+        const QColor color = index.data(TestCaseModel::StatusColorRole).value<QColor>();
+        QString style = "font-weight: 700;";
+        if (color.isValid()) {
+            style.prepend(QString("color: %1; ").arg(color.name()));
+        }
+        widgets->statusLabel->setText(index.data(TestCaseModel::StatusRole).toString());
+        widgets->statusLabel->setStyleSheet(style);
+        // The card's "time" line is hidden under the editor
+        QString tip = index.data(TestCaseModel::TrendRole).toString();
+        if (!tip.isEmpty()) {
+            tip.prepend(index.data(TestCaseModel::TrendRegressedRole).toBool()
+                            ? "Slower than the previous solution\n"
+                            : "Run time history\n");
+        }
+        widgets->statusLabel->setToolTip(tip);
+    }
+
+    const bool showOutput = index.data(TestCaseModel::ShowOutputRole).toBool();
+    const bool showError = index.data(TestCaseModel::ShowErrorRole).toBool();
+    if (widgets->outputViewer) {
+        widgets->outputViewer->setOutputText(index.data(TestCaseModel::OutputRole).toString());
+    }
+    if (widgets->errorViewer) {
+        widgets->errorViewer->setOutputText(index.data(TestCaseModel::ErrorRole).toString());
+    }
+    if (widgets->outputBlock) {
+        widgets->outputBlock->setVisible(showOutput);
+    }
+    if (widgets->errorBlock) {
+        widgets->errorBlock->setVisible(showError);
+    }
+    if (widgets->outputSplitter) {
+        widgets->outputSplitter->setVisible(showOutput || showError);
+        if (showOutput != showError) {
+            widgets->outputSplitter->setSizes(showOutput ? QList<int>{1, 0}
+                                                         : QList<int>{0, 1});
+        }
+    }
+
+    // Only the open editor shows a diff; it is rendered once per report
+    const auto *model = qobject_cast<const TestCaseModel *>(index.model());
+    std::shared_ptr<const DiffEngine::Report> diff;
+    if (model && model->isValidRow(index.row()) && editor == openWidgets_.panel) {
+        diff = model->record(index.row()).diff;
+    }
+    const bool showDiff = diff && !diff->result.identical();
+    if (widgets->diffLabel && showDiff) {
+        widgets->diffLabel->setText(
+            "Diff \u2022 first mismatch at " + index.data(TestCaseModel::MismatchRole).toString());
+    }
+    if (widgets->diffViewer) {
+        if (!showDiff) {
+            if (editor == openWidgets_.panel) {
+                diffRenderer_->clear();
+            }
+        } else if (diffRenderer_->current() != diff.get()) {
+            diffRenderer_->render(widgets->diffViewer, diff);
+        }
+    }
+    if (widgets->diffBlock) {
+        widgets->diffBlock->setVisible(showDiff);
+    }
+}
+
+void TestCaseDelegate::setModelData(QWidget *editor,
+                                    QAbstractItemModel *model,
+                                    const QModelIndex &index) const {
+    const TestPanelBuilder::CaseWidgets *widgets = widgetsFor(editor);
+    if (!widgets || !model) {
+        return;
+    }
+    if (widgets->inputEditor) {
+        model->setData(index, widgets->inputEditor->toPlainText(), TestCaseModel::InputRole);
+    }
+    if (widgets->expectedEditor) {
+        model->setData(index, widgets->expectedEditor->toPlainText(),
+                       TestCaseModel::ExpectedRole);
+    }
+}
+
+void TestCaseDelegate::updateEditorGeometry(QWidget *editor,
+                                            const QStyleOptionViewItem &option,
+                                            const QModelIndex & /*index*/) const {
+    const int inset = kCardPadding;
+    editor->setGeometry(option.rect.adjusted(kCardMarginH + inset, kCardMarginV + inset,
+                                             -kCardMarginH - inset, -kCardMarginV - inset));
+}
+
+int TestCaseDelegate::openRow() const {
+    return openWidgets_.panel && openIndex_.isValid() ? openIndex_.row() : -1;
+}
+
+void TestCaseDelegate::reloadOpenEditor() {
+    if (!openWidgets_.panel || !openIndex_.isValid()) {
+        return;
+    }
+    openInputsLoaded_ = false;
+    setEditorData(openWidgets_.panel, openIndex_);
+}
+
+bool TestCaseDelegate::eventFilter(QObject *object, QEvent *event) {
+    // Output shown, editor grown, ...: the row has to follow the editor's height
+    if (event->type() == QEvent::LayoutRequest && openWidgets_.panel &&
+        object == openWidgets_.panel) {
+        refreshOpenHeight();
+    }
+    return QStyledItemDelegate::eventFilter(object, event);
+}
+
+void TestCaseDelegate::refreshOpenHeight() {
+    if (!openWidgets_.panel || !openIndex_.isValid()) {
+        return;
+    }
+    const int height = openWidgets_.panel->sizeHint().height();
+    if (height == openHeight_) {
+        return;
+    }
+    openHeight_ = height;
+    emit sizeHintChanged(openIndex_);
+}
+
+const TestPanelBuilder::CaseWidgets *TestCaseDelegate::widgetsFor(const QWidget *panel) const {
+    if (!panel) {
+        return nullptr;
+    }
+    const auto it = std::find_if(editors_.begin(), editors_.end(),
+                                 [panel](const TestPanelBuilder::CaseWidgets &widgets) {
+        return widgets.panel == panel;
+    });
+    return it != editors_.end() ? &*it : nullptr;
+}
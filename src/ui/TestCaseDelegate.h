@@ -0,0 +1,73 @@
+#pragma once
+
+#include "theme/ThemeManager.h"
+#include "ui/TestPanelBuilder.h"
+
+#include <QFont>
+#include <QPersistentModelIndex>
+#include <QStyledItemDelegate>
+#include <functional>
+#include <vector>
+
+class DiffRenderer;
+
+// Paints test cases as compact preview cards and hands out the full case
+// editor (TestPanelBuilder::CaseWidgets) for the focused row only. Editors
+// are pooled: closing one hides it for reuse instead of deleting it, so
+// moving focus through a long list does not rebuild widgets.
+class TestCaseDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+
+public:
+    // Builds a new case editor; called only when the pool is empty
+    using EditorFactory = std::function<TestPanelBuilder::CaseWidgets(QWidget *parent)>;
+
+    explicit TestCaseDelegate(EditorFactory factory, QObject *parent = nullptr);
+
+    void setColors(const ThemeColors &colors);
+
+    void paint(QPainter *painter,
+               const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+    QWidget *createEditor(QWidget *parent,
+                          const QStyleOptionViewItem &option,
+                          const QModelIndex &index) const override;
+    void destroyEditor(QWidget *editor, const QModelIndex &index) const override;
+    void setEditorData(QWidget *editor, const QModelIndex &index) const override;
+    void setModelData(QWidget *editor,
+                      QAbstractItemModel *model,
+                      const QModelIndex &index) const override;
+    void updateEditorGeometry(QWidget *editor,
+                              const QStyleOptionViewItem &option,
+                              const QModelIndex &index) const override;
+
+    // Row of the open editor, or -1
+    int openRow() const;
+    // Widgets of the open editor (panel is null when none is open)
+    const TestPanelBuilder::CaseWidgets &openEditor() const { return openWidgets_; }
+    // Loads the open editor's input and expected output from the model again,
+    // replacing what it shows; for changes made to the record behind its back
+    void reloadOpenEditor();
+
+protected:
+    bool eventFilter(QObject *object, QEvent *event) override;
+
+private:
+    void refreshOpenHeight();
+    const TestPanelBuilder::CaseWidgets *widgetsFor(const QWidget *panel) const;
+    int previewLineCount(const QModelIndex &index) const;
+
+    EditorFactory factory_;
+    ThemeColors colors_;
+    QFont previewFont_;
+    DiffRenderer *diffRenderer_ = nullptr;  // fills the open editor's diff view
+
+    mutable std::vector<TestPanelBuilder::CaseWidgets> editors_;
+    mutable std::vector<QWidget *> idleEditors_;
+    mutable TestPanelBuilder::CaseWidgets openWidgets_;
+    mutable QPersistentModelIndex openIndex_;
+    mutable bool openInputsLoaded_ = false;
+    mutable int openHeight_ = -1;
+};
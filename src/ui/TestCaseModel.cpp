@@ -0,0 +1,132 @@
+#include "ui/TestCaseModel.h"
+
+#include <algorithm>
+
+TestCaseModel::TestCaseModel(QObject *parent)
+    : QAbstractListModel(parent) {}
+
+int TestCaseModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : count();
+}
+
+QVariant TestCaseModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || !isValidRow(index.row())) {
+        return QVariant();
+    }
+    const TestCaseRecord &entry = record(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+        return QString("TC %1").arg(index.row() + 1);
+    case InputRole:
+        return entry.test.input;
+    case ExpectedRole:
+        return entry.test.expectedOutput;
+    case StatusRole:
+        return entry.status;
+    case StatusColorRole:
+        return entry.statusColor;
+    case OutputRole:
+        return entry.output;
+    case ErrorRole:
+        return entry.error;
+    case ShowOutputRole:
+        return entry.showOutput;
+    case ShowErrorRole:
+        return entry.showError;
+    case MismatchRole:
+        if (!entry.diff || entry.diff->result.firstMismatchLine < 0) {
+            return QString();
+        }
+        return QString("line %1, column %2")
+            .arg(entry.diff->result.firstMismatchLine + 1)
+            .arg(entry.diff->result.firstMismatchColumn + 1);
+    case TrendRole:
+        return entry.trend;
+    case TrendRegressedRole:
+        return entry.trendRegressed;
+    default:
+        return QVariant();
+    }
+}
+
+bool TestCaseModel::setData(const QModelIndex &index, const QVariant &value, int role) {
+    if (!index.isValid() || !isValidRow(index.row())) {
+        return false;
+    }
+    TestCaseRecord &entry = recordRef(index.row());
+    QString *field = nullptr;
+    if (role == InputRole) {
+        field = &entry.test.input;
+    } else if (role == ExpectedRole) {
+        field = &entry.test.expectedOutput;
+    } else {
+        return false;
+    }
+
+    const QString text = value.toString();
+    if (*field == text) {
+        return true;
+    }
+    *field = text;
+    emit dataChanged(index, index, {role});
+    return true;
+}
+
+Qt::ItemFlags TestCaseModel::flags(const QModelIndex &index) const {
+    if (!index.isValid()) {
+        return Qt::NoItemFlags;
+    }
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsEditable;
+}
+
+void TestCaseModel::recordsChanged(int first, int last) {
+    if (records_.empty()) {
+        return;
+    }
+    first = std::max(first, 0);
+    last = std::min(last, count() - 1);
+    if (first > last) {
+        return;
+    }
+    emit dataChanged(index(first), index(last));
+}
+
+void TestCaseModel::setTests(const std::vector<TestCase> &tests) {
+    beginResetModel();
+    records_.clear();
+    records_.reserve(tests.size());
+    for (const TestCase &test : tests) {
+        TestCaseRecord entry;
+        entry.test = test;
+        records_.push_back(entry);
+    }
+    endResetModel();
+}
+
+int TestCaseModel::appendCase(const TestCase &test) {
+    const int row = count();
+    beginInsertRows(QModelIndex(), row, row);
+    TestCaseRecord entry;
+    entry.test = test;
+    records_.push_back(entry);
+    endInsertRows();
+    return row;
+}
+
+void TestCaseModel::removeCase(int row) {
+    if (!isValidRow(row)) {
+        return;
+    }
+    beginRemoveRows(QModelIndex(), row, row);
+    records_.erase(records_.begin() + row);
+    endRemoveRows();
+
+    // Titles ("TC n") of the following rows shifted
+    recordsChanged(row, count() - 1);
+}
+
+void TestCaseModel::clear() {
+    beginResetModel();
+    records_.clear();
+    endResetModel();
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "execution/DiffEngine.h"
+#include "file/ProjectSnapshot.h"
+
+#include <QAbstractListModel>
+#include <QColor>
+#include <QString>
+#include <memory>
+#include <vector>
+
+// One test case plus the last result shown for it
+struct TestCaseRecord {
+    TestCase test;
+    QString status = "-";
+    QColor statusColor;  // invalid: default text color
+    QString output;
+    QString error;
+    bool showOutput = false;
+    bool showError = false;
+    // Diff of a wrong answer, computed in the background (see
+    // MainWindow::requestCaseDiff); diffTicket identifies the pending job
+    std::shared_ptr<const DiffEngine::Report> diff;
+    quint64 diffTicket = 0;
+    // Run-time history of this test (see TimingHistory::Trend::text)
+    QString trend;
+    bool trendRegressed = false;
+
+    void clearResult() {
+        status = "-";
+        statusColor = QColor();
+        output.clear();
+        error.clear();
+        showOutput = false;
+        showError = false;
+        diff.reset();
+        diffTicket = 0;
+        trend.clear();
+        trendRegressed = false;
+    }
+};
+
+// List model behind the test-case panel. Holds every case; the view only
+// builds widgets for the focused one (see TestCaseDelegate).
+class TestCaseModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    enum Role {
+        InputRole = Qt::UserRole + 1,
+        ExpectedRole,
+        StatusRole,
+        StatusColorRole,
+        OutputRole,
+        ErrorRole,
+        ShowOutputRole,
+        ShowErrorRole,
+        MismatchRole,  // "line L, column C" of the first difference, or empty
+        TrendRole,     // sparkline of past run times, or empty
+        TrendRegressedRole
+    };
+
+    explicit TestCaseModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex &index, const QVariant &value, int role) override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    int count() const { return static_cast<int>(records_.size()); }
+    bool isValidRow(int row) const { return row >= 0 && row < count(); }
+
+    const TestCaseRecord &record(int row) const { return records_.at(static_cast<size_t>(row)); }
+    // Mutable access; call recordsChanged() afterwards so views repaint
+    TestCaseRecord &recordRef(int row) { return records_.at(static_cast<size_t>(row)); }
+    void recordsChanged(int first, int last);
+
+    void setTests(const std::vector<TestCase> &tests);
+    int appendCase(const TestCase &test = TestCase());
+    void removeCase(int row);
+    void clear();
+
+private:
+    std::vector<TestCaseRecord> records_;
+};
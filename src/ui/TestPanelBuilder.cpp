@@ -6,9 +6,10 @@
 #include <QHBoxLayout>
 #include <QIcon>
 #include <QLabel>
+#include <QListView>
 #include <QPointer>
+#include <QProgressBar>
 #include <QPushButton>
-#include <QScrollArea>
 #include <QSize>
 #include <QSizePolicy>
 #include <QSplitter>
@@ -51,40 +52,52 @@ TestPanelBuilder::PanelWidgets TestPanelBuilder::build(QWidget *parent,
     metaLayout->addWidget(widgets.metaLabel);
     layout->addWidget(metaRow);
 
-    // Scrollable test cases area
-    QScrollArea *scrollArea = new QScrollArea(panel);
-    scrollArea->setObjectName("CasesScroll");
-    scrollArea->setWidgetResizable(true);
-    scrollArea->setFrameShape(QFrame::NoFrame);
-    scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    scrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
-    scrollArea->setSizeAdjustPolicy(QAbstractScrollArea::AdjustIgnored);
-    scrollArea->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Ignored);
-    scrollArea->setMinimumSize(0, 0);
-    scrollArea->setAlignment(Qt::AlignTop | Qt::AlignLeft);
-    scrollArea->setAutoFillBackground(false);
-    scrollArea->viewport()->setAutoFillBackground(false);
-
     widgets.summaryLabel = new QLabel(panel);
     widgets.summaryLabel->setObjectName("TestSummaryLabel");
     widgets.summaryLabel->setVisible(false);
     widgets.summaryLabel->setContentsMargins(12, 0, 12, 0);
     layout->addWidget(widgets.summaryLabel);
 
-    // Cases container
-    widgets.casesContainer = new QWidget(scrollArea);
-    widgets.casesContainer->setObjectName("CasesContainer");
-    widgets.casesContainer->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Minimum);
-    widgets.casesContainer->setMinimumSize(0, 0);
-    widgets.casesContainer->setAutoFillBackground(false);
-    
-    widgets.casesLayout = new QVBoxLayout(widgets.casesContainer);
-    widgets.casesLayout->setContentsMargins(12, 0, 12, 0);
-    widgets.casesLayout->setSpacing(12);
-    widgets.casesLayout->setAlignment(Qt::AlignTop);
-
-    // Add button inside the scroll container, below the cases list
-    widgets.addButton = new QPushButton(widgets.casesContainer);
+    // Run All progress (shown while a run is in flight)
+    auto *progressRow = new QWidget(panel);
+    auto *progressLayout = new QHBoxLayout(progressRow);
+    progressLayout->setContentsMargins(12, 0, 12, 0);
+    progressLayout->setSpacing(0);
+    widgets.progressBar = new QProgressBar(progressRow);
+    widgets.progressBar->setObjectName("RunAllProgress");
+    widgets.progressBar->setFormat("%v / %m");
+    widgets.progressBar->setTextVisible(true);
+    widgets.progressBar->setFixedHeight(16);
+    progressLayout->addWidget(widgets.progressBar);
+    progressRow->setVisible(false);
+    layout->addWidget(progressRow);
+
+    // Test cases list. Rows are painted previews; only the focused case gets
+    // real editor widgets (see TestCaseDelegate), so the list scales to
+    // thousands of cases.
+    widgets.casesView = new QListView(panel);
+    widgets.casesView->setObjectName("CasesView");
+    widgets.casesView->setFrameShape(QFrame::NoFrame);
+    widgets.casesView->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    widgets.casesView->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    widgets.casesView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    widgets.casesView->setSelectionMode(QAbstractItemView::SingleSelection);
+    widgets.casesView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    widgets.casesView->setResizeMode(QListView::Adjust);
+    widgets.casesView->setLayoutMode(QListView::Batched);
+    widgets.casesView->setBatchSize(200);
+    widgets.casesView->setUniformItemSizes(false);
+    widgets.casesView->setSizeAdjustPolicy(QAbstractScrollArea::AdjustIgnored);
+    widgets.casesView->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Ignored);
+    widgets.casesView->setMinimumSize(0, 0);
+    layout->addWidget(widgets.casesView, 1);
+
+    // Add button below the cases list
+    auto *addRow = new QWidget(panel);
+    auto *addLayout = new QHBoxLayout(addRow);
+    addLayout->setContentsMargins(12, 0, 12, 0);
+    addLayout->setSpacing(0);
+    widgets.addButton = new QPushButton(addRow);
     widgets.addButton->setObjectName("AddCaseButton");
     widgets.addButton->setToolTip("Add test case");
     widgets.addButton->setIcon(
@@ -93,12 +106,11 @@ TestPanelBuilder::PanelWidgets TestPanelBuilder::build(QWidget *parent,
     widgets.addButton->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
     widgets.addButton->setMinimumHeight(28);
     widgets.addButton->setFocusPolicy(Qt::NoFocus);
-    widgets.casesLayout->addWidget(widgets.addButton);
-    
-    scrollArea->setWidget(widgets.casesContainer);
-    layout->addWidget(scrollArea, 1);
+    addLayout->addWidget(widgets.addButton);
+    layout->addWidget(addRow);
 
-    // Bottom action buttons row: Run All (left) and Delete All (right)
+    // Bottom action buttons row: Run All (left), Fill Expected from the
+    // brute force and Delete All (right)
     QWidget *bottomRow = new QWidget(panel);
     bottomRow->setObjectName("CasesActionRow");
     bottomRow->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
@@ -119,6 +131,17 @@ TestPanelBuilder::PanelWidgets TestPanelBuilder::build(QWidget *parent,
     widgets.runAllButton->setFocusPolicy(Qt::NoFocus);
     bottomLayout->addWidget(widgets.runAllButton, 1);
 
+    widgets.fillExpectedButton = new QPushButton(bottomRow);
+    widgets.fillExpectedButton->setObjectName("FillExpectedButton");
+    widgets.fillExpectedButton->setToolTip("Fill expected outputs from the brute force");
+    widgets.fillExpectedButton->setIcon(
+        IconUtils::makeTintedIcon(":/images/stresstest.svg", iconColor_, QSize(16, 16)));
+    widgets.fillExpectedButton->setIconSize(QSize(16, 16));
+    widgets.fillExpectedButton->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+    widgets.fillExpectedButton->setMinimumHeight(28);
+    widgets.fillExpectedButton->setFocusPolicy(Qt::NoFocus);
+    bottomLayout->addWidget(widgets.fillExpectedButton, 1);
+
     widgets.clearCasesButton = new QPushButton(bottomRow);
     widgets.clearCasesButton->setObjectName("ClearCasesButton");
     widgets.clearCasesButton->setToolTip("Delete all test cases");
@@ -262,10 +285,19 @@ TestPanelBuilder::CaseWidgets TestPanelBuilder::createCase(QWidget *parent,
     
     layout->addWidget(widgets.outputSplitter);
 
+    // Expected vs. actual diff, filled in once a wrong answer has been diffed
+    widgets.diffBlock = createLabeledBlock(
+        casePanel, "Diff", widgets.diffViewer, "DiffBox",
+        QString(), true, 1, 12);
+    widgets.diffLabel = widgets.diffBlock->findChild<QLabel *>();
+    widgets.diffViewer->setLineWrapMode(QPlainTextEdit::NoWrap);
+    layout->addWidget(widgets.diffBlock);
+
     // Initially hide output sections
     widgets.outputBlock->setVisible(false);
     widgets.errorBlock->setVisible(false);
     widgets.outputSplitter->setVisible(false);
+    widgets.diffBlock->setVisible(false);
 
     widgets.panel = casePanel;
     return widgets;
@@ -6,6 +6,8 @@
 #include <vector>
 
 class QLabel;
+class QListView;
+class QProgressBar;
 class QPushButton;
 class QSplitter;
 class QWidget;
@@ -28,15 +30,19 @@ public:
         QSplitter *outputSplitter = nullptr;
         QWidget *outputBlock = nullptr;
         QWidget *errorBlock = nullptr;
+        QWidget *diffBlock = nullptr;
+        QLabel *diffLabel = nullptr;
+        AutoResizingTextEdit *diffViewer = nullptr;
     };
 
     struct PanelWidgets {
         QWidget *panel = nullptr;
-        QWidget *casesContainer = nullptr;
-        QVBoxLayout *casesLayout = nullptr;
+        QListView *casesView = nullptr;
         QLabel *summaryLabel = nullptr;
+        QProgressBar *progressBar = nullptr;
         QLabel *metaLabel = nullptr;
         QPushButton *runAllButton = nullptr;
+        QPushButton *fillExpectedButton = nullptr;
         QPushButton *addButton = nullptr;
         QPushButton *clearCasesButton = nullptr;
     };
@@ -0,0 +1,141 @@
+#include "file/AutosaveJournal.h"
+#include "file/CpackFileHandler.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <cstdlib>
+
+namespace {
+
+bool check(bool condition, const QString &message) {
+    if (!condition) {
+        qCritical().noquote() << message;
+        return false;
+    }
+    return true;
+}
+
+CpackFileHandler makeState(const QByteArray &solution, const QByteArray &tests) {
+    CpackFileHandler state;
+    state.addFile("solution.cpp", solution);
+    state.addFile("template.cpp", "//#main\n");
+    if (!tests.isEmpty()) {
+        state.addFile("testcases.json", tests);
+    }
+    return state;
+}
+
+bool testReplaysDeltas() {
+    QTemporaryDir tempDir;
+    if (!check(tempDir.isValid(), "Failed to create temporary directory")) {
+        return false;
+    }
+    const QString cpackPath = tempDir.filePath("autosave.cpack");
+    const QString journalPath = tempDir.filePath("autosave.journal");
+
+    AutosaveJournal journal(cpackPath, journalPath);
+    if (!check(journal.write(makeState("int main() {}\n", "{\"tests\":[]}")),
+               "Initial write failed: " + journal.errorString())) {
+        return false;
+    }
+    const qint64 cpackSize = QFileInfo(cpackPath).size();
+
+    if (!check(journal.write(makeState("int main() { return 0; }\n", "{\"tests\":[]}")),
+               "Delta write failed: " + journal.errorString())) {
+        return false;
+    }
+    if (!check(journal.write(makeState("int main() { return 1; }\n", QByteArray())),
+               "Removal write failed: " + journal.errorString())) {
+        return false;
+    }
+    if (!check(QFileInfo(cpackPath).size() == cpackSize,
+               "Archive was rewritten for a small edit")) {
+        return false;
+    }
+
+    CpackFileHandler recovered;
+    if (!check(AutosaveJournal::recover(cpackPath, journalPath, recovered),
+               "Recovery failed")) {
+        return false;
+    }
+    if (!check(recovered.getFile("solution.cpp") == "int main() { return 1; }\n",
+               "solution.cpp mismatch after replay")) {
+        return false;
+    }
+    if (!check(!recovered.hasFile("testcases.json"),
+               "Removed entry reappeared after replay")) {
+        return false;
+    }
+    return true;
+}
+
+bool testStopsAtTornRecord() {
+    QTemporaryDir tempDir;
+    if (!check(tempDir.isValid(), "Failed to create temporary directory")) {
+        return false;
+    }
+    const QString cpackPath = tempDir.filePath("autosave.cpack");
+    const QString journalPath = tempDir.filePath("autosave.journal");
+
+    AutosaveJournal journal(cpackPath, journalPath);
+    journal.write(makeState("a\n", QByteArray()));
+    journal.write(makeState("ab\n", QByteArray()));
+    const qint64 goodSize = QFileInfo(journalPath).size();
+    journal.write(makeState("abc\n", QByteArray()));
+
+    // Simulate a crash in the middle of the last append
+    QFile file(journalPath);
+    if (!check(file.resize(goodSize + 5), "Failed to truncate journal")) {
+        return false;
+    }
+
+    CpackFileHandler recovered;
+    if (!check(AutosaveJournal::recover(cpackPath, journalPath, recovered),
+               "Recovery failed")) {
+        return false;
+    }
+    return check(recovered.getFile("solution.cpp") == "ab\n",
+                 "Expected replay to stop before the torn record");
+}
+
+bool testIgnoresStaleJournal() {
+    QTemporaryDir tempDir;
+    if (!check(tempDir.isValid(), "Failed to create temporary directory")) {
+        return false;
+    }
+    const QString cpackPath = tempDir.filePath("autosave.cpack");
+    const QString journalPath = tempDir.filePath("autosave.journal");
+
+    AutosaveJournal journal(cpackPath, journalPath);
+    journal.write(makeState("old\n", QByteArray()));
+    journal.write(makeState("older edit\n", QByteArray()));
+
+    // A different base archive (e.g. compaction finished, journal reset did not)
+    const QString stalePath = tempDir.filePath("stale.journal");
+    QFile::copy(journalPath, stalePath);
+    journal.compact(makeState("new\n", QByteArray()));
+
+    CpackFileHandler recovered;
+    if (!check(AutosaveJournal::recover(cpackPath, stalePath, recovered),
+               "Recovery failed")) {
+        return false;
+    }
+    return check(recovered.getFile("solution.cpp") == "new\n",
+                 "Stale journal was replayed onto a newer archive");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    QCoreApplication app(argc, argv);
+
+    bool ok = true;
+    ok = testReplaysDeltas() && ok;
+    ok = testStopsAtTornRecord() && ok;
+    ok = testIgnoresStaleJournal() && ok;
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,80 @@
+#include "ui/AutoResizingTextEdit.h"
+#include "ui/TestCaseDelegate.h"
+#include "ui/TestCaseModel.h"
+#include "ui/TestPanelBuilder.h"
+
+#include <QApplication>
+#include <QDebug>
+#include <QListView>
+
+#include <cstdlib>
+
+namespace {
+
+bool check(bool condition, const QString &message) {
+    if (!condition) {
+        qCritical().noquote() << message;
+        return false;
+    }
+    return true;
+}
+
+// Focus moves the way MainWindow::setFocusedCase moves it
+void focus(QListView &view, TestCaseModel &model, TestCaseDelegate &delegate, int row) {
+    const int previous = delegate.openRow();
+    if (previous >= 0) {
+        const QModelIndex index = model.index(previous);
+        delegate.setModelData(delegate.openEditor().panel, &model, index);
+        view.closePersistentEditor(index);
+    }
+    view.openPersistentEditor(model.index(row));
+}
+
+// A value written into the open case's record (as filling expected outputs
+// from the brute does) survives focus leaving the case
+bool testReloadOpenEditor() {
+    TestPanelBuilder builder;
+    TestCaseModel model;
+    QListView view;
+    QObject context;
+    auto *delegate = new TestCaseDelegate(
+        [&builder, &context](QWidget *parent) { return builder.createCase(parent, &context, 1); },
+        &view);
+    view.setItemDelegate(delegate);
+    view.setModel(&model);
+    model.setTests({TestCase{"1\n", "old\n"}, TestCase{"2\n", "x\n"}});
+
+    focus(view, model, *delegate, 0);
+    const auto &widgets = delegate->openEditor();
+    if (!check(widgets.expectedEditor && widgets.expectedEditor->toPlainText() == "old\n",
+               "Open editor did not load the expected output")) {
+        return false;
+    }
+
+    // An edit to the input is kept along with the new expected output
+    widgets.inputEditor->setPlainText("3\n");
+    model.recordRef(0).test.input = "3\n";
+    model.recordRef(0).test.expectedOutput = "new\n";
+    model.recordsChanged(0, 0);
+    delegate->reloadOpenEditor();
+    bool ok = check(delegate->openEditor().expectedEditor->toPlainText() == "new\n",
+                    "Open editor still shows the old expected output");
+
+    focus(view, model, *delegate, 1);
+    ok = check(model.record(0).test.expectedOutput == "new\n",
+               QString("Leaving the case wrote back '%1'")
+                   .arg(model.record(0).test.expectedOutput)) && ok;
+    ok = check(model.record(0).test.input == "3\n", "Leaving the case lost the input") && ok;
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    QApplication app(argc, argv);
+
+    bool ok = true;
+    ok = testReloadOpenEditor() && ok;
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
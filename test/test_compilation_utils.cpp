@@ -0,0 +1,127 @@
+#include "execution/CompilationUtils.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QRandomGenerator>
+
+#include <cstdlib>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+bool check(bool condition, const QString &message) {
+    if (!condition) {
+        qCritical().noquote() << message;
+        return false;
+    }
+    return true;
+}
+
+QString show(const QByteArray &bytes) {
+    return QString::fromLatin1(bytes.toPercentEncoding(" "));
+}
+
+// What a single Run used to judge with, on decoded text
+bool sameNormalized(const QByteArray &a, const QByteArray &b) {
+    return CompilationUtils::normalizeText(QString::fromUtf8(a)) ==
+           CompilationUtils::normalizeText(QString::fromUtf8(b));
+}
+
+bool checkPair(const QByteArray &a, const QByteArray &b, bool expected) {
+    const bool bytes = CompilationUtils::sameOutput(a, b);
+    const bool text = sameNormalized(a, b);
+    return check(bytes == expected && text == expected,
+                 QString("'%1' vs '%2': sameOutput %3, normalizeText %4, expected %5")
+                     .arg(show(a), show(b))
+                     .arg(bytes)
+                     .arg(text)
+                     .arg(expected));
+}
+
+bool testLineEndingsAndBlanks() {
+    const std::vector<std::tuple<QByteArray, QByteArray, bool>> cases = {
+        {"1 2\n3\n", "1 2\r\n3\r\n", true},
+        {"1 2\r3\r", "1 2\n3", true},
+        {"1 2  \t\n3\n\n\n", "1 2\n3", true},
+        {"1\n\n2\n", "1\n2\n", false},
+        {"1\n \t\r\n\v\f\n", "1", true},
+        {"", "\n\n", true},
+        {" 1\n", "1\n", false},
+        // Non-ASCII whitespace is output, in a trailing line or after text
+        {"1\n\xc2\xa0\n", "1\n", false},
+        {"1\n\xe3\x80\x80", "1", false},
+        {"1\n\xc2\x85", "1", false},
+        {"1\xc2\xa0\n", "1\n", false},
+        {"\xc3\xa9\r\n", "\xc3\xa9", true},
+    };
+    bool ok = true;
+    for (const auto &[a, b, expected] : cases) {
+        ok = checkPair(a, b, expected) && ok;
+    }
+    return ok;
+}
+
+bool testInvalidUtf8() {
+    using CompilationUtils::sameOutput;
+    // Line endings and blanks are handled the same around invalid bytes
+    // (CR and LF never occur inside a UTF-8 sequence)...
+    bool ok = check(sameOutput("\xff\xfe\r\n\n", "\xff\xfe"), "Invalid UTF-8 lost normalization");
+    ok = check(sameOutput("\x80 \t\n", "\x80"), "Trailing spaces kept after invalid UTF-8") && ok;
+    // ...but the bytes themselves are compared, not their U+FFFD decoding
+    ok = check(!sameOutput("\xff\n", "\xfe\n"), "Distinct invalid bytes compared equal") && ok;
+    ok = check(!sameOutput("\xff", "\xef\xbf\xbd"), "Invalid byte equal to U+FFFD") && ok;
+    return ok;
+}
+
+// Random valid UTF-8 over the characters that matter for judging
+bool testRandomAgreement() {
+    const std::vector<QByteArray> alphabet = {
+        "a", "1", " ", "\t", "\r", "\n", "\r\n", "\v", "\xc2\xa0", "\xe3\x80\x80", "\xc2\x85",
+    };
+    QRandomGenerator random(20261018);
+    auto make = [&]() {
+        QByteArray text;
+        const int length = random.bounded(8);
+        for (int i = 0; i < length; ++i) {
+            text += alphabet[static_cast<size_t>(random.bounded(static_cast<int>(alphabet.size())))];
+        }
+        return text;
+    };
+    for (int i = 0; i < 20000; ++i) {
+        const QByteArray a = make();
+        // Half the time, a variant of `a` that should often compare equal
+        QByteArray b = random.bounded(2) ? make() : a;
+        if (b == a) {
+            b.replace("\r\n", "\n");
+            b += random.bounded(2) ? "\n \n" : "\t";
+        }
+        if (!checkPair(a, b, sameNormalized(a, b))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool testVerdict() {
+    using CompilationUtils::verdict;
+    return check(verdict(true, -1, false) == "TLE", "Timeout is not TLE") &&
+           check(verdict(false, 1, false) == "RE", "Non-zero exit is not RE") &&
+           check(verdict(false, 11, true) == "RE", "Crash is not RE") &&
+           check(verdict(false, 0, true) == "AC", "Clean matching run is not AC") &&
+           check(verdict(false, 0, false) == "WA", "Clean mismatching run is not WA");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    QCoreApplication app(argc, argv);
+
+    bool ok = true;
+    ok = testLineEndingsAndBlanks() && ok;
+    ok = testInvalidUtf8() && ok;
+    ok = testRandomAgreement() && ok;
+    ok = testVerdict() && ok;
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
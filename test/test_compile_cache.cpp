@@ -0,0 +1,274 @@
+#include "execution/CompileCache.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QProcess>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+
+#include <atomic>
+#include <cstdlib>
+
+namespace {
+
+bool check(bool condition, const QString &message) {
+    if (!condition) {
+        qCritical().noquote() << message;
+        return false;
+    }
+    return true;
+}
+
+// Python needs no compiler, so the cache bookkeeping can be tested anywhere
+CompilationConfig pythonConfig() {
+    CompilationConfig config;
+    config.language = "Python";
+    config.pythonPath = "python3";
+    return config;
+}
+
+bool testKeyCoversSettings() {
+    CompilationConfig cpp;
+    const QByteArray base = CompileCache::key("int main() {}", cpp);
+    CompilationConfig flags = cpp;
+    flags.cppCompilerFlags = "-O0";
+    return check(base == CompileCache::key("int main() {}", cpp), "Key is not stable") &&
+           check(base != CompileCache::key("int main() { }", cpp), "Key ignores the source") &&
+           check(base != CompileCache::key("int main() {}", flags), "Key ignores the flags") &&
+           check(base != CompileCache::key("int main() {}", pythonConfig()),
+                 "Key ignores the language");
+}
+
+bool testReusesEntries() {
+    QTemporaryDir tempDir;
+    if (!check(tempDir.isValid(), "Failed to create temporary directory")) {
+        return false;
+    }
+
+    const QString source = "print(input())\n";
+    CompileCache::Artifact first;
+    {
+        CompileCache cache(tempDir.path());
+        first = cache.get(source, pythonConfig());
+        const CompileCache::Artifact again = cache.get(source, pythonConfig());
+        if (!check(first.ok && !first.cached, "First build failed: " + first.error) ||
+            !check(again.args == first.args, "Same source built twice")) {
+            return false;
+        }
+    }
+
+    // A new cache (next run) finds the published entry on disk
+    CompileCache cache(tempDir.path());
+    const CompileCache::Artifact reused = cache.get(source, pythonConfig());
+    if (!check(reused.ok && reused.cached, "Entry was not reused across instances")) {
+        return false;
+    }
+    QFile script(reused.args.last());
+    return check(script.open(QIODevice::ReadOnly) && script.readAll() == source.toUtf8(),
+                 "Cached source does not match");
+}
+
+bool testFindAndCancel() {
+    QTemporaryDir tempDir;
+    if (!check(tempDir.isValid(), "Failed to create temporary directory")) {
+        return false;
+    }
+    CompileCache cache(tempDir.path());
+    const QString source = "print(1)\n";
+    if (!check(!cache.find(source, pythonConfig()).ok, "Found an entry that was never built")) {
+        return false;
+    }
+    cache.get(source, pythonConfig());
+    if (!check(cache.find(source, pythonConfig()).ok, "Built entry was not found")) {
+        return false;
+    }
+
+#ifdef Q_OS_UNIX
+    // A "compiler" that never finishes on its own
+    CompilationConfig slow;
+    slow.cppCompilerPath = "sh";
+    slow.cppCompilerFlags = "-c 'sleep 30'";
+    std::atomic<bool> cancelled{true};
+    CompileCache::BuildOptions options;
+    options.lowPriority = true;
+    options.cancelled = &cancelled;
+    const CompileCache::Artifact artifact = cache.get("int main() {}", slow, options);
+    return check(!artifact.ok && artifact.cancelled, "Cancelled build was not abandoned") &&
+           check(!cache.find("int main() {}", slow).ok, "Cancelled build was published");
+#else
+    return true;
+#endif
+}
+
+// Makes an entry look unused for a day, past the eviction grace period
+void backdate(const CompileCache::Artifact &artifact) {
+    QFile ready(QDir(artifact.workDir).filePath("ready"));
+    if (ready.open(QIODevice::ReadWrite)) {
+        ready.setFileTime(QDateTime::currentDateTime().addDays(-1),
+                          QFileDevice::FileModificationTime);
+    }
+}
+
+bool testLeasesAndEviction() {
+    QTemporaryDir tempDir;
+    if (!check(tempDir.isValid(), "Failed to create temporary directory")) {
+        return false;
+    }
+    CompileCache cache(tempDir.path());
+    CompileCache::Artifact kept = cache.get("print(1)\n", pythonConfig());
+    CompileCache::Artifact dropped = cache.get("print(2)\n", pythonConfig());
+    CompileCache::Artifact copy = kept;
+    if (!check(kept.ok && dropped.ok, "Build failed") ||
+        !check(cache.leaseCount(kept.key) == 2, "Copies do not share the lease") ||
+        !check(!(QFileInfo(kept.args.last()).permissions() & QFile::WriteOwner),
+               "Published source is writable")) {
+        return false;
+    }
+
+    backdate(kept);
+    backdate(dropped);
+    const QString droppedDir = dropped.workDir;
+    dropped = CompileCache::Artifact();
+    cache.setMaxBytes(1);
+    const int removed = cache.evict();
+    if (!check(removed == 1, QString("Evicted %1 entries, expected 1").arg(removed)) ||
+        !check(!QFileInfo::exists(droppedDir), "Unleased entry survived eviction") ||
+        !check(QFileInfo::exists(kept.args.last()), "Leased entry was evicted")) {
+        return false;
+    }
+
+    // The entry stays leased until its last copy goes
+    const QByteArray key = kept.key;
+    const QString keptDir = kept.workDir;
+    kept = CompileCache::Artifact();
+    if (!check(cache.leaseCount(key) == 1, "Lease count did not drop") ||
+        !check(cache.evict() == 0, "Entry was evicted while a copy held it")) {
+        return false;
+    }
+    copy = CompileCache::Artifact();
+    if (!check(cache.evict() == 1 && !QFileInfo::exists(keptDir),
+               "Released entry was not evicted")) {
+        return false;
+    }
+    const CompileCache::Artifact rebuilt = cache.get("print(1)\n", pythonConfig());
+    return check(rebuilt.ok && !rebuilt.cached && rebuilt.key == key,
+                 "Evicted entry was not rebuilt");
+}
+
+// A harness runner keeps its own cache on the shared directory; the GUI's
+// evict() must still see its lease
+bool testLeasesAcrossInstances() {
+    QTemporaryDir tempDir;
+    if (!check(tempDir.isValid(), "Failed to create temporary directory")) {
+        return false;
+    }
+    CompileCache runnerCache(tempDir.path());
+    CompileCache guiCache(tempDir.path() + "/.");
+    CompileCache::Artifact harness = runnerCache.get("print(3)\n", pythonConfig());
+    if (!check(harness.ok, "Build failed") ||
+        !check(guiCache.leaseCount(harness.key) == 1, "Lease is not visible to another cache")) {
+        return false;
+    }
+    backdate(harness);
+    guiCache.setMaxBytes(1);
+    if (!check(guiCache.evict() == 0 && QFileInfo::exists(harness.args.last()),
+               "Another cache evicted a leased entry")) {
+        return false;
+    }
+    harness = CompileCache::Artifact();
+    return check(guiCache.evict() == 1, "Released entry was not evicted by another cache");
+}
+
+int lineCount(const QString &path) {
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll().count('\n') : 0;
+}
+
+// A timed-out build is tried again; a compiler error is not
+bool testTransientFailures() {
+#ifdef Q_OS_UNIX
+    QTemporaryDir tempDir;
+    if (!check(tempDir.isValid(), "Failed to create temporary directory")) {
+        return false;
+    }
+    CompileCache cache(tempDir.filePath("cache"));
+    const QString calls = tempDir.filePath("calls");
+    CompileCache::BuildOptions options;
+    options.timeoutMs = 200;
+
+    // "Compilers" that log each invocation
+    CompilationConfig slow;
+    slow.cppCompilerPath = "sh";
+    slow.cppCompilerFlags = QString("-c \"echo >> %1; exec sleep 30\"").arg(calls);
+    CompileCache::Artifact artifact = cache.get("int main() {}", slow, options);
+    if (!check(!artifact.ok && artifact.transient,
+               "Timeout was not reported as transient: " + artifact.error)) {
+        return false;
+    }
+    artifact = cache.get("int main() {}", slow, options);
+    if (!check(!artifact.ok && lineCount(calls) == 2,
+               QString("Timed-out build was not retried (%1 calls)").arg(lineCount(calls)))) {
+        return false;
+    }
+
+    QFile::remove(calls);
+    CompilationConfig broken;
+    broken.cppCompilerPath = "sh";
+    broken.cppCompilerFlags =
+        QString("-c \"echo >> %1; echo error: nope >&2; exit 1\"").arg(calls);
+    artifact = cache.get("int main() {}", broken, options);
+    const CompileCache::Artifact again = cache.get("int main() {}", broken, options);
+    return check(!artifact.ok && !artifact.transient && artifact.error.contains("nope"),
+                 "Compiler error was not reported: " + artifact.error) &&
+           check(!again.ok && lineCount(calls) == 1,
+                 QString("Compiler error was not remembered (%1 calls)").arg(lineCount(calls)));
+#else
+    return true;
+#endif
+}
+
+bool testLinkerFallback() {
+    if (QStandardPaths::findExecutable("g++").isEmpty()) {
+        qInfo() << "No g++ on PATH; skipping the linker fallback";
+        return true;
+    }
+    QTemporaryDir tempDir;
+    if (!check(tempDir.isValid(), "Failed to create temporary directory")) {
+        return false;
+    }
+    CompileCache cache(tempDir.path());
+    CompilationConfig config;
+    config.cppLinker = "no-such-linker";
+    const CompileCache::Artifact artifact =
+        cache.get("#include <cstdio>\nint main() { std::puts(\"ok\"); }\n", config);
+    if (!check(artifact.ok, "Build failed with an unknown linker: " + artifact.error) ||
+        !check(artifact.linker.isEmpty(), "Unknown linker was reported as used")) {
+        return false;
+    }
+
+    QProcess process;
+    process.start(artifact.program, artifact.args);
+    return check(process.waitForFinished(10000) && process.readAllStandardOutput() == "ok\n",
+                 "Linked executable does not run");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    QCoreApplication app(argc, argv);
+
+    bool ok = true;
+    ok = testKeyCoversSettings() && ok;
+    ok = testReusesEntries() && ok;
+    ok = testFindAndCancel() && ok;
+    ok = testLeasesAndEviction() && ok;
+    ok = testLeasesAcrossInstances() && ok;
+    ok = testTransientFailures() && ok;
+    ok = testLinkerFallback() && ok;
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,4 +1,5 @@
 #include "file/CpackFileHandler.h"
+#include "file/TestStore.h"
 
 #include <QCoreApplication>
 #include <QDataStream>
@@ -136,6 +137,119 @@ bool testRejectsAbsoluteFilename() {
     return true;
 }
 
+bool testBinaryTestStoreLazyLoad() {
+    QTemporaryDir tempDir;
+    if (!check(tempDir.isValid(), "Failed to create temporary directory")) {
+        return false;
+    }
+
+    const QString path = tempDir.filePath("tests.cpack");
+    std::vector<TestCase> tests = {
+        {"3\n1 2 3\n", "6\n"},
+        {QString(100000, QChar('x')), "\"quoted\"\n"},
+    };
+
+    CpackFileHandler writer;
+    writer.addFile("solution.cpp", "int main() {}\n");
+    TestStore::write(writer, tests, 7);
+    if (!check(writer.save(path), "Failed to save archive: " + writer.errorString())) {
+        return false;
+    }
+
+    CpackFileHandler reader;
+    if (!check(reader.load(path, TestStore::kPrefix),
+               "Failed to load archive: " + reader.errorString())) {
+        return false;
+    }
+    TestStore::Index index;
+    if (!check(TestStore::readIndex(reader, index), "Failed to read test index")) {
+        return false;
+    }
+    if (!check(index.count() == 2 && index.timeoutSec == 7, "Unexpected test index")) {
+        return false;
+    }
+    if (!check(index.inputSizes[1] == 100000, "Unexpected input size in index")) {
+        return false;
+    }
+    if (!check(TestStore::readOutput(reader, 1) == "\"quoted\"\n",
+               "Lazy output mismatch")) {
+        return false;
+    }
+
+    std::vector<TestCase> loaded;
+    int timeout = 0;
+    if (!check(TestStore::readTests(reader, loaded, timeout), "Failed to read tests")) {
+        return false;
+    }
+    return check(loaded.size() == 2 && loaded[0].input == tests[0].input &&
+                     loaded[1].input == tests[1].input,
+                 "Tests mismatch after lazy round trip");
+}
+
+bool testBinaryTestStoreRejectsDamage() {
+    QTemporaryDir tempDir;
+    if (!check(tempDir.isValid(), "Failed to create temporary directory")) {
+        return false;
+    }
+    const std::vector<TestCase> tests = {
+        {"3\n1 2 3\n", "6\n"},
+        {"marker-input\n", "7\n"},
+    };
+
+    // A flipped byte inside tests/000001.in fails its CRC check
+    const QString corruptPath = tempDir.filePath("corrupt.cpack");
+    {
+        CpackFileHandler writer;
+        writer.addFile("solution.cpp", "int main() {}\n");
+        TestStore::write(writer, tests, 5);
+        if (!check(writer.save(corruptPath), "Failed to save archive: " + writer.errorString())) {
+            return false;
+        }
+        QFile file(corruptPath);
+        if (!check(file.open(QIODevice::ReadWrite), "Failed to reopen archive")) {
+            return false;
+        }
+        QByteArray bytes = file.readAll();
+        const qsizetype at = bytes.indexOf("marker-input");
+        if (!check(at >= 0, "Test entry not found in archive")) {
+            return false;
+        }
+        bytes[at] = 'M';
+        file.seek(0);
+        file.write(bytes);
+    }
+    CpackFileHandler corrupt;
+    if (!check(corrupt.load(corruptPath, TestStore::kPrefix),
+               "Lazy load should not read the damaged entry")) {
+        return false;
+    }
+    std::vector<TestCase> loaded;
+    int timeout = 0;
+    QString error;
+    if (!check(!TestStore::readTests(corrupt, loaded, timeout, &error) && loaded.empty(),
+               "Damaged test entry was read as a test") ||
+        !check(error.contains("CRC"), "Unexpected error for damaged entry: " + error)) {
+        return false;
+    }
+
+    // An entry that reads fine but disagrees with the index
+    const QString resizedPath = tempDir.filePath("resized.cpack");
+    CpackFileHandler writer;
+    writer.addFile("solution.cpp", "int main() {}\n");
+    TestStore::write(writer, tests, 5);
+    writer.addFile("tests/000000.out", QByteArray());
+    if (!check(writer.save(resizedPath), "Failed to save archive: " + writer.errorString())) {
+        return false;
+    }
+    CpackFileHandler resized;
+    if (!check(resized.load(resizedPath, TestStore::kPrefix), "Failed to load archive")) {
+        return false;
+    }
+    error.clear();
+    return check(!TestStore::readTests(resized, loaded, timeout, &error) && !error.isEmpty(),
+                 "Entry that does not match the index was accepted");
+}
+
 }  // namespace
 
 int main(int argc, char **argv) {
@@ -144,6 +258,8 @@ int main(int argc, char **argv) {
     bool ok = true;
     ok = testSaveLoadRoundTrip() && ok;
     ok = testRejectsAbsoluteFilename() && ok;
+    ok = testBinaryTestStoreLazyLoad() && ok;
+    ok = testBinaryTestStoreRejectsDamage() && ok;
 
     return ok ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -0,0 +1,123 @@
+#include "execution/DiffEngine.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+
+#include <cstdlib>
+
+namespace {
+
+bool check(bool condition, const QString &message) {
+    if (!condition) {
+        qCritical().noquote() << message;
+        return false;
+    }
+    return true;
+}
+
+QStringList numbered(int count) {
+    QStringList lines;
+    for (int i = 0; i < count; ++i) {
+        lines << QString::number(i);
+    }
+    return lines;
+}
+
+bool testIdentical() {
+    const DiffEngine::Report report = DiffEngine::report("1 2\n3\n", "1 2  \r\n3\n\n");
+    return check(report.result.identical(), "Trailing whitespace was reported as a difference") &&
+           check(report.result.firstMismatchLine == -1, "Identical output has a first mismatch") &&
+           check(report.lines.empty(), "Identical output produced report lines");
+}
+
+bool testChangedLine() {
+    const DiffEngine::Report report = DiffEngine::report("1\n2\n30\n4\n", "1\n2\n31\n4\n");
+    const DiffEngine::Result &result = report.result;
+    if (!check(result.differences == 1, "Expected exactly one difference") ||
+        !check(result.firstMismatchLine == 2 && result.firstMismatchColumn == 1,
+               QString("Wrong first mismatch %1:%2")
+                   .arg(result.firstMismatchLine)
+                   .arg(result.firstMismatchColumn))) {
+        return false;
+    }
+
+    const DiffEngine::Line *removed = nullptr;
+    const DiffEngine::Line *added = nullptr;
+    for (const DiffEngine::Line &line : report.lines) {
+        if (line.kind == DiffEngine::Line::Kind::Removed) {
+            removed = &line;
+        } else if (line.kind == DiffEngine::Line::Kind::Added) {
+            added = &line;
+        }
+    }
+    if (!check(removed && removed->text == "30" && removed->expectedLine == 2,
+               "Missing removed line") ||
+        !check(added && added->text == "31" && added->actualLine == 2, "Missing added line")) {
+        return false;
+    }
+    return check(added->changeStart == 1 && added->changeLength == 1,
+                 "Changed characters were not narrowed down");
+}
+
+bool testInsertAndDelete() {
+    QStringList actual = numbered(100);
+    actual.insert(10, "extra");
+    actual.removeAt(60);
+    const DiffEngine::Result result = DiffEngine::compare(numbered(100), actual);
+
+    int inserted = 0;
+    int deleted = 0;
+    for (const DiffEngine::Edit &edit : result.edits) {
+        if (edit.kind == DiffEngine::Edit::Kind::Insert) {
+            inserted += edit.count;
+        } else if (edit.kind == DiffEngine::Edit::Kind::Delete) {
+            deleted += edit.count;
+        }
+    }
+    return check(result.differences == 2, "Expected two differences") &&
+           check(inserted == 1 && deleted == 1, "Diff is not minimal") &&
+           check(result.firstMismatchLine == 10, "Wrong first mismatch line");
+}
+
+bool testStopsEarly() {
+    const QStringList expected = numbered(10000);
+    QStringList actual = expected;
+    for (int i = 0; i < actual.size(); i += 100) {
+        actual[i] = "x";
+    }
+    DiffEngine::Options options;
+    options.maxDifferences = 5;
+    const DiffEngine::Result result = DiffEngine::compare(expected, actual, options);
+    return check(result.differences == 5, "Did not stop at maxDifferences") &&
+           check(result.truncated, "Early stop was not reported") &&
+           check(result.edits.back().expectedLine < 1000, "Kept diffing after the limit");
+}
+
+bool testBoundedCost() {
+    QStringList expected;
+    QStringList actual;
+    for (int i = 0; i < 20000; ++i) {
+        expected << QString("a%1").arg(i);
+        actual << QString("b%1").arg(i);
+    }
+    DiffEngine::Options options;
+    options.maxEditDistance = 50;
+    const DiffEngine::Result result = DiffEngine::compare(expected, actual, options);
+    return check(result.differences == 1, "Unrelated outputs should be one replacement") &&
+           check(result.edits.size() == 2, "Expected a delete and an insert");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    QCoreApplication app(argc, argv);
+
+    bool ok = true;
+    ok = testIdentical() && ok;
+    ok = testChangedLine() && ok;
+    ok = testInsertAndDelete() && ok;
+    ok = testStopsEarly() && ok;
+    ok = testBoundedCost() && ok;
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,225 @@
+#include "execution/CompileCache.h"
+#include "execution/JvmRunner.h"
+#include "execution/PythonRunner.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+
+#include <cstdlib>
+
+namespace {
+
+bool check(bool condition, const QString &message) {
+    if (!condition) {
+        qCritical().noquote() << message;
+        return false;
+    }
+    return true;
+}
+
+CompilationConfig javaConfig() {
+    CompilationConfig config;
+    config.language = "Java";
+    config.javaPersistentJvm = true;
+    return config;
+}
+
+// Echoes the input and how often its class was initialized
+const char *kEcho = R"(
+import java.util.*;
+public class Main {
+    static int runs = 0;
+    public static void main(String[] args) {
+        runs++;
+        Scanner in = new Scanner(System.in);
+        System.out.println(in.nextLine() + " " + runs);
+    }
+}
+)";
+
+bool testRunsInOneJvm(CompileCache &cache) {
+    const CompileCache::Artifact echo = cache.get(kEcho, javaConfig());
+    if (!check(echo.ok && echo.mainClass == "Main", "Echo build failed: " + echo.error)) {
+        return false;
+    }
+    JvmRunner runner(javaConfig());
+    const JvmRunner::Result first = runner.run(echo.workDir, echo.mainClass, "a\n", 20000);
+    const JvmRunner::Result second = runner.run(echo.workDir, echo.mainClass, "b\n", 20000);
+    return check(first.ok && first.exitCode == 0, "First run failed: " + first.error) &&
+           check(first.stdOut == "a 1\n", "Unexpected output: " + QString::fromUtf8(first.stdOut)) &&
+           check(second.ok && second.stdOut == "b 1\n",
+                 "Second run did not start with fresh statics: " + QString::fromUtf8(second.stdOut));
+}
+
+bool testFailures(CompileCache &cache) {
+    const CompileCache::Artifact thrower = cache.get(
+        "public class Main { public static void main(String[] a) { throw new IllegalStateException(); } }",
+        javaConfig());
+    const CompileCache::Artifact exiter = cache.get(
+        "public class Main { public static void main(String[] a) { System.exit(3); } }",
+        javaConfig());
+    const CompileCache::Artifact looper = cache.get(
+        "public class Main { public static void main(String[] a) { for (;;) {} } }",
+        javaConfig());
+    const CompileCache::Artifact echo = cache.get(kEcho, javaConfig());
+    if (!check(thrower.ok && exiter.ok && looper.ok && echo.ok, "Build failed")) {
+        return false;
+    }
+
+    JvmRunner runner(javaConfig());
+    const JvmRunner::Result thrown = runner.run(thrower.workDir, thrower.mainClass, {}, 20000);
+    if (!check(thrown.ok && thrown.exitCode == 1 &&
+                   thrown.stdErr.contains("IllegalStateException"),
+               "Uncaught exception was not reported")) {
+        return false;
+    }
+    // The caller falls back to a fresh JVM for these
+    const JvmRunner::Result exited = runner.run(exiter.workDir, exiter.mainClass, {}, 20000);
+    if (!check(!exited.ok, "System.exit was reported as a normal run")) {
+        return false;
+    }
+    const JvmRunner::Result looped = runner.run(looper.workDir, looper.mainClass, {}, 1000);
+    if (!check(looped.ok && looped.timedOut, "Endless loop did not time out")) {
+        return false;
+    }
+    const JvmRunner::Result after = runner.run(echo.workDir, echo.mainClass, "c\n", 20000);
+    return check(after.ok && after.stdOut == "c 1\n", "Runner did not recover after a timeout");
+}
+
+// Would block on the harness's own stdin and time out
+bool testOwnStreams(CompileCache &cache) {
+    const CompileCache::Artifact reader = cache.get(R"(
+import java.io.*;
+public class Main {
+    public static void main(String[] args) throws IOException {
+        BufferedReader in = new BufferedReader(
+            new InputStreamReader(new FileInputStream(FileDescriptor.in)));
+        System.out.println(in.readLine());
+    }
+}
+)", javaConfig());
+    if (!check(reader.ok, "Reader build failed: " + reader.error)) {
+        return false;
+    }
+    JvmRunner runner(javaConfig());
+    const JvmRunner::Result result = runner.run(reader.workDir, reader.mainClass, "d\n", 2000);
+    return check(!result.ok && !result.timedOut,
+                 "A FileDescriptor.in reader was run in the harness");
+}
+
+CompilationConfig pythonConfig() {
+    CompilationConfig config;
+    config.language = "Python";
+    config.pythonForkServer = true;
+    return config;
+}
+
+// Module state must not leak from one test into the next
+const char *kPythonEcho = R"(
+import collections
+import sys
+seen = collections.Counter()
+seen["runs"] += 1
+print(input(), seen["runs"])
+)";
+
+bool testPythonForkServer(CompileCache &cache) {
+    const CompileCache::Artifact echo = cache.get(kPythonEcho, pythonConfig());
+    const CompileCache::Artifact exiter = cache.get("import sys\nprint('bye')\nsys.exit(3)\n",
+                                                    pythonConfig());
+    const CompileCache::Artifact thrower = cache.get("raise ValueError('boom')\n", pythonConfig());
+    const CompileCache::Artifact looper = cache.get("while True:\n    pass\n", pythonConfig());
+    if (!check(echo.ok && exiter.ok && thrower.ok && looper.ok, "Python build failed")) {
+        return false;
+    }
+
+    QString location;
+    QString entry;
+    HarnessRunner *runner = HarnessRunner::forArtifact(pythonConfig(), echo, location, entry);
+    if (!check(runner != nullptr, "No fork server for an enabled Python config")) {
+        return false;
+    }
+    const HarnessRunner::Result first = runner->run(location, entry, "a\n", 20000);
+    const HarnessRunner::Result second = runner->run(location, entry, "b\n", 20000);
+    if (!check(first.ok && first.stdOut == "a 1\n",
+               "Unexpected output: " + QString::fromUtf8(first.stdOut) + first.error) ||
+        !check(second.ok && second.stdOut == "b 1\n",
+               "Module state leaked between tests: " + QString::fromUtf8(second.stdOut))) {
+        return false;
+    }
+
+    HarnessRunner::forArtifact(pythonConfig(), exiter, location, entry);
+    const HarnessRunner::Result exited = runner->run(location, entry, {}, 20000);
+    HarnessRunner::forArtifact(pythonConfig(), thrower, location, entry);
+    const HarnessRunner::Result thrown = runner->run(location, entry, {}, 20000);
+    if (!check(exited.ok && exited.exitCode == 3 && exited.stdOut == "bye\n",
+               "sys.exit was not reported") ||
+        !check(thrown.ok && thrown.exitCode == 1 && thrown.stdErr.contains("ValueError: boom") &&
+                   !thrown.stdErr.contains("in child"),
+               "Uncaught exception was not reported like the interpreter does")) {
+        return false;
+    }
+
+    HarnessRunner::forArtifact(pythonConfig(), looper, location, entry);
+    const HarnessRunner::Result looped = runner->run(location, entry, {}, 1000);
+    HarnessRunner::forArtifact(pythonConfig(), echo, location, entry);
+    const HarnessRunner::Result after = runner->run(location, entry, "c\n", 20000);
+    return check(looped.ok && looped.timedOut, "Endless loop did not time out") &&
+           check(after.ok && after.stdOut == "c 1\n", "Server did not recover after a timeout");
+}
+
+// Import-time output belongs to every test, not to the server
+bool testPythonImportOutput(CompileCache &cache) {
+    const CompileCache::Artifact zen = cache.get("import this\nprint(input())\n", pythonConfig());
+    if (!check(zen.ok, "Python build failed")) {
+        return false;
+    }
+    QString location;
+    QString entry;
+    HarnessRunner *runner = HarnessRunner::forArtifact(pythonConfig(), zen, location, entry);
+    const HarnessRunner::Result first = runner->run(location, entry, "a\n", 20000);
+    const HarnessRunner::Result second = runner->run(location, entry, "b\n", 20000);
+    return check(first.ok && first.stdOut.startsWith("The Zen of Python") &&
+                     first.stdOut.endsWith("\na\n"),
+                 "Import output missing from the first test: " + QString::fromUtf8(first.stdOut)) &&
+           check(second.ok && second.stdOut.startsWith("The Zen of Python") &&
+                     second.stdOut.endsWith("\nb\n"),
+                 "Import output missing from the second test: " +
+                     QString::fromUtf8(second.stdOut));
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    QCoreApplication app(argc, argv);
+    // The harnesses are built into the default cache directory
+    QStandardPaths::setTestModeEnabled(true);
+
+    QTemporaryDir tempDir;
+    if (!check(tempDir.isValid(), "Failed to create temporary directory")) {
+        return EXIT_FAILURE;
+    }
+    CompileCache cache(tempDir.path());
+
+    bool ok = true;
+    if (QStandardPaths::findExecutable("java").isEmpty() ||
+        QStandardPaths::findExecutable("javac").isEmpty()) {
+        qInfo() << "No JDK on PATH; skipping the JVM runner";
+    } else {
+        ok = testRunsInOneJvm(cache) && ok;
+        ok = testFailures(cache) && ok;
+        ok = testOwnStreams(cache) && ok;
+    }
+#ifndef Q_OS_WIN
+    if (QStandardPaths::findExecutable("python3").isEmpty()) {
+        qInfo() << "No python3 on PATH; skipping the fork server";
+    } else {
+        ok = testPythonForkServer(cache) && ok;
+        ok = testPythonImportOutput(cache) && ok;
+    }
+#endif
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,172 @@
+#include "execution/InputCache.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QProcess>
+#include <QTemporaryDir>
+
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+
+bool check(bool condition, const QString &message) {
+    if (!condition) {
+        qCritical().noquote() << message;
+        return false;
+    }
+    return true;
+}
+
+QByteArray contents(const QString &path) {
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+bool testSharesFiles(const QString &parent) {
+    InputCache cache(parent);
+    const QByteArray input = "3\n1 2 3\n\xc3\xa9\n";
+    const QString first = cache.file(input);
+    const QString again = cache.file(QByteArray(input.constData(), input.size()));
+    const QString other = cache.file("4\n");
+    return check(!first.isEmpty(), "Input file was not written") &&
+           check(contents(first) == input, "Input file does not hold the input") &&
+           check(again == first, "Same input was written twice") &&
+           check(other != first && contents(other) == "4\n", "Distinct inputs share a file") &&
+           check(cache.bytes() == input.size() + 2, "Byte count is off");
+}
+
+bool testAttachesAsStdin(const QString &parent) {
+#ifdef Q_OS_WIN
+    Q_UNUSED(parent);
+    return true;
+#else
+    InputCache cache(parent);
+    const QByteArray input = QByteArray(1 << 20, 'x') + "\n";
+    QProcess process;
+    process.setStandardInputFile(cache.file(input));
+    process.start("wc", {"-c"});
+    return check(process.waitForFinished(10000) &&
+                     process.readAllStandardOutput().trimmed() ==
+                         QByteArray::number(input.size()),
+                 "Child did not read the whole input file");
+#endif
+}
+
+bool testRemovesItsDirectory(const QString &parent) {
+    QString path;
+    {
+        InputCache cache(parent);
+        path = cache.file("1\n");
+        if (!check(QFileInfo::exists(path), "Input file is missing")) {
+            return false;
+        }
+    }
+    return check(!QFileInfo::exists(QFileInfo(path).path()), "Directory outlived the cache");
+}
+
+bool testKeepsFilesUntilReleased(const QString &parent) {
+    InputCache cache(parent);
+    cache.setMaxBytes(1);
+    const QString first = cache.file("first\n");
+    const QString second = cache.file("second\n");
+    // Over budget, but no child has opened them yet
+    if (!check(QFileInfo::exists(first) && QFileInfo::exists(second),
+               "Evicted a file that was not released")) {
+        return false;
+    }
+    cache.release(first);
+    cache.release(second);
+    return check(!QFileInfo::exists(first) && !QFileInfo::exists(second) && cache.bytes() == 0,
+                 "Released files over budget were kept");
+}
+
+bool testEnforcesBudget(const QString &parent) {
+    InputCache cache(parent);
+    const QByteArray chunk(1000, 'x');
+    cache.setMaxBytes(2500);
+    QString oldest;
+    for (int i = 0; i < 10; ++i) {
+        const QString path = cache.file(chunk + QByteArray::number(i));
+        if (i == 0) {
+            oldest = path;
+        }
+        cache.release(path);
+        if (!check(cache.bytes() <= 2500,
+                   QString("Cache holds %1 bytes over its budget").arg(cache.bytes()))) {
+            return false;
+        }
+    }
+    // Reusing a released file that is still there hands it out again
+    const QString again = cache.file(chunk + "9");
+    const bool reused = QFileInfo::exists(again) && contents(again) == chunk + "9";
+    cache.release(again);
+    return check(!QFileInfo::exists(oldest), "Least recently used file survived") &&
+           check(reused, "Recent file was not reused");
+}
+
+// Threads asking for the same inputs at once share one complete file each
+bool testConcurrentRequests(const QString &parent) {
+    InputCache cache(parent);
+    std::vector<QByteArray> inputs;
+    qint64 total = 0;
+    for (int i = 0; i < 4; ++i) {
+        inputs.push_back(QByteArray((i + 1) << 18, static_cast<char>('a' + i)));
+        total += inputs.back().size();
+    }
+    constexpr int kThreads = 8;
+    std::vector<std::vector<QString>> paths(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&cache, &inputs, &paths, t]() {
+            for (size_t i = 0; i < inputs.size(); ++i) {
+                // Each thread starts on a different input
+                const QByteArray &input = inputs[(i + static_cast<size_t>(t)) % inputs.size()];
+                const QString path = cache.file(input);
+                paths[static_cast<size_t>(t)].push_back(
+                    contents(path) == input ? path : QString());
+                cache.release(path);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    bool ok = check(cache.bytes() == total,
+                    QString("Cache holds %1 bytes, expected %2").arg(cache.bytes()).arg(total));
+    for (int t = 0; t < kThreads; ++t) {
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            const size_t input = (i + static_cast<size_t>(t)) % inputs.size();
+            const QString &path = paths[static_cast<size_t>(t)][i];
+            ok = check(!path.isEmpty(), "A thread got an incomplete or wrong file") && ok;
+            // Thread 0 asked for the inputs in order
+            ok = check(path == paths[0][input], "Same input was written to two files") && ok;
+        }
+    }
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    QCoreApplication app(argc, argv);
+
+    QTemporaryDir tempDir;
+    if (!check(tempDir.isValid(), "Failed to create temporary directory")) {
+        return EXIT_FAILURE;
+    }
+
+    bool ok = true;
+    ok = testSharesFiles(tempDir.path()) && ok;
+    ok = testAttachesAsStdin(tempDir.path()) && ok;
+    ok = testRemovesItsDirectory(tempDir.path()) && ok;
+    ok = testKeepsFilesUntilReleased(tempDir.path()) && ok;
+    ok = testEnforcesBudget(tempDir.path()) && ok;
+    ok = testConcurrentRequests(tempDir.path()) && ok;
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,114 @@
+#include "execution/OutputCache.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <cstdlib>
+
+namespace {
+
+bool check(bool condition, const QString &message) {
+    if (!condition) {
+        qCritical().noquote() << message;
+        return false;
+    }
+    return true;
+}
+
+int fileCount(const QString &directory) {
+    int count = 0;
+    QDirIterator it(directory, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        ++count;
+    }
+    return count;
+}
+
+bool testRoundTrip(const QString &directory) {
+    OutputCache cache(directory);
+    QByteArray output;
+    if (!check(!cache.find("brute", "3\n1 2 3\n", output), "Hit before anything was stored")) {
+        return false;
+    }
+    cache.store("brute", "3\n1 2 3\n", "6\n");
+    cache.store("brute", "0\n", QByteArray());
+    QByteArray empty = "stale";
+    return check(cache.find("brute", "3\n1 2 3\n", output) && output == "6\n",
+                 "Stored output was not found") &&
+           check(cache.find("brute", "0\n", empty) && empty.isEmpty(),
+                 "Empty output was not kept") &&
+           check(!cache.find("brute", "3\n1 2 4\n", output), "Hit for another input") &&
+           check(!cache.find("other", "3\n1 2 3\n", output), "Hit for another brute");
+}
+
+bool testSurvivesRestart(const QString &directory) {
+    {
+        OutputCache cache(directory);
+        cache.store("brute", "1\n", "2\n");
+    }
+    OutputCache cache(directory);
+    QByteArray output;
+    return check(cache.find("brute", "1\n", output) && output == "2\n",
+                 "Output did not outlive the cache object");
+}
+
+bool testEvictsLeastRecentlyUsed(const QString &directory) {
+    OutputCache cache(directory);
+    const QByteArray big(1000, 'x');
+    cache.store("brute", "old\n", big);
+    cache.store("brute", "new\n", big);
+    // Make "old" the older one regardless of timestamp resolution
+    QDirIterator it(directory, QDir::Files, QDirIterator::Subdirectories);
+    QByteArray output;
+    while (it.hasNext()) {
+        QFile file(it.next());
+        if (file.open(QIODevice::ReadOnly) && file.readAll() == big) {
+            file.setFileTime(QDateTime::currentDateTime().addSecs(-3600),
+                             QFileDevice::FileModificationTime);
+        }
+    }
+    cache.find("brute", "new\n", output);
+
+    cache.setMaxBytes(1500);
+    const int removed = cache.evict();
+    return check(removed == 1, QString("Expected one eviction, got %1").arg(removed)) &&
+           check(!cache.find("brute", "old\n", output), "Least recently used output survived") &&
+           check(cache.find("brute", "new\n", output) && output == big,
+                 "Recently used output was evicted");
+}
+
+bool testStoreEvicts(const QString &directory) {
+    OutputCache cache(directory);
+    cache.setMaxBytes(100);
+    for (int i = 0; i < 20; ++i) {
+        cache.store("brute", QByteArray::number(i), QByteArray(50, 'y'));
+    }
+    return check(fileCount(directory) <= 2,
+                 QString("Stores left %1 outputs over budget").arg(fileCount(directory)));
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    QCoreApplication app(argc, argv);
+
+    QTemporaryDir tempDir;
+    if (!check(tempDir.isValid(), "Failed to create temporary directory")) {
+        return EXIT_FAILURE;
+    }
+    const QDir root(tempDir.path());
+
+    bool ok = true;
+    ok = testRoundTrip(root.filePath("round-trip")) && ok;
+    ok = testSurvivesRestart(root.filePath("restart")) && ok;
+    ok = testEvictsLeastRecentlyUsed(root.filePath("evict")) && ok;
+    ok = testStoreEvicts(root.filePath("store-evicts")) && ok;
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
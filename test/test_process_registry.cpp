@@ -0,0 +1,67 @@
+#include "execution/ProcessRegistry.h"
+#include "execution/ResourceSampler.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+
+#include <cstdlib>
+
+namespace {
+
+bool check(bool condition, const QString &message) {
+    if (!condition) {
+        qCritical().noquote() << message;
+        return false;
+    }
+    return true;
+}
+
+bool testTracksChildrenAndWorkers() {
+    const quint64 finishedBefore = ProcessRegistry::snapshot().finishedChildren;
+    ProcessRegistry::addQueued(3);
+    {
+        ProcessRegistry::WorkerScope worker;
+        ProcessRegistry::ChildScope child(4242, "TC 1");
+        const ProcessRegistry::Snapshot running = ProcessRegistry::snapshot();
+        if (!check(running.children.size() == 1 && running.children.front().pid == 4242 &&
+                       running.children.front().label == "TC 1",
+                   "Running child was not registered") ||
+            !check(running.busyWorkers == 1, "Busy worker was not counted") ||
+            !check(running.queuedJobs == 2, "Picked-up job is still queued")) {
+            return false;
+        }
+    }
+    ProcessRegistry::addQueued(-2);
+
+    const ProcessRegistry::Snapshot idle = ProcessRegistry::snapshot();
+    return check(idle.children.empty(), "Finished child is still listed") &&
+           check(idle.finishedChildren == finishedBefore + 1, "Finished child was not counted") &&
+           check(idle.busyWorkers == 0 && idle.queuedJobs == 0, "Worker counters leaked");
+}
+
+bool testSamplesProc() {
+    // The test process stands in for a child; it is alive and has memory
+    const qint64 self = QCoreApplication::applicationPid();
+    ProcessRegistry::ChildScope child(self, "self");
+    ResourceSampler sampler;
+    const ResourceSampler::Sample sample = sampler.sample();
+    if (!check(sample.children.size() == 1, "Sample lost the child")) {
+        return false;
+    }
+    if (!sample.procAvailable) {
+        return check(sample.children.front().rssBytes < 0, "RSS reported without /proc");
+    }
+    return check(sample.children.front().rssBytes > 0, "RSS was not read from /proc");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    QCoreApplication app(argc, argv);
+
+    bool ok = true;
+    ok = testTracksChildrenAndWorkers() && ok;
+    ok = testSamplesProc() && ok;
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,111 @@
+#include "file/TimingHistory.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <cstdlib>
+
+namespace {
+
+bool check(bool condition, const QString &message) {
+    if (!condition) {
+        qCritical().noquote() << message;
+        return false;
+    }
+    return true;
+}
+
+constexpr quint64 kProblem = 1;
+constexpr quint64 kTest = 2;
+constexpr quint64 kOldSolution = 10;
+constexpr quint64 kNewSolution = 11;
+
+bool testFlagsSlowerSolution() {
+    QTemporaryDir dir;
+    TimingHistory history(dir.filePath("timing.bin"));
+    for (qint64 ms : {20, 22, 21}) {
+        history.record(kProblem, kTest, kOldSolution, ms);
+    }
+    const TimingHistory::Trend first = history.trend(kProblem, kTest);
+    if (!check(first.currentMs == 21 && first.baselineMs < 0 && !first.regressed,
+               "A single solution has no baseline")) {
+        return false;
+    }
+
+    history.record(kProblem, kTest, kNewSolution, 40);
+    const TimingHistory::Trend slower = history.trend(kProblem, kTest);
+    if (!check(slower.baselineMs == 21 && slower.currentMs == 40, "Baseline is not the old median") ||
+        !check(slower.regressed, "Twice as slow was not flagged") ||
+        !check(slower.timesMs.size() == 4, "Sparkline lost samples")) {
+        return false;
+    }
+
+    // Noise within a few milliseconds is not a regression
+    history.record(kProblem, kTest + 1, kOldSolution, 2);
+    history.record(kProblem, kTest + 1, kNewSolution, 4);
+    return check(!history.trend(kProblem, kTest + 1).regressed, "Tiny difference was flagged") &&
+           check(history.trend(kProblem, kTest + 2).isEmpty(), "Unknown test has a trend");
+}
+
+bool testPersistsAndCaps() {
+    QTemporaryDir dir;
+    const QString path = dir.filePath("timing.bin");
+    {
+        TimingHistory history(path);
+        for (int i = 0; i < TimingHistory::kMaxSamples + 8; ++i) {
+            history.record(kProblem, kTest, kOldSolution, i);
+        }
+        if (!check(history.flush(), "Flush failed: " + history.errorString())) {
+            return false;
+        }
+    }
+
+    TimingHistory reloaded(path);
+    const TimingHistory::Trend trend = reloaded.trend(kProblem, kTest);
+    if (!check(trend.timesMs.size() == static_cast<size_t>(TimingHistory::kSparklineSamples),
+               "History was not reloaded") ||
+        !check(trend.timesMs.back() == static_cast<quint32>(TimingHistory::kMaxSamples + 7),
+               "Newest sample is wrong")) {
+        return false;
+    }
+
+    // A torn tail from a crash is dropped, not misread
+    QFile file(path);
+    if (!file.open(QIODevice::Append)) {
+        return check(false, "Could not reopen history");
+    }
+    file.write("torn");
+    file.close();
+    TimingHistory torn(path);
+    torn.record(kProblem, kTest, kNewSolution, 99);
+    if (!check(torn.flush(), "Flush after a torn tail failed")) {
+        return false;
+    }
+    TimingHistory repaired(path);
+    return check(repaired.trend(kProblem, kTest).currentMs == 99, "Repaired history lost a record");
+}
+
+bool testSparkline() {
+    return check(TimingHistory::sparkline({1, 5, 9}) ==
+                     QString::fromUtf8("\xe2\x96\x81\xe2\x96\x84\xe2\x96\x88"),
+                 "Sparkline does not span the range") &&
+           check(TimingHistory::sparkline({}).isEmpty(), "Empty history drew a sparkline") &&
+           check(TimingHistory::hash("a") == TimingHistory::hash("a") &&
+                     TimingHistory::hash("a") != TimingHistory::hash("b"),
+                 "Hash is not stable");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    QCoreApplication app(argc, argv);
+
+    bool ok = true;
+    ok = testFlagsSlowerSolution() && ok;
+    ok = testPersistsAndCaps() && ok;
+    ok = testSparkline() && ok;
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
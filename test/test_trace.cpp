@@ -0,0 +1,87 @@
+#include "execution/Trace.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+
+#include <cstdlib>
+
+namespace {
+
+bool check(bool condition, const QString &message) {
+    if (!condition) {
+        qCritical().noquote() << message;
+        return false;
+    }
+    return true;
+}
+
+bool testDisabledRecordsNothing() {
+    Trace::setEnabled(false);
+    Trace::clear();
+    {
+        Trace::Span span("ignored");
+    }
+    Trace::complete("ignored", Trace::now());
+    return check(Trace::now() < 0, "Clock runs while disabled") &&
+           check(Trace::eventCount() == 0, "Span recorded while disabled");
+}
+
+bool testExportsCompleteEvents() {
+    Trace::setEnabled(true);
+    Trace::clear();
+    {
+        Trace::Span outer("outer", "detail");
+        Trace::Span inner("inner");
+    }
+    QThread *worker = QThread::create([]() { Trace::Span span("worker"); });
+    worker->start();
+    worker->wait();
+    delete worker;
+    Trace::setEnabled(false);
+
+    const QJsonObject root = QJsonDocument::fromJson(Trace::toJson()).object();
+    QJsonObject outer;
+    QJsonObject inner;
+    QJsonObject fromWorker;
+    for (const QJsonValue &value : root.value("traceEvents").toArray()) {
+        const QJsonObject event = value.toObject();
+        if (event.value("ph").toString() != "X") {
+            continue;
+        }
+        const QString name = event.value("name").toString();
+        (name == "outer" ? outer : name == "inner" ? inner : fromWorker) = event;
+    }
+    if (!check(!outer.isEmpty() && !inner.isEmpty() && !fromWorker.isEmpty(),
+               "Missing complete events")) {
+        return false;
+    }
+
+    // Chrome nests spans on one thread by their time ranges
+    const qint64 outerStart = outer.value("ts").toInteger();
+    const qint64 innerStart = inner.value("ts").toInteger();
+    return check(outer.value("args").toObject().value("detail").toString() == "detail",
+                 "Detail was not exported") &&
+           check(outerStart <= innerStart &&
+                 innerStart + inner.value("dur").toInteger() <=
+                     outerStart + outer.value("dur").toInteger(),
+                 "Inner span is not nested in the outer one") &&
+           check(outer.value("tid") == inner.value("tid") &&
+                 outer.value("tid") != fromWorker.value("tid"),
+                 "Spans are not attributed to their threads");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    QCoreApplication app(argc, argv);
+
+    bool ok = true;
+    ok = testDisabledRecordsNothing() && ok;
+    ok = testExportsCompleteEvents() && ok;
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}